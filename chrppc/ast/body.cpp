@@ -250,7 +250,7 @@ namespace chr::compiler::ast
 	}
 
 	Sequence::Sequence(const Sequence& o)
-		: Body(o), _op(o._op)
+		: Body(o), _op(o._op), _search_limited(o._search_limited)
 	{
 		_children.reserve( o._children.size() ); // Optional, improve performance
 		for(auto& child : o._children)
@@ -272,6 +272,16 @@ namespace chr::compiler::ast
 		_children.emplace_back( std::move(b) );
 	}
 
+	bool Sequence::search_limited() const
+	{
+		return _search_limited;
+	}
+
+	void Sequence::set_search_limited(bool limited)
+	{
+		_search_limited = limited;
+	}
+
 	Body* Sequence::clone() const
 	{
 		return new Sequence(*this);
@@ -303,7 +313,8 @@ namespace chr::compiler::ast
 		_on_failed_alt( o._on_failed_alt->clone() ),
 		_on_succeeded_status( o._on_succeeded_status->clone() ),
 		_on_failed_status( o._on_failed_status->clone() ),
-		_behavior_body( o._behavior_body->clone() )
+		_behavior_body( o._behavior_body->clone() ),
+		_inline_body( o._inline_body )
 	{ }
 
 	PtrExpression& ChrBehavior::stop_cond()
@@ -341,6 +352,16 @@ namespace chr::compiler::ast
 		return _behavior_body;
 	}
 
+	bool ChrBehavior::inline_body() const
+	{
+		return _inline_body;
+	}
+
+	void ChrBehavior::set_inline_body(bool inlined)
+	{
+		_inline_body = inlined;
+	}
+
 	Body* ChrBehavior::clone() const
 	{
 		return new ChrBehavior(*this);
@@ -391,4 +412,58 @@ namespace chr::compiler::ast
 		v.visit(*this);
 	}
 
+	/*
+	 * ChrSearch
+	 */
+
+	ChrSearch::ChrSearch(std::string_view name, std::unique_ptr<CppVariable> variable, PtrExpression engine, std::vector< PtrExpression > args, PtrBody body, PositionInfo pos)
+		: Body(std::move(pos)), _name(name), _variable( std::move(variable) ), _engine( std::move(engine) ), _args( std::move(args) ), _body( std::move(body) )
+	{ }
+
+	ChrSearch::ChrSearch(const ChrSearch& o)
+		: Body(o),
+		_name(o._name),
+		_variable( static_cast<CppVariable*>(o._variable->clone()) ),
+		_engine( o._engine->clone() ),
+		_body( o._body->clone() )
+	{
+		for (auto& a : o._args)
+			_args.emplace_back( a->clone() );
+	}
+
+	std::string_view ChrSearch::name() const
+	{
+		return _name;
+	}
+
+	std::unique_ptr<CppVariable>& ChrSearch::variable()
+	{
+		return _variable;
+	}
+
+	PtrExpression& ChrSearch::engine()
+	{
+		return _engine;
+	}
+
+	std::vector< PtrExpression >& ChrSearch::args()
+	{
+		return _args;
+	}
+
+	PtrBody& ChrSearch::body()
+	{
+		return _body;
+	}
+
+	Body* ChrSearch::clone() const
+	{
+		return new ChrSearch(*this);
+	}
+
+	void ChrSearch::accept(visitor::BodyVisitor& v)
+	{
+		v.visit(*this);
+	}
+
 } // namespace chr::compiler::ast
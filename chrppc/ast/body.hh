@@ -456,6 +456,19 @@ namespace chr::compiler::ast
 		 */
 		void add_child(PtrBody b);
 
+		/**
+		 * Return if the alternatives of a disjunction are subject to the search
+		 * limits (chr::Search_limit).
+		 * @return True if the alternatives are limited, false otherwise
+		 */
+		bool search_limited() const;
+
+		/**
+		 * Set if the alternatives of a disjunction are subject to the search limits.
+		 * @param limited True if the alternatives are limited, false otherwise
+		 */
+		void set_search_limited(bool limited);
+
 		/**
 		 * Recursively clone the current sequence
 		 * @return A new fresh cloned sequence
@@ -471,6 +484,7 @@ namespace chr::compiler::ast
 	protected:
 		std::string _op;					///< Name of the built-in function
 		std::vector< PtrBody > _children;	///< The list of children
+		bool _search_limited = true;		///< True if the alternatives of a disjunction are subject to the search limits
 	};
 
 	/**
@@ -547,6 +561,19 @@ namespace chr::compiler::ast
 		 */
 		PtrBody& behavior_body();
 
+		/**
+		 * Return if the behavior body is generated inline in the loop of the
+		 * behavior instead of in a lambda function.
+		 * @return True if the behavior body is inlined, false otherwise
+		 */
+		bool inline_body() const;
+
+		/**
+		 * Set if the behavior body is generated inline in the loop of the behavior.
+		 * @param inlined True if the behavior body is inlined, false otherwise
+		 */
+		void set_inline_body(bool inlined);
+
 		/**
 		 * Recursively clone the current behavior
 		 * @return A new fresh cloned behavior
@@ -567,6 +594,7 @@ namespace chr::compiler::ast
 		PtrBody _on_succeeded_status;	///< The statements to run on a succeeded behavior
 		PtrBody _on_failed_status;		///< The statements to run on a failed behavior
 		PtrBody _behavior_body;			///< The statements to run on each alternative
+		bool _inline_body = false;		///< True if the behavior body is generated inline (no lambda function)
 	};
 
 	/**
@@ -629,4 +657,82 @@ namespace chr::compiler::ast
 		PtrBody _body;							///< The statements to try
 	};
 
+	/**
+	 * @brief A CHR search constraint
+	 *
+	 * A CHR search constraint is a reserved CHR constraint name which
+	 * gives the control of the choice points to a runtime search engine
+	 * (best_first, astar, mcts, minimize). The body applies a decision, it is called by
+	 * the engine each time a decision must be applied to the current state.
+	 */
+	class ChrSearch : public Body
+	{
+	public:
+		/**
+		 * Initialize a node with a CHR search.
+		 * @param name The name of the search (and the member function of the engine)
+		 * @param variable The decision variable
+		 * @param engine The runtime search engine
+		 * @param args The other arguments of the search (evaluated on demand by the engine)
+		 * @param body The body which applies a decision
+		 * @param pos The position of the element
+		 */
+		ChrSearch(std::string_view name, std::unique_ptr<CppVariable> variable, PtrExpression engine, std::vector< PtrExpression > args, PtrBody body, PositionInfo pos);
+
+		/**
+		 * Copy constructor.
+		 * @param o the other element
+		 */
+		ChrSearch(const ChrSearch &o);
+
+		/**
+		 * Return the name of the search.
+		 * @return The name
+		 */
+		std::string_view name() const;
+
+		/**
+		 * Return the decision CPP variable.
+		 * @return The decision variable
+		 */
+		std::unique_ptr<CppVariable>& variable();
+
+		/**
+		 * Return the runtime search engine expression.
+		 * @return The engine
+		 */
+		PtrExpression& engine();
+
+		/**
+		 * Return the other arguments of the search.
+		 * @return The arguments
+		 */
+		std::vector< PtrExpression >& args();
+
+		/**
+		 * Return the body which applies a decision.
+		 * @return The body of the search
+		 */
+		PtrBody& body();
+
+		/**
+		 * Recursively clone the current search
+		 * @return A new fresh cloned search
+		 */
+		Body* clone() const override;
+
+		/**
+		 * Accept BodyVisitor
+		 * @param v Visitor to apply
+		 */
+		virtual void accept(visitor::BodyVisitor& v) final;
+
+	protected:
+		std::string _name;						///< The name of the search
+		std::unique_ptr<CppVariable> _variable;	///< The decision variable
+		PtrExpression _engine;					///< The runtime search engine
+		std::vector< PtrExpression > _args;		///< The other arguments of the search
+		PtrBody _body;							///< The statements which apply a decision
+	};
+
 } // namespace chr::compiler::ast
@@ -24,6 +24,8 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <optional>
+#include <utility>
 
 #include <tao/pegtl.hpp>
 #include <common.hh>
@@ -49,6 +51,7 @@ namespace chr::compiler::ast
 		PtrSharedChrConstraintCall _c;	///< Ref to constraint store definition
 		bool _never_stored;				///< True if the constraint will be never stored
 		std::vector< std::vector< unsigned int > > _indexes;	///< The indexes needed for the corresponding constraint store
+		std::vector< std::optional< std::pair< long long, long long > > > _dense_ranges;	///< The range of each parameter given by pragma dense (empty if none)
 
 		/**
 		 * Default constructor.
@@ -31,6 +31,7 @@ int main()
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <iterator>
 #include <regex>
 
 #include <visitor/program.hh>
@@ -64,6 +65,14 @@ int main( int argc, const char** argv )
 			{ "disable-constraint_store_index", "", false, "Disable the use of an indexing data structure for managing constraint store."},
 			{ "enable-line_error", "le", false, "Enable friendly line error in chrpp source file (default)."},
 			{ "disable-line_error", "", false, "Disable friendly line error in chrpp source file."},
+			{ "enable-suspend_points", "", false, "Enable the suspension of the CHR program at each choice point when it runs in a chr::Fiber."},
+			{ "disable-suspend_points", "", false, "Disable the suspension of the CHR program at choice points (default)."},
+			{ "enable-backjumping", "", false, "Enable the conflict-directed backjumping (chr::Backjump) at choice points."},
+			{ "disable-backjumping", "", false, "Disable the conflict-directed backjumping at choice points (default)."},
+			{ "enable-cancellation_points", "", false, "Enable the cancellation of the CHR program at each choice point (chr::Cancellation, needed by run_async, the parallel quantifiers and restart, enabled when the input file uses them)."},
+			{ "disable-cancellation_points", "", false, "Disable the cancellation of the CHR program at choice points (default if the input file doesn't use run_async, the parallel quantifiers or restart)."},
+			{ "enable-bound_pruning", "", false, "Enable the pruning of the branches of a branch and bound search (chr::Bound, used by minimize) at each choice point."},
+			{ "disable-bound_pruning", "", false, "Disable the pruning of the branches of a branch and bound search at choice points (default)."},
 			{ "", "", false, "File name to parse."}
 	});
 
@@ -111,6 +120,22 @@ int main( int argc, const char** argv )
 		chr::compiler::Compiler_options::LINE_ERROR = false;
 	if (has_option("enable-line_error", options))
 		chr::compiler::Compiler_options::LINE_ERROR = true;
+	if (has_option("disable-suspend_points", options))
+		chr::compiler::Compiler_options::SUSPEND_POINTS = false;
+	if (has_option("enable-suspend_points", options))
+		chr::compiler::Compiler_options::SUSPEND_POINTS = true;
+	if (has_option("disable-backjumping", options))
+		chr::compiler::Compiler_options::BACKJUMPING = false;
+	if (has_option("enable-backjumping", options))
+		chr::compiler::Compiler_options::BACKJUMPING = true;
+	if (has_option("disable-cancellation_points", options))
+		chr::compiler::Compiler_options::CANCELLATION_POINTS = false;
+	if (has_option("enable-cancellation_points", options))
+		chr::compiler::Compiler_options::CANCELLATION_POINTS = true;
+	if (has_option("disable-bound_pruning", options))
+		chr::compiler::Compiler_options::BOUND_PRUNING = false;
+	if (has_option("enable-bound_pruning", options))
+		chr::compiler::Compiler_options::BOUND_PRUNING = true;
 	if (has_option("disable-warning_unused_rule", options))
 		chr::compiler::Compiler_options::WARNING_UNUSED_RULE = false;
 	if (has_option("enable-warning_unused_rule", options))
@@ -205,6 +230,7 @@ int main( int argc, const char** argv )
 	// -----------------------------------------------------------------
 	// Parse input
 	std::vector< chr::compiler::parser::ast_builder::AstProgramBuilder > chr_prg_results;
+	std::string stdin_content;
 	int ret = 0;
 	if (has_option("", options, file_names))
 	{
@@ -224,16 +250,39 @@ int main( int argc, const char** argv )
 			return 1;
 		}
 	
-		std::string str_content;
 		std::string str_line;
 		while (!std::getline(std::cin, str_line).fail())
-			str_content += str_line;
-		TAO_PEGTL_NAMESPACE::string_input in( str_content, "std::cin" );
+			stdin_content += str_line;
+		TAO_PEGTL_NAMESPACE::string_input in( stdin_content, "std::cin" );
 		ret = chr::compiler::parse_chr_input(in, chr_prg_results);
 	}
 	// If parsing failed, stop here
 	if (ret != 0) return ret;
 
+	// The restart statement, run_async, run_cancellable and the parallel
+	// quantifiers stop the CHR programs through their cancellation tests:
+	// these tests are generated if the input file uses one of them, unless
+	// they have been explicitly disabled.
+	if (!chr::compiler::Compiler_options::CANCELLATION_POINTS)
+	{
+		std::string str_content;
+		if (has_option("", options, file_names))
+		{
+			std::ifstream ifs_input_file(file_names[0].str());
+			str_content.assign(std::istreambuf_iterator< char >(ifs_input_file), std::istreambuf_iterator< char >());
+		} else
+			str_content = stdin_content;
+		std::regex regex_cancellation(R"_STR(\b(restart|run_async|run_cancellable|parallel_(forall|exists)(_it|_values)?)\s*[(<])_STR");
+		std::smatch regex_match;
+		if (std::regex_search(str_content, regex_match, regex_cancellation))
+		{
+			if (has_option("disable-cancellation_points", options))
+				std::cerr << "warning: " << regex_match[1] << " is used but the cancellation points are disabled, it won't stop the CHR programs" << std::endl;
+			else
+				chr::compiler::Compiler_options::CANCELLATION_POINTS = true;
+		}
+	}
+
 	// Generate CPP code
 	if (chr::compiler::Compiler_options::STDOUT)
 	{
@@ -82,7 +82,8 @@ namespace chr::compiler {
 						auto pSequence = dynamic_cast< chr::compiler::ast::Sequence* >(&b);
 						auto pBehavior = dynamic_cast< chr::compiler::ast::ChrBehavior* >(&b);
 						auto pTry = dynamic_cast< chr::compiler::ast::ChrTry* >(&b);
-						if ((pBehavior != nullptr) || (pTry != nullptr) ||
+						auto pSearch = dynamic_cast< chr::compiler::ast::ChrSearch* >(&b);
+						if ((pBehavior != nullptr) || (pTry != nullptr) || (pSearch != nullptr) ||
 								((pSequence != nullptr) && (pSequence->op() == ";")))
 						{
 							apply_all_persistent = false;
@@ -46,18 +46,20 @@ namespace chr::compiler
 		bang,			//!< Pragma bang
 		persistent,		//!< Pragma persistent
 		catch_failure,	//!< Pragma catch_failure
+		dense,			//!< Pragma dense
 	};
 
 	/**
 	 * @brief String representation of pragma values
 	 */
-	const std::array< const char*, 6 > StrPragma {
+	const std::array< const char*, 7 > StrPragma {
 		"passive",
 		"no_history",
 		"no_reactivate",
 		"bang",	
 		"persistent",
-		"catch_failure"
+		"catch_failure",
+		"dense"
 	};
 
 	/**
@@ -75,6 +77,10 @@ namespace chr::compiler
 		static bool OCCURRENCES_REORDER;		///< Enable occurrences reorder optimization
 		static bool CONSTRAINT_STORE_INDEX;		///< Enable the use of an indexing data structure for managing constraint store
 		static bool LINE_ERROR;					///< Write friendly line errors in chrpp source file
+		static bool SUSPEND_POINTS;				///< Generate a suspension point (chr::Fiber) at each choice point
+		static bool BACKJUMPING;				///< Generate the conflict-directed backjumping (chr::Backjump) at each choice point
+		static bool CANCELLATION_POINTS;		///< Generate the cancellation test (chr::Cancellation) at each choice point
+		static bool BOUND_PRUNING;				///< Generate the bound test of a branch and bound search (chr::Bound) at each choice point
 		static std::string OUTPUT_DIR;			///< Ouput directory for all CHR generated file (only if no -stdout set)
 		static int CHRPPC_MAJOR;				///< Major version of chrppc
 		static int CHRPPC_MINOR;				///< Minor version of chrppc
@@ -6,6 +6,10 @@ bool chr::compiler::Compiler_options::WARNING_UNUSED_RULE = true;
 bool chr::compiler::Compiler_options::NEVER_STORED = true;
 bool chr::compiler::Compiler_options::CONSTRAINT_STORE_INDEX = true;
 bool chr::compiler::Compiler_options::LINE_ERROR = true;
+bool chr::compiler::Compiler_options::SUSPEND_POINTS = false;
+bool chr::compiler::Compiler_options::BACKJUMPING = false;
+bool chr::compiler::Compiler_options::CANCELLATION_POINTS = false;
+bool chr::compiler::Compiler_options::BOUND_PRUNING = false;
 bool chr::compiler::Compiler_options::HEAD_REORDER = true;
 bool chr::compiler::Compiler_options::GUARD_REORDER = true;
 bool chr::compiler::Compiler_options::OCCURRENCES_REORDER = true;
@@ -22,6 +22,7 @@
 #include <cassert>
 #include <cstdint>
 #include <cstring>
+#include <stdexcept>
 
 #include <tao/pegtl.hpp>
 #include <ast/expression.hh>
@@ -246,6 +247,34 @@ namespace chr::compiler::parser
 		}
 	};
 
+	/**
+	 * Specialisation of the _action_ class for a chr_nogood
+	 */
+	template< typename U, typename V >
+	struct action< grammar::body::chr_nogood<U, V> >
+	{
+		template< typename Input, typename... States >
+		static void apply( const Input& in, ast_builder::AstBodyBuilder& res, States&&... /*unused*/ )
+		{
+			PositionInfo pos(in.position());
+			res.nogood( pos );
+		}
+	};
+
+	/**
+	 * Specialisation of the _action_ class for a chr_restart
+	 */
+	template< typename U, typename V >
+	struct action< grammar::body::chr_restart<U, V> >
+	{
+		template< typename Input, typename... States >
+		static void apply( const Input& in, ast_builder::AstBodyBuilder& res, States&&... /*unused*/ )
+		{
+			PositionInfo pos(in.position());
+			res.restart( pos );
+		}
+	};
+
 	/**
 	 * Specialisation of the _action_ class for a chr_behavior
 	 */
@@ -302,6 +331,34 @@ namespace chr::compiler::parser
 		}
 	};
 
+	/**
+	 * Specialisation of the _action_ class for a chr_order_by
+	 */
+	template< typename U, typename V >
+	struct action< grammar::body::chr_order_by<U, V> >
+	{
+		template< typename Input, typename... States >
+		static void apply( const Input& in, ast_builder::AstBodyBuilder& res, States&&... /*unused*/ )
+		{
+			PositionInfo pos(in.position());
+			res.order_by( pos );
+		}
+	};
+
+	/**
+	 * Specialisation of the _action_ class for a chr_symmetric
+	 */
+	template< typename U, typename V >
+	struct action< grammar::body::chr_symmetric<U, V> >
+	{
+		template< typename Input, typename... States >
+		static void apply( const Input& in, ast_builder::AstBodyBuilder& res, States&&... /*unused*/ )
+		{
+			PositionInfo pos(in.position());
+			res.symmetric( pos );
+		}
+	};
+
 	/**
 	 * Specialisation of the _action_ class for a chr_exists
 	 */
@@ -358,6 +415,118 @@ namespace chr::compiler::parser
 		}
 	};
 
+	/**
+	 * Specialisation of the _action_ class for a chr_alphabeta_max
+	 */
+	template< typename U, typename V >
+	struct action< grammar::body::chr_alphabeta_max<U, V> >
+	{
+		template< typename Input, typename... States >
+		static void apply( const Input& in, ast_builder::AstBodyBuilder& res, States&&... /*unused*/ )
+		{
+			PositionInfo pos(in.position());
+			res.alphabeta( "alphabeta_max", pos );
+		}
+	};
+
+	/**
+	 * Specialisation of the _action_ class for a chr_alphabeta_min
+	 */
+	template< typename U, typename V >
+	struct action< grammar::body::chr_alphabeta_min<U, V> >
+	{
+		template< typename Input, typename... States >
+		static void apply( const Input& in, ast_builder::AstBodyBuilder& res, States&&... /*unused*/ )
+		{
+			PositionInfo pos(in.position());
+			res.alphabeta( "alphabeta_min", pos );
+		}
+	};
+
+	/**
+	 * Specialisation of the _action_ class for a chr_negamax
+	 */
+	template< typename U, typename V >
+	struct action< grammar::body::chr_negamax<U, V> >
+	{
+		template< typename Input, typename... States >
+		static void apply( const Input& in, ast_builder::AstBodyBuilder& res, States&&... /*unused*/ )
+		{
+			PositionInfo pos(in.position());
+			res.alphabeta( "negamax", pos );
+		}
+	};
+
+	/**
+	 * Specialisation of the _action_ class for a chr_expectation
+	 */
+	template< typename U, typename V >
+	struct action< grammar::body::chr_expectation<U, V> >
+	{
+		template< typename Input, typename... States >
+		static void apply( const Input& in, ast_builder::AstBodyBuilder& res, States&&... /*unused*/ )
+		{
+			PositionInfo pos(in.position());
+			res.alphabeta( "expectation", pos );
+		}
+	};
+
+	/**
+	 * Specialisation of the _action_ class for a chr_best_first
+	 */
+	template< typename U, typename V >
+	struct action< grammar::body::chr_best_first<U, V> >
+	{
+		template< typename Input, typename... States >
+		static void apply( const Input& in, ast_builder::AstBodyBuilder& res, States&&... /*unused*/ )
+		{
+			PositionInfo pos(in.position());
+			res.search( "best_first", 3, pos );
+		}
+	};
+
+	/**
+	 * Specialisation of the _action_ class for a chr_astar
+	 */
+	template< typename U, typename V >
+	struct action< grammar::body::chr_astar<U, V> >
+	{
+		template< typename Input, typename... States >
+		static void apply( const Input& in, ast_builder::AstBodyBuilder& res, States&&... /*unused*/ )
+		{
+			PositionInfo pos(in.position());
+			res.search( "astar", 4, pos );
+		}
+	};
+
+	/**
+	 * Specialisation of the _action_ class for a chr_mcts
+	 */
+	template< typename U, typename V >
+	struct action< grammar::body::chr_mcts<U, V> >
+	{
+		template< typename Input, typename... States >
+		static void apply( const Input& in, ast_builder::AstBodyBuilder& res, States&&... /*unused*/ )
+		{
+			PositionInfo pos(in.position());
+			res.search( "mcts", 3, pos );
+		}
+	};
+
+	/**
+	 * Specialisation of the _action_ class for a chr_minimize
+	 */
+	template< typename U, typename V >
+	struct action< grammar::body::chr_minimize<U, V> >
+	{
+		template< typename Input, typename... States >
+		static void apply( const Input& in, ast_builder::AstBodyBuilder& res, States&&... /*unused*/ )
+		{
+			PositionInfo pos(in.position());
+			res.minimize( 2, pos );
+		}
+	};
+
 	/**
 	 * Specialisation of the _action_ class for a constraint_call_pragma_value.
 	 */
@@ -492,11 +661,52 @@ namespace chr::compiler::parser
 				res.add_chr_constraint_pragma( Pragma::persistent );
 			else if (in.string() == "no_reactivate")
 				res.add_chr_constraint_pragma( Pragma::no_reactivate );
+			else if (in.string().compare(0, 5, "dense") == 0)
+				res.add_chr_constraint_dense_ranges( pos );
 			else
 				throw ParseError("parse error, unknown Pragma", pos);
 		}
 	};
 
+	/**
+	 * Specialisation of the _action_ class for a range of pragma dense.
+	 */
+	template<>
+	struct action< grammar::constraint_decl_dense_range >
+	{
+		template< typename Input, typename... States >
+		static void apply( const Input& in, ast_builder::AstProgramBuilder& res, States&&... /*unused*/ )
+		{
+			PositionInfo pos(in.position());
+			std::string str = in.string();
+			std::size_t sep = str.find("..");
+			assert(sep != std::string::npos);
+			long long min = 0, max = 0;
+			try {
+				min = std::stoll( str.substr(0, sep) );
+				max = std::stoll( str.substr(sep + 2) );
+			} catch (const std::out_of_range&) {
+				throw ParseError("parse error, bound of pragma dense out of range", pos);
+			}
+			if (min > max)
+				throw ParseError("parse error, empty range in pragma dense", pos);
+			res._dense_ranges.push_back( std::make_pair(min, max) );
+		}
+	};
+
+	/**
+	 * Specialisation of the _action_ class for a parameter without range of pragma dense.
+	 */
+	template<>
+	struct action< grammar::constraint_decl_dense_no_range >
+	{
+		template< typename Input, typename... States >
+		static void apply( const Input&, ast_builder::AstProgramBuilder& res, States&&... /*unused*/ )
+		{
+			res._dense_ranges.push_back( std::nullopt );
+		}
+	};
+
 	/**
 	 * Specialisation of the _action_ class for a constraint_arg_type_mode
 	 */
@@ -292,6 +292,184 @@ namespace chr::compiler::parser::ast_builder
 			body_stack.back() = std::move( tmp );
 		}
 
+		/**
+		 * Function to construct and stack a nogood chr statement.
+		 * The statement nogood(store, key, (body)) is rewritten as:
+		 * __nogood_key__n = key, __nogood_refusals__n = chr::Search_limit::refusals(),
+		 * chr::nogood_check(store, __nogood_key__n) # catch_failure,
+		 * ( body ; chr::nogood_record(store, __nogood_key__n, __nogood_refusals__n) # catch_failure )
+		 * The recording alternative is not subject to the search limits.
+		 * @param p The position of element in source
+		 */
+		void nogood( PositionInfo p )
+		{
+			assert( body_stack.size() >= 3 );
+
+			// Convert the store and the key to PtrExpression
+			ast::PtrExpression store;
+			check_no_chr_statement( body_stack.at( body_stack.size() - 3 ), false );
+			try {
+				ast::CppExpression& s = dynamic_cast< ast::CppExpression& >( *body_stack.at( body_stack.size() - 3 ) );
+				store.swap(s.expression());
+			} catch (std::bad_cast&) {
+				throw ParseError("parse error matching nogood store", body_stack.at( body_stack.size() - 3 )->position());
+			}
+			ast::PtrExpression key;
+			check_no_chr_statement( body_stack.at( body_stack.size() - 2 ), false );
+			try {
+				ast::CppExpression& s = dynamic_cast< ast::CppExpression& >( *body_stack.at( body_stack.size() - 2 ) );
+				key.swap(s.expression());
+			} catch (std::bad_cast&) {
+				throw ParseError("parse error matching nogood key", body_stack.at( body_stack.size() - 2 )->position());
+			}
+
+			unsigned int n = body_stack.size();
+			std::string s_key = std::string("__nogood_key__") + std::to_string(n);
+			auto init_key = std::make_unique< ast::CppDeclAssignment >(
+					std::make_unique< ast::CppVariable >( s_key, key->position() ),
+					std::move( key ),
+					p);
+			std::string s_refusals = std::string("__nogood_refusals__") + std::to_string(n);
+			std::vector< ast::PtrExpression > refusals_args;
+			auto init_refusals = std::make_unique< ast::CppDeclAssignment >(
+					std::make_unique< ast::CppVariable >( s_refusals, p ),
+					std::make_unique< ast::BuiltinConstraint >(
+						std::make_unique< ast::Identifier >( std::string("chr::Search_limit::refusals"), p ),
+						std::string("("), std::string(")"),
+						refusals_args,
+						p),
+					p);
+
+			std::vector< ast::PtrExpression > check_args;
+			check_args.emplace_back( ast::PtrExpression(store->clone()) );
+			check_args.emplace_back( std::make_unique< ast::CppVariable >( s_key, p ) );
+			auto check = std::make_unique< ast::CppExpression >(
+					std::make_unique< ast::BuiltinConstraint >(
+						std::make_unique< ast::Identifier >( std::string("chr::nogood_check"), p ),
+						std::string("("), std::string(")"),
+						check_args,
+						p),
+					std::vector< Pragma >{ Pragma::catch_failure },
+					p);
+
+			std::vector< ast::PtrExpression > record_args;
+			record_args.emplace_back( std::move(store) );
+			record_args.emplace_back( std::make_unique< ast::CppVariable >( s_key, p ) );
+			record_args.emplace_back( std::make_unique< ast::CppVariable >( s_refusals, p ) );
+			auto record = std::make_unique< ast::CppExpression >(
+					std::make_unique< ast::BuiltinConstraint >(
+						std::make_unique< ast::Identifier >( std::string("chr::nogood_record"), p ),
+						std::string("("), std::string(")"),
+						record_args,
+						p),
+					std::vector< Pragma >{ Pragma::catch_failure },
+					p);
+
+			auto alternatives = std::make_unique< ast::Sequence >(std::string(";"), p);
+			alternatives->set_search_limited( false );
+			alternatives->add_child( std::move(body_stack.at( body_stack.size() - 1)) );
+			alternatives->add_child( std::move(record) );
+
+			ast::PtrSequence tmp = std::make_unique< ast::Sequence >(std::string(","), p);
+			tmp->add_child( std::move(init_key) );
+			tmp->add_child( std::move(init_refusals) );
+			tmp->add_child( std::move(check) );
+			tmp->add_child( std::move(alternatives) );
+			body_stack.resize( body_stack.size() - 2 );
+			body_stack.back() = std::move( tmp );
+		}
+
+		/**
+		 * Function to construct and stack a restart chr statement. It is
+		 * rewritten as a behavior which runs the body until a run succeeds
+		 * or the restart policy stops it.
+		 * @param p The position of element in source
+		 */
+		void restart( PositionInfo p )
+		{
+			assert( body_stack.size() >= 2 );
+
+			// Convert the policy to PtrExpression
+			ast::PtrExpression policy;
+			check_no_chr_statement( body_stack.at( body_stack.size() - 2 ), false );
+			try {
+				ast::CppExpression& s = dynamic_cast< ast::CppExpression& >( *body_stack.at( body_stack.size() - 2 ) );
+				policy.swap(s.expression());
+			} catch (std::bad_cast&) {
+				throw ParseError("parse error matching restart policy", body_stack.at( body_stack.size() - 2 )->position());
+			}
+
+			unsigned int n = body_stack.size();
+			std::string s_done = std::string("__restart_done__") + std::to_string(n);
+			std::string s_success = std::string("__restart_success__") + std::to_string(n);
+
+			auto restart_end = [&](bool succeeded) {
+				std::vector< ast::PtrExpression > args;
+				args.emplace_back( ast::PtrExpression(policy->clone()) );
+				args.emplace_back( std::make_unique< ast::Literal >( (succeeded?std::string("true"):std::string("false")), p ) );
+				return std::make_unique< ast::CppDeclAssignment >(
+						std::make_unique< ast::CppVariable >( s_done, p ),
+						std::make_unique< ast::BuiltinConstraint >(
+							std::make_unique< ast::Identifier >( std::string("chr::restart_end"), p ),
+							std::string("("), std::string(")"),
+							args,
+							p),
+						p);
+			};
+
+			// Create on_succeeded_alt
+			auto on_succeeded_alt = std::make_unique< ast::Sequence >(std::string(","), p);
+			on_succeeded_alt->add_child( std::make_unique< ast::CppDeclAssignment >(
+						std::make_unique< ast::CppVariable >( s_success, p ),
+						std::make_unique< ast::Literal >( std::string("true"), p ),
+						p) );
+			on_succeeded_alt->add_child( restart_end(true) );
+
+			// Create on_failed_alt
+			auto on_failed_alt = restart_end(false);
+
+			// Create body: set the failure limit of the run first
+			std::vector< ast::PtrExpression > run_args;
+			run_args.emplace_back( std::move(policy) );
+			auto body_sequence = std::make_unique< ast::Sequence >(std::string(","), p);
+			body_sequence->add_child( std::make_unique< ast::CppExpression >(
+						std::make_unique< ast::BuiltinConstraint >(
+							std::make_unique< ast::Identifier >( std::string("chr::restart_run"), p ),
+							std::string("("), std::string(")"),
+							run_args,
+							p),
+						p) );
+			auto body = std::move(body_stack.at( body_stack.size() - 1));
+			auto ptr_body = dynamic_cast<ast::Sequence*>( body.get() );
+			if ((ptr_body != nullptr) and (ptr_body->op() == ","))
+			{
+				for (auto& child : ptr_body->children())
+					body_sequence->add_child( std::move(child) );
+			} else
+				body_sequence->add_child( std::move(body) );
+
+			ast::PtrSequence tmp = std::make_unique< ast::Sequence >(std::string(","), p);
+			tmp->add_child( std::make_unique< ast::CppDeclAssignment >(
+						std::make_unique< ast::CppVariable >( s_done, p ),
+						std::make_unique< ast::Literal >( std::string("false"), p ),
+						p) );
+			tmp->add_child( std::make_unique< ast::CppDeclAssignment >(
+						std::make_unique< ast::CppVariable >( s_success, p ),
+						std::make_unique< ast::Literal >( std::string("false"), p ),
+						p) );
+			tmp->add_child( std::make_unique< ast::ChrBehavior >(
+						std::make_unique< ast::CppVariable >( s_done, p ),
+						std::move(on_succeeded_alt),
+						std::move(on_failed_alt),
+						std::make_unique< ast::CppVariable >( s_success, p ),
+						std::make_unique< ast::Body >(p),
+						std::make_unique< ast::Body >(p),
+						std::move(body_sequence),
+						p) );
+			body_stack.resize( body_stack.size() - 1 );
+			body_stack.back() = std::move( tmp );
+		}
+
 		/**
 		 * Function to construct and stack a behavior chr statement
 		 * @param p The position of element in source
@@ -340,12 +518,83 @@ namespace chr::compiler::parser::ast_builder
 			body_stack.back() = std::move( tmp );
 		}
 
+		/**
+		 * Function to record that the last parsed expression is the scoring
+		 * function of an order_by clause.
+		 * @param p The position of element in source
+		 */
+		void order_by( PositionInfo p )
+		{
+			if (body_stack.empty())
+				throw ParseError("parse error matching order_by clause", p);
+			order_by_positions.push_back( body_stack.size() - 1 );
+		}
+
+		/**
+		 * Function to record that the last parsed expression is the symmetry
+		 * function of a symmetric clause.
+		 * @param p The position of element in source
+		 */
+		void symmetric( PositionInfo p )
+		{
+			if (body_stack.empty())
+				throw ParseError("parse error matching symmetric clause", p);
+			symmetric_positions.push_back( body_stack.size() - 1 );
+		}
+
+		/**
+		 * Function to extract the expression of an optional clause of the
+		 * statement being built (just before its body), if any.
+		 * @param positions The positions in stack of the expressions of this kind of clause
+		 * @param error The error message if the clause is not an expression
+		 * @return The expression or nullptr if the statement has no such clause
+		 */
+		ast::PtrExpression pop_clause( std::vector< std::size_t >& positions, const char* error )
+		{
+			ast::PtrExpression clause;
+			if (!positions.empty() && (body_stack.size() >= 2) && (positions.back() == body_stack.size() - 2))
+			{
+				positions.pop_back();
+				check_no_chr_statement( body_stack.at( body_stack.size() - 2 ), false );
+				try {
+					ast::CppExpression& s = dynamic_cast< ast::CppExpression& >( *body_stack.at( body_stack.size() - 2 ) );
+					clause.swap(s.expression());
+				} catch (std::bad_cast&) {
+					throw ParseError(error, body_stack.at( body_stack.size() - 2 )->position());
+				}
+				body_stack.erase( body_stack.end() - 2 );
+			}
+			return clause;
+		}
+
+		/**
+		 * Function to extract the scoring function of the order_by clause of
+		 * the statement being built (just before its body), if any.
+		 * @return The scoring function or nullptr if the statement has no order_by clause
+		 */
+		ast::PtrExpression pop_order_by()
+		{
+			return pop_clause( order_by_positions, "parse error matching order_by scoring function" );
+		}
+
+		/**
+		 * Function to extract the symmetry function of the symmetric clause of
+		 * the statement being built (just before its body), if any.
+		 * @return The symmetry function or nullptr if the statement has no symmetric clause
+		 */
+		ast::PtrExpression pop_symmetric()
+		{
+			return pop_clause( symmetric_positions, "parse error matching symmetric function" );
+		}
+
 		/**
 		 * Function to construct and stack an exists and for_all chr statement
 		 * @param p The position of element in source
 		 */
 		void exists_forall(std::string_view name, PositionInfo p )
 		{
+			ast::PtrExpression symmetry = pop_symmetric();
+			ast::PtrExpression order = pop_order_by();
 			assert( body_stack.size() >= 4 );
 
 			// Convert first expression to CppVariable
@@ -386,8 +635,31 @@ namespace chr::compiler::parser::ast_builder
 				throw ParseError("parse error matching upper bound", body_stack.at( body_stack.size() - 2 )->position());
 			}
 
-			// Create stop condition
+			// Ordered or symmetric alternatives: iterate on the values of the range
 			unsigned int n = body_stack.size();
+			if (order || symmetry)
+			{
+				std::vector< ast::PtrExpression > args;
+				args.emplace_back( std::move(lower_bound) );
+				args.emplace_back( std::move(upper_bound) );
+				if (order)
+				{
+					args.emplace_back( ast::PtrExpression(order->clone()) );
+					args.emplace_back( std::make_unique< ast::CppVariable >( std::string("__ply_") + std::string(cpp_variable->value()), p ) );
+				}
+				ast::PtrExpression container = std::make_unique< ast::BuiltinConstraint >(
+						std::make_unique< ast::Identifier >( std::string(order ? "chr::order_values" : "chr::range_values"), p ),
+						std::string("("), std::string(")"),
+						args,
+						p);
+				auto body = std::move(body_stack.at( body_stack.size() - 1));
+				auto tmp = exists_forall_on_container(name, std::move(cpp_variable), std::move(container), std::move(order), std::move(symmetry), std::move(body), n, p);
+				body_stack.resize( body_stack.size() - 3 );
+				body_stack.back() = std::move( tmp );
+				return;
+			}
+
+			// Create stop condition
 			ast::PtrExpression stop_cond;
 			if (name == "exists")
 				stop_cond = std::make_unique< ast::InfixExpression >(
@@ -500,6 +772,8 @@ namespace chr::compiler::parser::ast_builder
 		 */
 		void exists_forall_it(std::string_view name, PositionInfo p )
 		{
+			ast::PtrExpression symmetry = pop_symmetric();
+			ast::PtrExpression order = pop_order_by();
 			assert( body_stack.size() >= 3 );
 
 			// Convert first expression to CppVariable
@@ -519,8 +793,6 @@ namespace chr::compiler::parser::ast_builder
 			} catch (std::bad_cast&) {
 				throw ParseError("parse error matching local variable identifier", ptr_tmp->position());
 			}
-			std::string s_it = std::string("__it_") + std::string(cpp_variable->value());
-			std::string s_it_end = std::string("__it_end_") + std::string(cpp_variable->value());
 
 			// Convert second expression (container) to PtrExpression
 			check_no_chr_statement( body_stack.at( body_stack.size() - 2 ), false );
@@ -532,8 +804,76 @@ namespace chr::compiler::parser::ast_builder
 				throw ParseError("parse error matching container expression", body_stack.at( body_stack.size() - 2 )->position());
 			}
 
-			// Create stop condition
 			unsigned int n = body_stack.size();
+			auto body = std::move(body_stack.at( body_stack.size() - 1));
+			auto tmp = exists_forall_on_container(name, std::move(cpp_variable), std::move(container), std::move(order), std::move(symmetry), std::move(body), n, p);
+			body_stack.resize( body_stack.size() - 2 );
+			body_stack.back() = std::move( tmp );
+		}
+
+		/**
+		 * Function to build an exists and for_all on a container. If \a order is
+		 * not null, the elements of the container are first sorted by decreasing
+		 * score and the scoring function is rewarded with the element which ends the loop.
+		 * If \a symmetry is not null, only the first element of each symmetry class is kept.
+		 * @param name The name of the statement (exists or forall)
+		 * @param cpp_variable The variable receiving the current element
+		 * @param container The container to iterate
+		 * @param order The scoring function (may be null)
+		 * @param symmetry The symmetry function (may be null)
+		 * @param body The body of the statement
+		 * @param n The unique number used to name local variables
+		 * @param p The position of element in source
+		 * @return The sequence of statements
+		 */
+		ast::PtrSequence exists_forall_on_container(std::string_view name, std::unique_ptr< ast::CppVariable > cpp_variable, ast::PtrExpression container, ast::PtrExpression order, ast::PtrExpression symmetry, ast::PtrBody body, unsigned int n, PositionInfo p)
+		{
+			std::string s_it = std::string("__it_") + std::string(cpp_variable->value());
+			std::string s_it_end = std::string("__it_end_") + std::string(cpp_variable->value());
+			std::string s_ply = std::string("__ply_") + std::string(cpp_variable->value());
+			std::string s_order = std::string("__order_") + std::string(cpp_variable->value());
+
+			// Representatives of the symmetry classes
+			bool copy = order || symmetry;
+			if (symmetry)
+			{
+				std::vector< ast::PtrExpression > args;
+				args.emplace_back( std::move(container) );
+				args.emplace_back( std::move(symmetry) );
+				container = std::make_unique< ast::BuiltinConstraint >(
+						std::make_unique< ast::Identifier >( std::string("chr::symmetry_container"), p ),
+						std::string("("), std::string(")"),
+						args,
+						p);
+			}
+
+			// Sorted or filtered copy of the container
+			std::unique_ptr< ast::CppExpression > init_ply;
+			std::unique_ptr< ast::CppExpression > init_order;
+			if (order)
+			{
+				std::vector< ast::PtrExpression > empty_vector;
+				init_ply = std::make_unique< ast::CppDeclAssignment >(
+						std::make_unique< ast::CppVariable >( s_ply, p ),
+						std::make_unique< ast::BuiltinConstraint >(
+							std::make_unique< ast::Identifier >( std::string("chr::Backtrack::depth"), p ),
+							std::string("("), std::string(")"),
+							empty_vector,
+							p),
+						p);
+			}
+			if (copy)
+			{
+				init_order = std::make_unique< ast::CppDeclAssignment >(
+						std::make_unique< ast::CppVariable >(
+							s_order,
+							container->position()),
+						std::move( container ),
+						p);
+				container = std::make_unique< ast::CppVariable >( s_order, p );
+			}
+
+			// Create stop condition
 			ast::PtrExpression stop_cond;
 			if (name == "exists")
 				stop_cond = std::make_unique< ast::InfixExpression >(
@@ -586,6 +926,30 @@ namespace chr::compiler::parser::ast_builder
 						p),
 					p);
 
+			// Reward the scoring function with the element which ends the loop
+			ast::PtrBody ending_alt = std::move(on_succeeded_alt);
+			if (order)
+			{
+				std::vector< ast::PtrExpression > reward_args;
+				reward_args.emplace_back( ast::PtrExpression(order->clone()) );
+				reward_args.emplace_back( std::make_unique< ast::PrefixExpression >(
+							std::string("*"),
+							std::make_unique< ast::CppVariable >( s_it, p ),
+							p) );
+				reward_args.emplace_back( std::make_unique< ast::CppVariable >( s_ply, p ) );
+				auto reward = std::make_unique< ast::CppExpression >(
+						std::make_unique< ast::BuiltinConstraint >(
+							std::make_unique< ast::Identifier >( std::string("chr::order_reward"), p ),
+							std::string("("), std::string(")"),
+							reward_args,
+							p),
+						p);
+				auto seq = std::make_unique< ast::Sequence >(std::string(","), p);
+				seq->add_child( std::move(ending_alt) );
+				seq->add_child( std::move(reward) );
+				ending_alt = std::move(seq);
+			}
+
 			// Create on_failed_alt
 			auto on_failed_alt = std::make_unique<ast::CppExpression>(
 					std::make_unique< ast::PrefixExpression >(
@@ -666,7 +1030,6 @@ namespace chr::compiler::parser::ast_builder
 									container->position()),
 								container->position()),
 						container->position());
-			auto body = std::move(body_stack.at( body_stack.size() - 1));
 
 			auto body_sequence = std::make_unique< ast::Sequence >(std::string(","), p);
 			body_sequence->add_child( std::move(decl_ass) );
@@ -679,6 +1042,10 @@ namespace chr::compiler::parser::ast_builder
 				body_sequence->add_child( std::move(body) );
 	
 			ast::PtrSequence tmp = std::make_unique< ast::Sequence >(std::string(","), p);
+			if (order)
+				tmp->add_child( std::move(init_ply) );
+			if (copy)
+				tmp->add_child( std::move(init_order) );
 			tmp->add_child( std::move(init_it) );
 			tmp->add_child( std::move(init_it_end) );
 			tmp->add_child( std::move(init_local_success) );
@@ -686,7 +1053,7 @@ namespace chr::compiler::parser::ast_builder
 			if (name == "exists")
 				tmp->add_child(std::make_unique< ast::ChrBehavior >(
 							std::move( stop_cond ),
-							std::move(on_succeeded_alt),
+							std::move(ending_alt),
 							std::move(on_failed_alt),
 							std::move( std::move(final_status) ),
 							std::make_unique< ast::Body >(p),
@@ -697,17 +1064,324 @@ namespace chr::compiler::parser::ast_builder
 				tmp->add_child(std::make_unique< ast::ChrBehavior >(
 							std::move( stop_cond ),
 							std::move(on_failed_alt), // SWAP
-							std::move(on_succeeded_alt), //SWAP
+							std::move(ending_alt), //SWAP
 							std::move( std::move(final_status) ),
 							std::make_unique< ast::Body >(p),
 							std::make_unique< ast::Body >(p),
 							std::move(body_sequence),
 							p) );
-	
-			body_stack.resize( body_stack.size() - 2 );
+
+			return tmp;
+		}
+
+		/**
+		 * Function to construct and stack an alphabeta_max, alphabeta_min,
+		 * negamax or expectation chr statement
+		 * @param name The name of the statement
+		 * @param p The position of element in source
+		 */
+		void alphabeta(std::string_view name, PositionInfo p )
+		{
+			ast::PtrExpression order = pop_order_by();
+			assert( body_stack.size() >= 8 );
+
+			// Convert first and fourth expressions to CppVariable
+			auto to_cpp_variable = [&](std::size_t i) {
+				cast_identifier_to_var( i );
+				ast::PtrExpression ptr_tmp;
+				try {
+					ast::CppExpression& s = dynamic_cast< ast::CppExpression& >( *body_stack.at( i ) );
+					ptr_tmp.swap(s.expression());
+				} catch (std::bad_cast&) {
+					throw ParseError("parse error matching local variable identifier", body_stack.at( i )->position() );
+				}
+				std::unique_ptr< ast::CppVariable > cpp_variable;
+				try {
+					ast::CppVariable& s = dynamic_cast< ast::CppVariable& >( *ptr_tmp );
+					ptr_tmp.release();
+					cpp_variable.reset(&s);
+				} catch (std::bad_cast&) {
+					throw ParseError("parse error matching local variable identifier", ptr_tmp->position());
+				}
+				return cpp_variable;
+			};
+
+			// Convert other expressions (bounds, window and score) to PtrExpression
+			auto to_expression = [&](std::size_t i, const char* error) {
+				check_no_chr_statement( body_stack.at( i ), false );
+				ast::PtrExpression e;
+				try {
+					ast::CppExpression& s = dynamic_cast< ast::CppExpression& >( *body_stack.at( i ) );
+					e.swap(s.expression());
+				} catch (std::bad_cast&) {
+					throw ParseError(error, body_stack.at( i )->position());
+				}
+				return e;
+			};
+
+			std::size_t n = body_stack.size();
+			std::unique_ptr< ast::CppVariable > cpp_variable = to_cpp_variable( n - 8 );
+			ast::PtrExpression lower_bound = to_expression( n - 7, "parse error matching lower bound" );
+			ast::PtrExpression upper_bound = to_expression( n - 6, "parse error matching upper bound" );
+			std::unique_ptr< ast::CppVariable > node_variable = to_cpp_variable( n - 5 );
+			ast::PtrExpression alpha = to_expression( n - 4, "parse error matching alpha value" );
+			ast::PtrExpression beta = to_expression( n - 3, "parse error matching beta value" );
+			ast::PtrExpression score = to_expression( n - 2, "parse error matching score expression" );
+
+			std::string s_it = std::string("__it_") + std::string(cpp_variable->value());
+			std::string s_it_end = std::string("__it_end_") + std::string(cpp_variable->value());
+			std::string s_ply = std::string("__ply_") + std::string(cpp_variable->value());
+			std::string s_order = std::string("__order_") + std::string(cpp_variable->value());
+			auto node_call = [&](std::string_view method, std::vector< ast::PtrExpression >& args) {
+				return std::make_unique< ast::InfixExpression >(
+						std::string("."),
+						ast::PtrExpression(node_variable->clone()),
+						std::make_unique< ast::BuiltinConstraint >(
+							std::make_unique< ast::Identifier >( method, p ),
+							std::string("("), std::string(")"),
+							args,
+							p),
+						p);
+			};
+			auto next_alt = [&]() {
+				return std::make_unique< ast::CppExpression >(
+						std::make_unique< ast::PrefixExpression >(
+							std::string("++"),
+							(order?ast::PtrExpression(std::make_unique< ast::CppVariable >( s_it, p )):ast::PtrExpression(cpp_variable->clone())),
+							p),
+						p);
+			};
+
+			// Create stop condition
+			std::vector< ast::PtrExpression > empty_vector;
+			ast::PtrExpression end_cond;
+			if (order)
+				end_cond = std::make_unique< ast::InfixExpression >(
+						std::string("=="),
+						std::make_unique< ast::CppVariable >( s_it, p ),
+						std::make_unique< ast::CppVariable >( s_it_end, p ),
+						p);
+			else
+				end_cond = std::make_unique< ast::InfixExpression >(
+						std::string(">"),
+						ast::PtrExpression(cpp_variable->clone()),
+						ast::PtrExpression(upper_bound->clone()),
+						p);
+			ast::PtrExpression stop_cond = std::make_unique< ast::InfixExpression >(
+					std::string("||"),
+					node_call("cutoff", empty_vector),
+					std::move(end_cond),
+					p);
+
+			// Create final_status
+			auto final_status = std::make_unique< ast::Literal >( std::string("true"), p );
+
+			// Create on_succeeded_alt and on_failed_alt
+			// With an ordering, the alternative which produces a cutoff is rewarded
+			ast::PtrBody on_succeeded_alt = next_alt();
+			if (order)
+			{
+				std::vector< ast::PtrExpression > reward_args;
+				reward_args.emplace_back( node_call("cutoff", empty_vector) );
+				reward_args.emplace_back( ast::PtrExpression(order->clone()) );
+				reward_args.emplace_back( std::make_unique< ast::PrefixExpression >(
+							std::string("*"),
+							std::make_unique< ast::CppVariable >( s_it, p ),
+							p) );
+				reward_args.emplace_back( std::make_unique< ast::CppVariable >( s_ply, p ) );
+				auto seq = std::make_unique< ast::Sequence >(std::string(","), p);
+				seq->add_child( std::make_unique< ast::CppExpression >(
+							std::make_unique< ast::BuiltinConstraint >(
+								std::make_unique< ast::Identifier >( std::string("chr::order_reward_if"), p ),
+								std::string("("), std::string(")"),
+								reward_args,
+								p),
+							p) );
+				seq->add_child( std::move(on_succeeded_alt) );
+				on_succeeded_alt = std::move(seq);
+			}
+			ast::PtrBody on_failed_alt = next_alt();
+
+			ast::PtrSequence tmp = std::make_unique< ast::Sequence >(std::string(","), p);
+			if (order)
+			{
+				// Ply and sorted values init
+				std::vector< ast::PtrExpression > order_args;
+				order_args.emplace_back( std::move(lower_bound) );
+				order_args.emplace_back( std::move(upper_bound) );
+				order_args.emplace_back( ast::PtrExpression(order->clone()) );
+				order_args.emplace_back( std::make_unique< ast::CppVariable >( s_ply, p ) );
+				tmp->add_child( std::make_unique< ast::CppDeclAssignment >(
+							std::make_unique< ast::CppVariable >( s_ply, p ),
+							std::make_unique< ast::BuiltinConstraint >(
+								std::make_unique< ast::Identifier >( std::string("chr::Backtrack::depth"), p ),
+								std::string("("), std::string(")"),
+								empty_vector,
+								p),
+							p) );
+				tmp->add_child( std::make_unique< ast::CppDeclAssignment >(
+							std::make_unique< ast::CppVariable >( s_order, p ),
+							std::make_unique< ast::BuiltinConstraint >(
+								std::make_unique< ast::Identifier >( std::string("chr::order_values"), p ),
+								std::string("("), std::string(")"),
+								order_args,
+								p),
+							p) );
+				// Iterators init
+				for (auto& [s_var, s_method] : { std::make_pair(s_it, "begin"), std::make_pair(s_it_end, "end") })
+					tmp->add_child( std::make_unique< ast::CppDeclAssignment >(
+								std::make_unique< ast::CppVariable >( s_var, p ),
+								std::make_unique< ast::InfixExpression >(
+									std::string("."),
+									std::make_unique< ast::CppVariable >( s_order, p ),
+									std::make_unique< ast::BuiltinConstraint >(
+										std::make_unique< ast::Identifier >( std::string(s_method), p ),
+										std::string("("), std::string(")"),
+										empty_vector,
+										p),
+									p),
+								p) );
+			} else {
+				// Lower bound init
+				tmp->add_child( std::make_unique< ast::CppDeclAssignment >(
+							std::unique_ptr<ast::CppVariable>( static_cast<ast::CppVariable*>(cpp_variable->clone()) ),
+							std::move(lower_bound),
+							p) );
+			}
+
+			// Node init
+			std::vector< ast::PtrExpression > window;
+			window.emplace_back( std::move(alpha) );
+			window.emplace_back( std::move(beta) );
+			tmp->add_child( std::make_unique< ast::CppDeclAssignment >(
+						std::unique_ptr<ast::CppVariable>( static_cast<ast::CppVariable*>(node_variable->clone()) ),
+						std::make_unique< ast::BuiltinConstraint >(
+							std::make_unique< ast::Identifier >(
+								std::string("chr::") + std::string(name) + std::string("_node"),
+								p),
+							std::string("("), std::string(")"),
+							window,
+							p),
+						p) );
+
+			// Body sequence (preceded by the current value with an ordering)
+			// followed by the update of the node
+			std::vector< ast::PtrExpression > update_args;
+			update_args.emplace_back( std::move(score) );
+			auto body = std::move(body_stack.at( body_stack.size() - 1));
+			auto body_sequence = std::make_unique< ast::Sequence >(std::string(","), p);
+			if (order)
+				body_sequence->add_child( std::make_unique< ast::CppDeclAssignment >(
+							std::unique_ptr<ast::CppVariable>( static_cast<ast::CppVariable*>(cpp_variable->clone()) ),
+							std::make_unique< ast::PrefixExpression >(
+								std::string("*"),
+								std::make_unique< ast::CppVariable >( s_it, p ),
+								p),
+							p) );
+			auto ptr_body = dynamic_cast<ast::Sequence*>( body.get() );
+			if ((ptr_body != nullptr) and (ptr_body->op() == ","))
+			{
+				for (auto& child : ptr_body->children())
+					body_sequence->add_child( std::move(child) );
+			} else
+				body_sequence->add_child( std::move(body) );
+			body_sequence->add_child( std::make_unique< ast::CppExpression >( node_call("update", update_args), p ) );
+
+			// The children are explored in the loop of the behavior itself (no lambda
+			// function per child), the cutoff is checked by the stop condition
+			auto behavior = std::make_unique< ast::ChrBehavior >(
+						std::move( stop_cond ),
+						std::move( on_succeeded_alt ),
+						std::move( on_failed_alt ),
+						std::move( final_status ),
+						std::make_unique< ast::Body >(p),
+						std::make_unique< ast::Body >(p),
+						std::move(body_sequence),
+						p);
+			behavior->set_inline_body(true);
+			tmp->add_child( std::move(behavior) );
+
+			body_stack.resize( body_stack.size() - 7 );
 			body_stack.back() = std::move( tmp );
 		}
 
+		/**
+		 * Function to construct and stack a search chr statement (best_first, astar, mcts, minimize).
+		 * The stack contains the decision variable, the engine, the \a nb_args other
+		 * arguments and the body which applies a decision.
+		 * @param name The name of the search
+		 * @param nb_args The number of arguments between the engine and the body
+		 * @param p The position of element in source
+		 */
+		void search(std::string_view name, std::size_t nb_args, PositionInfo p )
+		{
+			assert( body_stack.size() >= nb_args + 3 );
+			std::size_t n = body_stack.size() - nb_args - 3;
+
+			// Convert first expression to CppVariable
+			cast_identifier_to_var( n );
+			ast::PtrExpression ptr_tmp;
+			try {
+				ast::CppExpression& s = dynamic_cast< ast::CppExpression& >( *body_stack.at( n ) );
+				ptr_tmp.swap(s.expression());
+			} catch (std::bad_cast&) {
+				throw ParseError("parse error matching local variable identifier", body_stack.at( n )->position() );
+			}
+			std::unique_ptr< ast::CppVariable > cpp_variable;
+			try {
+				ast::CppVariable& s = dynamic_cast< ast::CppVariable& >( *ptr_tmp );
+				ptr_tmp.release();
+				cpp_variable.reset(&s);
+			} catch (std::bad_cast&) {
+				throw ParseError("parse error matching local variable identifier", ptr_tmp->position());
+			}
+
+			// Convert the engine and the other arguments to PtrExpression
+			std::vector< ast::PtrExpression > args;
+			for (std::size_t i = n + 1; i < body_stack.size() - 1; ++i)
+			{
+				check_no_chr_statement( body_stack.at( i ), false );
+				ast::PtrExpression e;
+				try {
+					ast::CppExpression& s = dynamic_cast< ast::CppExpression& >( *body_stack.at( i ) );
+					e.swap(s.expression());
+				} catch (std::bad_cast&) {
+					throw ParseError("parse error matching argument of search", body_stack.at( i )->position());
+				}
+				args.emplace_back( std::move(e) );
+			}
+			ast::PtrExpression engine = std::move(args.front());
+			args.erase( args.begin() );
+
+			auto tmp = std::make_unique< ast::ChrSearch >(
+					name,
+					std::move(cpp_variable),
+					std::move(engine),
+					std::move(args),
+					std::move(body_stack.at( body_stack.size() - 1)),
+					p);
+			body_stack.resize( n + 1 );
+			body_stack.back() = std::move( tmp );
+		}
+
+		/**
+		 * Function to construct and stack a minimize chr statement.
+		 * The stack contains the incumbent (the engine), the \a nb_args other
+		 * arguments and the body. The decision variable of the search is not
+		 * used by minimize: a local one is added before the engine.
+		 * @param nb_args The number of arguments between the incumbent and the body
+		 * @param p The position of element in source
+		 */
+		void minimize(std::size_t nb_args, PositionInfo p )
+		{
+			assert( body_stack.size() >= nb_args + 2 );
+			std::size_t n = body_stack.size() - nb_args - 2;
+			body_stack.insert( body_stack.begin() + n, std::make_unique< ast::CppExpression >(
+					std::make_unique< ast::CppVariable >("minimize_decision_", p),
+					p) );
+			search( "minimize", nb_args, p );
+		}
+
 		/**
 		 * Function to convert a body reduced to an identifier
 		 * to a variable (CppVariable or LogicalVariable)
@@ -733,6 +1407,8 @@ namespace chr::compiler::parser::ast_builder
 
 		std::string last_op;					///< The last operator used
 		std::vector< ast::PtrBody > body_stack;	///< The stack of body parts
+		std::vector< std::size_t > order_by_positions;	///< Positions in stack of the order_by scoring functions
+		std::vector< std::size_t > symmetric_positions;	///< Positions in stack of the symmetric functions
 
 		std::vector< ast::PtrSharedChrConstraintDecl >& chr_constraints;	///< Reference to the recorded CHR constraints
 	};
@@ -19,6 +19,8 @@
  *
  */
 
+#include <optional>
+#include <utility>
 #include <vector>
 #include <string>
 #include <ast/program.hh>
@@ -58,6 +60,32 @@ namespace chr::compiler::parser::ast_builder
 			prg.chr_constraints().at( prg.chr_constraints().size() - 1)->_c->add_pragma(p);
 		}
 
+		/**
+		 * Function to add the pragma dense, with the ranges parsed in
+		 * _dense_ranges, to the last CHR constraint declared. Each
+		 * parameter has a range (or none) and only the ground parameters
+		 * can have one.
+		 * @param pos The position of the pragma
+		 */
+		void add_chr_constraint_dense_ranges(const PositionInfo& pos)
+		{
+			assert(prg.chr_constraints().size() > 0);
+			auto& decl = prg.chr_constraints().at( prg.chr_constraints().size() - 1);
+			auto ranges = std::move(_dense_ranges);
+			_dense_ranges.clear();
+			auto& args = decl->_c->constraint()->children();
+			if (ranges.size() != args.size())
+				throw ParseError("parse error, pragma dense must give a range (or _) for each parameter of the constraint", pos);
+			for (std::size_t i = 0; i < args.size(); ++i)
+			{
+				auto pt = dynamic_cast< ast::UnaryExpression* >( args[i].get() );
+				if (ranges[i] && ((pt == nullptr) || (pt->op() != "+")))
+					throw ParseError("parse error, pragma dense can only give a range to a ground (+) parameter", pos);
+			}
+			decl->_dense_ranges = std::move(ranges);
+			decl->_c->add_pragma(Pragma::dense);
+		}
+
 		/**
 		 * Function to add a new rule to the program.
 		 * @param r The rule to add
@@ -72,6 +100,7 @@ namespace chr::compiler::parser::ast_builder
 		bool _empty = true;					///< True if no real CHR program has been matched
 		ast::ChrProgram prg;				///< The CHR program
 		std::string _include_file_name;		///< File name of last chr_include
+		std::vector< std::optional< std::pair< long long, long long > > > _dense_ranges;	///< Ranges of the pragma dense being parsed
 		std::string _str_dependency_graph;	///< String representation of the dependency graph (for debbuging purposes)
 	};
 } // namespace chr::compiler::parser::ast_builder
@@ -129,6 +129,43 @@ namespace chr::compiler::parser::grammar::body
 				chr_behavior_opt_arg<Literal, Identifier>,
 				star<ignored>, internal::constraint_call_sequence<Literal,Identifier>, star<ignored>, one<')'> >, TAO_PEGTL_NAMESPACE::raise< chr_behavior_error > > > {};
 
+	// ---------------------------------------------------------------------------
+	// Parse nogood
+	template< typename Literal, typename Identifier >
+	struct chr_nogood
+		: seq< TAO_PEGTL_KEYWORD("nogood"), sor< seq< one<'('>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, internal::constraint_call_sequence<Literal,Identifier>, star<ignored>, one<')'> >, TAO_PEGTL_NAMESPACE::raise< chr_behavior_error > > > {};
+
+	// ---------------------------------------------------------------------------
+	// Parse restart
+	template< typename Literal, typename Identifier >
+	struct chr_restart
+		: seq< TAO_PEGTL_KEYWORD("restart"), sor< seq< one<'('>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, internal::constraint_call_sequence<Literal,Identifier>, star<ignored>, one<')'> >, TAO_PEGTL_NAMESPACE::raise< chr_behavior_error > > > {};
+
+	// ---------------------------------------------------------------------------
+	// Parse order_by clause (optional argument before the body of exists, forall,
+	// exists_it and forall_it)
+	template< typename Literal, typename Identifier >
+	struct chr_order_by
+		: seq< TAO_PEGTL_KEYWORD("order_by"), star<ignored>, one<'('>, star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<')'> > {};
+	template< typename Literal, typename Identifier >
+	struct chr_order_by_opt
+		: opt< star<ignored>, chr_order_by<Literal,Identifier>, star<ignored>, one<','> > {};
+
+	// ---------------------------------------------------------------------------
+	// Parse symmetric clause (optional argument before the body of exists, forall,
+	// exists_it and forall_it, after the order_by clause)
+	template< typename Literal, typename Identifier >
+	struct chr_symmetric
+		: seq< TAO_PEGTL_KEYWORD("symmetric"), star<ignored>, one<'('>, star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<')'> > {};
+	template< typename Literal, typename Identifier >
+	struct chr_symmetric_opt
+		: opt< star<ignored>, chr_symmetric<Literal,Identifier>, star<ignored>, one<','> > {};
+
 	// ---------------------------------------------------------------------------
 	// Parse exists
 	template< typename Literal, typename Identifier >
@@ -137,6 +174,8 @@ namespace chr::compiler::parser::grammar::body
 				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
 				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
 				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				chr_order_by_opt<Literal,Identifier>,
+				chr_symmetric_opt<Literal,Identifier>,
 				star<ignored>, internal::constraint_call_sequence<Literal,Identifier>, star<ignored>, one<')'> >, TAO_PEGTL_NAMESPACE::raise< chr_behavior_error > > > {};
 
 	// ---------------------------------------------------------------------------
@@ -146,6 +185,8 @@ namespace chr::compiler::parser::grammar::body
 		: seq< TAO_PEGTL_STRING("exists_it"), sor< seq< one<'('>,
 				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
 				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				chr_order_by_opt<Literal,Identifier>,
+				chr_symmetric_opt<Literal,Identifier>,
 				star<ignored>, internal::constraint_call_sequence<Literal,Identifier>, star<ignored>, one<')'> >, TAO_PEGTL_NAMESPACE::raise< chr_behavior_error > > > {};
 
 	// ---------------------------------------------------------------------------
@@ -156,6 +197,8 @@ namespace chr::compiler::parser::grammar::body
 				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
 				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
 				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				chr_order_by_opt<Literal,Identifier>,
+				chr_symmetric_opt<Literal,Identifier>,
 				star<ignored>, internal::constraint_call_sequence<Literal,Identifier>, star<ignored>, one<')'> >, TAO_PEGTL_NAMESPACE::raise< chr_behavior_error > > > {};
 
 	// ---------------------------------------------------------------------------
@@ -163,6 +206,79 @@ namespace chr::compiler::parser::grammar::body
 	template< typename Literal, typename Identifier >
 	struct chr_forall_it
 		: seq< TAO_PEGTL_STRING("forall_it"), sor< seq< one<'('>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				chr_order_by_opt<Literal,Identifier>,
+				chr_symmetric_opt<Literal,Identifier>,
+				star<ignored>, internal::constraint_call_sequence<Literal,Identifier>, star<ignored>, one<')'> >, TAO_PEGTL_NAMESPACE::raise< chr_behavior_error > > > {};
+
+	// ---------------------------------------------------------------------------
+	// Parse alphabeta_max, alphabeta_min, negamax and expectation
+	template< typename Literal, typename Identifier, typename Name >
+	struct chr_alphabeta_statement
+		: seq< Name, sor< seq< one<'('>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				chr_order_by_opt<Literal,Identifier>,
+				star<ignored>, internal::constraint_call_sequence<Literal,Identifier>, star<ignored>, one<')'> >, TAO_PEGTL_NAMESPACE::raise< chr_behavior_error > > > {};
+	template< typename Literal, typename Identifier >
+	struct chr_alphabeta_max
+		: chr_alphabeta_statement< Literal, Identifier, TAO_PEGTL_KEYWORD("alphabeta_max") > {};
+	template< typename Literal, typename Identifier >
+	struct chr_alphabeta_min
+		: chr_alphabeta_statement< Literal, Identifier, TAO_PEGTL_KEYWORD("alphabeta_min") > {};
+	template< typename Literal, typename Identifier >
+	struct chr_negamax
+		: chr_alphabeta_statement< Literal, Identifier, TAO_PEGTL_KEYWORD("negamax") > {};
+	template< typename Literal, typename Identifier >
+	struct chr_expectation
+		: chr_alphabeta_statement< Literal, Identifier, TAO_PEGTL_KEYWORD("expectation") > {};
+
+	// ---------------------------------------------------------------------------
+	// Parse best_first and astar
+	template< typename Literal, typename Identifier >
+	struct chr_best_first
+		: seq< TAO_PEGTL_KEYWORD("best_first"), sor< seq< one<'('>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, internal::constraint_call_sequence<Literal,Identifier>, star<ignored>, one<')'> >, TAO_PEGTL_NAMESPACE::raise< chr_behavior_error > > > {};
+	template< typename Literal, typename Identifier >
+	struct chr_astar
+		: seq< TAO_PEGTL_KEYWORD("astar"), sor< seq< one<'('>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, internal::constraint_call_sequence<Literal,Identifier>, star<ignored>, one<')'> >, TAO_PEGTL_NAMESPACE::raise< chr_behavior_error > > > {};
+
+	// ---------------------------------------------------------------------------
+	// Parse mcts
+	template< typename Literal, typename Identifier >
+	struct chr_mcts
+		: seq< TAO_PEGTL_KEYWORD("mcts"), sor< seq< one<'('>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
+				star<ignored>, internal::constraint_call_sequence<Literal,Identifier>, star<ignored>, one<')'> >, TAO_PEGTL_NAMESPACE::raise< chr_behavior_error > > > {};
+
+	// ---------------------------------------------------------------------------
+	// Parse minimize
+	template< typename Literal, typename Identifier >
+	struct chr_minimize
+		: seq< TAO_PEGTL_KEYWORD("minimize"), sor< seq< one<'('>,
+				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
 				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
 				star<ignored>, cpp_expression<Literal,Identifier>, star<ignored>, one<','>,
 				star<ignored>, internal::constraint_call_sequence<Literal,Identifier>, star<ignored>, one<')'> >, TAO_PEGTL_NAMESPACE::raise< chr_behavior_error > > > {};
@@ -171,7 +287,7 @@ namespace chr::compiler::parser::grammar::body
 	// Parse constraint call
 	template< typename Literal, typename Identifier >
 	struct chr_reserved_constraint
-		: sor< chr_try_bt<Literal,Identifier>, chr_try<Literal,Identifier>, chr_behavior<Literal,Identifier>, chr_exists_it<Literal,Identifier>, chr_exists<Literal,Identifier>, chr_forall_it<Literal,Identifier>, chr_forall<Literal,Identifier> > {};
+		: sor< chr_try_bt<Literal,Identifier>, chr_try<Literal,Identifier>, chr_behavior<Literal,Identifier>, chr_exists_it<Literal,Identifier>, chr_exists<Literal,Identifier>, chr_forall_it<Literal,Identifier>, chr_forall<Literal,Identifier>, chr_alphabeta_max<Literal,Identifier>, chr_alphabeta_min<Literal,Identifier>, chr_negamax<Literal,Identifier>, chr_expectation<Literal,Identifier>, chr_best_first<Literal,Identifier>, chr_astar<Literal,Identifier>, chr_nogood<Literal,Identifier>, chr_restart<Literal,Identifier>, chr_mcts<Literal,Identifier>, chr_minimize<Literal,Identifier> > {};
 
 	template< typename Literal, typename Identifier >
 	struct constraint_call
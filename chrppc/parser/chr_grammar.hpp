@@ -207,8 +207,16 @@ namespace chr::compiler::parser::grammar
 
 	// ---------------------------------------------------------------------------
 	// Parse CHR constraint decl pragmas
+	struct constraint_decl_dense_bound
+			: seq< opt< one< '-' > >, plus< digit > > {};
+	struct constraint_decl_dense_range
+			: seq< constraint_decl_dense_bound, star<ignored>, two< '.' >, star<ignored>, constraint_decl_dense_bound > {};
+	struct constraint_decl_dense_no_range
+			: one< '_' > {};
+	struct constraint_decl_pragma_dense
+			: seq< TAO_PEGTL_KEYWORD("dense"), star<ignored>, one< '(' >, star<ignored>, list< sor< constraint_decl_dense_range, constraint_decl_dense_no_range >, one< ',' >, ignored >, star<ignored>, one< ')' > > {};
 	struct constraint_decl_pragma_value
-			: sor< TAO_PEGTL_KEYWORD("no_reactivate"), TAO_PEGTL_KEYWORD("persistent") > {};
+			: sor< TAO_PEGTL_KEYWORD("no_reactivate"), TAO_PEGTL_KEYWORD("persistent"), constraint_decl_pragma_dense > {};
 	struct constraint_decl_pragma_list
 			: seq< one< '{' > , star<ignored>, list< constraint_decl_pragma_value, one< ',' >, ignored >, star<ignored>, one< '}' > > {};
 	struct constraint_decl_pragma_values
@@ -21,7 +21,7 @@
 
 #pragma once
 
-const std::array< std::string, 12> CHR_KEYWORDS {{
+const std::array< std::string, 24> CHR_KEYWORDS {{
 	"failure",
 	"success",
 	"stop",
@@ -33,7 +33,19 @@ const std::array< std::string, 12> CHR_KEYWORDS {{
 	"exists",
 	"forall_it",
 	"forall",
-	"behavior"
+	"behavior",
+	"alphabeta_max",
+	"alphabeta_min",
+	"negamax",
+	"expectation",
+	"order_by",
+	"symmetric",
+	"best_first",
+	"astar",
+	"nogood",
+	"restart",
+	"mcts",
+	"minimize"
 }};
 
 const std::array< std::string, 95> CPP_KEYWORDS {{
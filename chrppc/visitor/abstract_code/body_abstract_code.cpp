@@ -258,4 +258,18 @@ namespace chr::compiler::visitor
 		_os << prefix() << "End try" << (t.do_backtrack()?"_bt":"");
 	}
 
+	void BodyAbstractCode::visit(ast::ChrSearch& s)
+	{
+		chr::compiler::visitor::ExpressionPrint v;
+		_os << prefix() << "Search " << s.name() << " with " << v.string_from( *s.engine() ) << "\n";
+		++_depth;
+		_os << prefix() << "Apply decision " << v.string_from( *s.variable() ) << "\n";
+		++_depth;
+		s.body()->accept(*this);
+		_os << "\n";
+		--_depth;
+		_os << prefix() << "End apply\n";
+		--_depth;
+		_os << prefix() << "End search";
+	}
 }
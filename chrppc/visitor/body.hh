@@ -50,6 +50,7 @@ namespace chr::compiler::visitor
 		virtual void visit(ast::Sequence&) = 0;
 		virtual void visit(ast::ChrBehavior&) = 0;
 		virtual void visit(ast::ChrTry&) = 0;
+		virtual void visit(ast::ChrSearch&) = 0;
 
 		/**
 		 * Default virtual destructor
@@ -78,6 +79,7 @@ namespace chr::compiler::visitor
 		void visit(ast::Sequence& s) final;
 		void visit(ast::ChrBehavior& b) final;
 		void visit(ast::ChrTry& b) final;
+		void visit(ast::ChrSearch& s) final;
 
 		std::vector< std::string > string_stack;	///< The result string which contains the convertion of a body tree to a string
 	};
@@ -108,6 +110,7 @@ namespace chr::compiler::visitor
 		void visit(ast::Sequence& s) final;
 		void visit(ast::ChrBehavior& b) final;
 		void visit(ast::ChrTry& b) final;
+		void visit(ast::ChrSearch& s) final;
 
 		std::size_t _prefix_w = 0;	///< Prefix for width alignment
 		std::size_t _depth = 0;		///< Recursive depth
@@ -137,6 +140,7 @@ namespace chr::compiler::visitor
 		void visit(ast::Sequence& s) final;
 		void visit(ast::ChrBehavior& b) final;
 		void visit(ast::ChrTry& b) final;
+		void visit(ast::ChrSearch& s) final;
 
 		bool res; ///< The result value
 	};
@@ -166,6 +170,7 @@ namespace chr::compiler::visitor
 		void visit(ast::Sequence& s) final;
 		void visit(ast::ChrBehavior& b) final;
 		void visit(ast::ChrTry& b) final;
+		void visit(ast::ChrSearch& s) final;
 
 		std::function< bool (ast::Body&) > _f;	///< The lambda to apply
 	};
@@ -197,6 +202,7 @@ namespace chr::compiler::visitor
 		void visit(ast::Sequence& s) final;
 		void visit(ast::ChrBehavior& b) final;
 		void visit(ast::ChrTry& b) final;
+		void visit(ast::ChrSearch& s) final;
 
 		std::function< bool (ast::Body&) > _f;				///< The lambda to apply on body
 		std::function< bool (ast::Expression&) > _f_expr;	///< The lambda to apply on expression
@@ -245,6 +251,7 @@ namespace chr::compiler::visitor
 		virtual void visit(ast::Sequence& s);
 		virtual void visit(ast::ChrBehavior& b);
 		virtual void visit(ast::ChrTry& b);
+		virtual void visit(ast::ChrSearch& s);
 
 		/**
 		 * Remove spaces at the beginning of string \a s.
@@ -293,6 +300,7 @@ namespace chr::compiler::visitor
 		void visit(ast::Sequence& s) override final;
 		void visit(ast::ChrBehavior& b) override final;
 		void visit(ast::ChrTry& b) override final;
+		void visit(ast::ChrSearch& s) override final;
 	
 	private:
 		/**
@@ -311,6 +319,26 @@ namespace chr::compiler::visitor
 		template< typename... T >
 		void write_trace_statement(const char* flag, const std::tuple< T... >& args);
 
+		/**
+		 * Generates the code which lets a chr::Fiber suspend the CHR program
+		 * at a choice point (only if suspend points are enabled).
+		 */
+		void write_suspend_point();
+
+		/**
+		 * Generates the tests which stop the CHR program at a choice point
+		 * (only the enabled ones, see chr::Cancellation and chr::Bound).
+		 * @param exit The statement which leaves the choice point
+		 */
+		void write_choice_point_tests(std::string_view exit);
+
+		/**
+		 * Generates the code which counts a failed alternative of a choice point
+		 * against the failure limit (only if cancellation points are enabled).
+		 * @param check_status True if the alternative may have succeeded (its status is checked)
+		 */
+		void write_failed_alternative(bool check_status = false);
+
 		/**
 		 * Generate the imperative code in order to declare all undeclared logical
 		 * variables of expression \a e0.
@@ -325,8 +353,20 @@ namespace chr::compiler::visitor
 		 */
 		void declare_undeclared_logical_variable(ast::Body& b0);
 
+		/**
+		 * Return the statement which leaves the current alternative with status
+		 * \a status: a return statement, or a jump to the end of the behavior body
+		 * being generated inline (see ast::ChrBehavior::inline_body()).
+		 * @param status The status of the alternative
+		 * @return The statement
+		 */
+		std::string exit_statement(std::string_view status) const;
+
 		std::string _input_file_name;	///< Name of the file used to built this rule
 		std::string _trace_prefix;		///< Prefix for writing trace statements
 		bool _auto_catch_failure;		///< True if CHR program must try to automatically catch failure, false otherwise
+		std::string _exit_label;		///< Label at the end of the behavior body generated inline (empty if the current alternative is a lambda function)
+		std::string _exit_status;		///< Status variable of the behavior body generated inline
+		static inline std::size_t _nb_inline_bodies = 0;	///< Number of behavior bodies generated inline (labels are unique in a function)
 	};
 }
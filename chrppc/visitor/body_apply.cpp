@@ -80,4 +80,8 @@ namespace chr::compiler::visitor
 		if (_f(t)) t.body()->accept(*this);
 	}
 
+	void BodyApply::visit(ast::ChrSearch& s)
+	{
+		if (_f(s)) s.body()->accept(*this);
+	}
 }
@@ -73,4 +73,9 @@ namespace chr::compiler::visitor
 	{
 		res = false;
 	}
+
+	void BodyEmpty::visit(ast::ChrSearch&)
+	{
+		res = false;
+	}
 }
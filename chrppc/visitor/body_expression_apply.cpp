@@ -102,4 +102,14 @@ namespace chr::compiler::visitor
 		t.body()->accept(*this);
 	}
 
+	void BodyExpressionApply::visit(ast::ChrSearch& s)
+	{
+		if (!_f(s)) return;
+		visitor::ExpressionApply eav;
+		eav.apply(*s.variable(), _f_expr);
+		eav.apply(*s.engine(), _f_expr);
+		for (auto& a : s.args())
+			eav.apply(*a, _f_expr);
+		s.body()->accept(*this);
+	}
 }
@@ -169,4 +169,23 @@ namespace chr::compiler::visitor
 		str += prefix() + ") )";
 		string_stack.back() = std::move(str);
 	}
+
+	void BodyFullPrint::visit(ast::ChrSearch& s)
+	{
+		++_depth;
+		s.body()->accept(*this);
+		--_depth;
+		auto str = std::string( prefix() + std::string(s.name()) + "( ");
+
+		chr::compiler::visitor::ExpressionPrint v;
+		str += std::string(v.string_from( *s.variable() )) + ", ";
+		str += std::string(v.string_from( *s.engine() ));
+		for (auto& a : s.args())
+			str += ", " + std::string(v.string_from( *a ));
+
+		str += ", (\n";
+		str += *(string_stack.end() - 1) + "\n";
+		str += prefix() + ") )";
+		string_stack.back() = std::move(str);
+	}
 }
@@ -153,4 +153,18 @@ namespace chr::compiler::visitor
 		string_stack.back() = std::move(str);
 	}
 
+	void BodyPrint::visit(ast::ChrSearch& s)
+	{
+		s.body()->accept(*this);
+		auto str = std::string(s.name()) + "( ";
+
+		chr::compiler::visitor::ExpressionPrint v;
+		str += std::string(v.string_from( *s.variable() )) + ", ";
+		str += std::string(v.string_from( *s.engine() )) + ", ";
+		for (auto& a : s.args())
+			str += std::string(v.string_from( *a )) + ", ";
+		str += *(string_stack.end() - 1);
+		str += ")";
+		string_stack.back() = std::move(str);
+	}
 }
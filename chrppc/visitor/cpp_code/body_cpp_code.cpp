@@ -49,6 +49,40 @@ namespace chr::compiler::visitor
 		}
 	}
 
+	void BodyCppCode::write_suspend_point()
+	{
+		if (chr::compiler::Compiler_options::SUSPEND_POINTS)
+			_os << prefix() << "chr::Fiber::choice_point();\n";
+	}
+
+	void BodyCppCode::write_choice_point_tests(std::string_view exit)
+	{
+		if (chr::compiler::Compiler_options::CANCELLATION_POINTS)
+			_os << prefix() << "if (chr::Cancellation::requested()) " << exit << "\n";
+		if (chr::compiler::Compiler_options::BOUND_PRUNING)
+			_os << prefix() << "if (chr::Bound::prune()) " << exit << "\n";
+	}
+
+	void BodyCppCode::write_failed_alternative(bool check_status)
+	{
+		if (chr::compiler::Compiler_options::CANCELLATION_POINTS)
+		{
+			if (check_status)
+				_os << prefix() << "if (chr::failed()) chr::Cancellation::count_failure();\n";
+			else
+				_os << prefix() << "chr::Cancellation::count_failure();\n";
+		}
+	}
+
+	std::string BodyCppCode::exit_statement(std::string_view status) const
+	{
+		if (_exit_label.empty())
+			return "return " + std::string(status);
+		if (status == "chr::ES_CHR::FAILURE")
+			return "goto " + _exit_label;
+		return "{ " + _exit_status + " = " + std::string(status) + "; goto " + _exit_label + "; }";
+	}
+
 	void BodyCppCode::declare_undeclared_logical_variable(ast::Expression& e0)
 	{
 		chr::compiler::visitor::ExpressionCppCode v;
@@ -97,8 +131,8 @@ namespace chr::compiler::visitor
 
 		if (k.name() != "success")
 		{
-			if (k.name() == "failure") _os << prefix() << "return chr::failure();";
-			else if (k.name() == "stop") _os << prefix() << "return chr::ES_CHR::SUCCESS; // stop builtinconstraint";
+			if (k.name() == "failure") _os << prefix() << exit_statement("chr::failure()") << ";";
+			else if (k.name() == "stop") _os << prefix() << exit_statement("chr::ES_CHR::SUCCESS") << "; // stop builtinconstraint";
 			else _os << prefix() << k.name();
 		}
 	}
@@ -114,9 +148,11 @@ namespace chr::compiler::visitor
 		if (std::find(pragmas.begin(), pragmas.end(), Pragma::catch_failure) != pragmas.end())
 		{
 			_os << prefix() << "if ((" << v.string_from( *e.expression() );
-			_os << ") == chr::ES_CHR::FAILURE) return chr::ES_CHR::FAILURE;";
+			_os << ") == chr::ES_CHR::FAILURE) " << exit_statement("chr::ES_CHR::FAILURE") << ";";
 		} else {
-			if (_auto_catch_failure)
+			if (_auto_catch_failure && !_exit_label.empty())
+				_os << prefix() << "CHECK_ES_GOTO( " << _exit_label << ", " << v.string_from( *e.expression() ) << " );";
+			else if (_auto_catch_failure)
 				_os << prefix() << "CHECK_ES( " << v.string_from( *e.expression() ) << " );";
 			else
 				_os << prefix() << v.string_from( *e.expression() ) << ";";
@@ -160,7 +196,7 @@ namespace chr::compiler::visitor
 		}
 		_os << v_name << " = " << v.string_from( *a.expression() );
 		if (catch_f)
-			_os << ") == chr::ES_CHR::FAILURE) return chr::ES_CHR::FAILURE"; 
+			_os << ") == chr::ES_CHR::FAILURE) " << exit_statement("chr::ES_CHR::FAILURE");
 		_os << ";";
 	}
 
@@ -182,7 +218,7 @@ namespace chr::compiler::visitor
 		_os << " %= ";
 		_os << v.string_from( *a.expression() );
 		if (catch_f)
-			_os << ") == chr::ES_CHR::FAILURE) return chr::ES_CHR::FAILURE";
+			_os << ") == chr::ES_CHR::FAILURE) " << exit_statement("chr::ES_CHR::FAILURE");
 		_os << ";";
 	}
 
@@ -223,7 +259,7 @@ namespace chr::compiler::visitor
 			_os << prefix() << "goto " << c_name << "_call;\n";
 		} else {
 			_os << prefix() << "if (chr::ES_CHR::FAILURE == ";
-			_os << v.string_from( *c.constraint() ) << ") return chr::ES_CHR::FAILURE;";
+			_os << v.string_from( *c.constraint() ) << ") " << exit_statement("chr::ES_CHR::FAILURE") << ";";
 		}
 	}
 
@@ -254,12 +290,20 @@ namespace chr::compiler::visitor
 				{
 					_os << prefix() << "unsigned int depth" << id << " = chr::Backtrack::depth();\n";
 					_os << prefix() << "chr::Statistics::open_choice();\n";
+					if (chr::compiler::Compiler_options::BACKJUMPING)
+						_os << prefix() << "chr::Backjump::open(depth" << id << ");\n";
+					if (s.search_limited())
+						_os << prefix() << "unsigned long spent" << id << " = chr::Search_limit::spent();\n";
 					write_trace_statement("BACKTRACK",std::make_tuple(R"_STR("Create new node at depth ")_STR","chr::Backtrack::depth()+1"));
 					_os << prefix() << "auto _try_or_" << id << "_" << i << " = [&]() {\n";
 					++_depth;
 					_os << prefix() << "chr::Backtrack::inc_backtrack_depth();\n";
+					write_suspend_point();
+					write_choice_point_tests("return chr::failure();");
 					write_trace_statement("BACKTRACK",std::make_tuple(R"_STR("Try alternative 0 at depth ")_STR","chr::Backtrack::depth()"));
+					std::string exit_label = std::exchange(_exit_label, std::string());
 					s.children()[i]->accept(*this);
+					_exit_label = std::move(exit_label);
 					_os << "\n";
 					_os << prefix() << "return chr::ES_CHR::SUCCESS;\n";
 					--_depth;
@@ -269,15 +313,24 @@ namespace chr::compiler::visitor
 					_context = context_backup;
 					_os << prefix() << "if (_try_or_" << id << "_" << i-1 <<"() == chr::ES_CHR::FAILURE) {\n";
 					++_depth;
+					write_failed_alternative();
+					if (chr::compiler::Compiler_options::BACKJUMPING)
+						_os << prefix() << "if (chr::Backjump::jump(depth" << id << ")) " << exit_statement("chr::Backjump::leave(depth" + std::to_string(id) + ")") << ";\n";
 					_os << prefix() << "chr::reset();\n";
 					_os << prefix() << "chr::Backtrack::back_to(depth" << id << ");\n";
 					_os << prefix() << "auto _try_or_" << id << "_" << i << " = [&]() {\n";
 					++_depth;
 					_os << prefix() << "chr::Backtrack::inc_backtrack_depth();\n";
+					write_suspend_point();
+					write_choice_point_tests("return chr::failure();");
+					if (s.search_limited())
+						_os << prefix() << "if (!chr::Search_limit::allow(spent" << id << ", " << i << ")) return chr::failure();\n";
 					write_trace_statement("BACKTRACK",std::make_tuple(R"_STR("Try alternative )_STR"+std::to_string(i)+R"_STR( at depth ")_STR","chr::Backtrack::depth()"));
 					if (cur_last_statement && (i == args-1))
 						_last_statement = true;
+					std::string exit_label = std::exchange(_exit_label, std::string());
 					s.children()[i]->accept(*this);
+					_exit_label = std::move(exit_label);
 					_os << "\n";
 					_os << prefix() << "return chr::ES_CHR::SUCCESS;\n";
 					--_depth;
@@ -289,9 +342,16 @@ namespace chr::compiler::visitor
 					_context = context_backup;
 					_os << prefix() << "if (_try_or_" << id << "_" << i-1 <<"() == chr::ES_CHR::FAILURE) {\n";
 					++_depth;
+					write_failed_alternative();
+					if (chr::compiler::Compiler_options::BACKJUMPING)
+						_os << prefix() << "if (chr::Backjump::jump(depth" << id << ")) " << exit_statement("chr::Backjump::leave(depth" + std::to_string(id) + ")") << ";\n";
 					_os << prefix() << "chr::reset();\n";
 					_os << prefix() << "chr::Backtrack::back_to(depth" << id << ");\n";
 					_os << prefix() << "chr::Backtrack::inc_backtrack_depth();\n";
+					write_suspend_point();
+					write_choice_point_tests(exit_statement("chr::failure()") + ";");
+					if (s.search_limited())
+						_os << prefix() << "if (!chr::Search_limit::allow(spent" << id << ", " << i << ")) " << exit_statement("chr::failure()") << ";\n";
 					write_trace_statement("BACKTRACK",std::make_tuple(R"_STR("Try alternative )_STR"+std::to_string(i)+R"_STR( at depth ")_STR","chr::Backtrack::depth()"));
 					s.children()[i]->accept(*this);
 					_os << "\n";
@@ -326,39 +386,95 @@ namespace chr::compiler::visitor
 		_os << prefix() << "unsigned int depth" << id << " = chr::Backtrack::depth();\n";
 		write_trace_statement("BACKTRACK",std::make_tuple(R"_STR("Create new node at depth ")_STR","chr::Backtrack::depth()+1"));
 		_os << prefix() << "chr::Statistics::open_choice();\n";
+		if (chr::compiler::Compiler_options::BACKJUMPING)
+		{
+			_os << prefix() << "chr::Backjump::open(depth" << id << ");\n";
+			_os << prefix() << "bool _skip_beha_" << id << "_ = false;\n";
+		}
+		_os << prefix() << "bool _stop_beha_" << id << "_ = false;\n";
 		_os << prefix() << "while (!" << ltrim(v.string_from( *b.stop_cond() )) << ") {\n";
 		++_depth;
+		write_failed_alternative(true);
 		_os << prefix() << "chr::reset();\n";
 		_os << prefix() << "if (depth" << id << " != chr::Backtrack::depth()) chr::Backtrack::back_to(depth" << id << ");\n";
 		_os << prefix() << "chr::Backtrack::inc_backtrack_depth();\n";
-		_os << prefix() << "auto _try_beha_" << id << "_ = [&]() {\n";
-		++_depth;
-		write_trace_statement("BACKTRACK",std::make_tuple(R"_STR("Try alternative at depth ")_STR","chr::Backtrack::depth()"));
-		b.behavior_body()->accept(*this);
-		_os << "\n";
-		_os << prefix() << "return chr::ES_CHR::SUCCESS;\n";
-		--_depth;
-		_os << prefix() << "};\n";
+		write_suspend_point();
+		write_choice_point_tests("{ _stop_beha_" + std::to_string(id) + "_ = true; break; }");
+		std::string status = "_try_beha_" + std::to_string(id) + "_()";
+		if (b.inline_body())
+		{
+			// The body is generated in the loop, a failure jumps to the end of the body
+			status = "_status_beha_" + std::to_string(id) + "_";
+			std::string exit_label = std::exchange(_exit_label, "_end_beha_" + std::to_string(_nb_inline_bodies++) + "_");
+			std::string exit_status = std::exchange(_exit_status, status);
+			_os << prefix() << "chr::ES_CHR " << status << " = chr::ES_CHR::FAILURE;\n";
+			if (chr::compiler::Compiler_options::BACKJUMPING)
+			{
+				// The alternatives are skipped after a back-jump, the status is kept
+				_os << prefix() << "if (!_skip_beha_" << id << "_) {\n";
+				++_depth;
+			}
+			_os << prefix() << "{\n";
+			++_depth;
+			write_trace_statement("BACKTRACK",std::make_tuple(R"_STR("Try alternative at depth ")_STR","chr::Backtrack::depth()"));
+			b.behavior_body()->accept(*this);
+			_os << "\n";
+			_os << prefix() << status << " = chr::ES_CHR::SUCCESS;\n";
+			--_depth;
+			_os << prefix() << "}\n";
+			_os << prefix() << _exit_label << ": ;\n";
+			if (chr::compiler::Compiler_options::BACKJUMPING)
+			{
+				_os << prefix() << "_skip_beha_" << id << "_ = chr::Backjump::jump(depth" << id << ", " << status << ");\n";
+				--_depth;
+				_os << prefix() << "}\n";
+			}
+			_exit_label = std::move(exit_label);
+			_exit_status = std::move(exit_status);
+		} else {
+			_os << prefix() << "auto _try_beha_" << id << "_ = [&]() {\n";
+			++_depth;
+			write_trace_statement("BACKTRACK",std::make_tuple(R"_STR("Try alternative at depth ")_STR","chr::Backtrack::depth()"));
+			std::string exit_label = std::exchange(_exit_label, std::string());
+			b.behavior_body()->accept(*this);
+			_exit_label = std::move(exit_label);
+			_os << "\n";
+			_os << prefix() << "return chr::ES_CHR::SUCCESS;\n";
+			--_depth;
+			_os << prefix() << "};\n";
+		}
 
 		if (!vbe.is_empty(*b.on_succeeded_alt()) || !vbe.is_empty(*b.on_failed_alt()))
 		{
+			if (chr::compiler::Compiler_options::BACKJUMPING && !b.inline_body())
+			{
+				// The alternatives are skipped after a back-jump, the status is kept
+				status = "_status_beha_" + std::to_string(id) + "_";
+				_os << prefix() << "chr::ES_CHR " << status << " = chr::ES_CHR::FAILURE;\n";
+				_os << prefix() << "if (!_skip_beha_" << id << "_) {\n";
+				++_depth;
+				_os << prefix() << status << " = _try_beha_" << id << "_();\n";
+				_os << prefix() << "_skip_beha_" << id << "_ = chr::Backjump::jump(depth" << id << ", " << status << ");\n";
+				--_depth;
+				_os << prefix() << "}\n";
+			}
 			if (vbe.is_empty(*b.on_succeeded_alt()))
 			{
-				_os << prefix() << "if (_try_beha_" << id << "_() != chr::ES_CHR::SUCCESS) {\n";
+				_os << prefix() << "if (" << status << " != chr::ES_CHR::SUCCESS) {\n";
 				++_depth;
 				b.on_failed_alt()->accept(*this);
 				_os << "\n";
 				--_depth;
 				_os << prefix() << "}\n";
 			} else if (vbe.is_empty(*b.on_failed_alt())) {
-				_os << prefix() << "if (_try_beha_" << id << "_() == chr::ES_CHR::SUCCESS) {\n";
+				_os << prefix() << "if (" << status << " == chr::ES_CHR::SUCCESS) {\n";
 				++_depth;
 				b.on_succeeded_alt()->accept(*this);
 				_os << "\n";
 				--_depth;
 				_os << prefix() << "}\n";
 			} else {
-				_os << prefix() << "if (_try_beha_" << id << "_() == chr::ES_CHR::SUCCESS) {\n";
+				_os << prefix() << "if (" << status << " == chr::ES_CHR::SUCCESS) {\n";
 				++_depth;
 				b.on_succeeded_alt()->accept(*this);
 				_os << "\n";
@@ -375,10 +491,20 @@ namespace chr::compiler::visitor
 		_os << prefix() << "}\n";
 		_os << prefix() << "chr::Statistics::close_choice();\n";
 	
+		write_failed_alternative(true);
 		_os << prefix() << "chr::reset();\n";
+		_os << prefix() << "if (_stop_beha_" << id << "_) {\n";
+		++_depth;
+		if (chr::compiler::Compiler_options::BACKJUMPING)
+			_os << prefix() << "chr::Backjump::close(depth" << id << ");\n";
+		_os << prefix() << exit_statement("chr::failure()") << ";\n";
+		--_depth;
+		_os << prefix() << "}\n";
 		_os << prefix() << "if (" << ltrim(v.string_from( *b.final_status() )) << ") {\n";
 		++_depth;
 		_os << prefix() << "if (depth" << id << " != chr::Backtrack::depth()) chr::Backtrack::back_to(depth" << id << ");\n";
+		if (chr::compiler::Compiler_options::BACKJUMPING)
+			_os << prefix() << "chr::Backjump::close(depth" << id << ");\n";
 		b.on_succeeded_status()->accept(*this);
 		if (!vbe.is_empty(*b.on_succeeded_status()))
 			_os << "\n";
@@ -389,7 +515,10 @@ namespace chr::compiler::visitor
 		b.on_failed_status()->accept(*this);
 		if (!vbe.is_empty(*b.on_failed_status()))
 			_os << "\n";
-		_os << prefix() << "return (chr::failed()?chr::ES_CHR::FAILURE:chr::failure());\n";
+		if (chr::compiler::Compiler_options::BACKJUMPING)
+			_os << prefix() << exit_statement("(chr::failed()?chr::ES_CHR::FAILURE:chr::Backjump::raise(depth" + std::to_string(id) + "))") << ";\n";
+		else
+			_os << prefix() << exit_statement("(chr::failed()?chr::ES_CHR::FAILURE:chr::failure())") << ";\n";
 		--_depth;
 		_os << prefix() << "}\n";
 
@@ -410,7 +539,11 @@ namespace chr::compiler::visitor
 		_os << prefix() << "chr::ES_CHR " << v_name << " = [&]() {\n";
 		++_depth;
 		_os << prefix() << "chr::Backtrack::inc_backtrack_depth();\n";
+		write_suspend_point();
+		write_choice_point_tests("return chr::failure();");
+		std::string exit_label = std::exchange(_exit_label, std::string());
 		t.body()->accept(*this);
+		_exit_label = std::move(exit_label);
 		_os << "\n";
 		_os << prefix() << "return chr::ES_CHR::SUCCESS;\n";
 		--_depth;
@@ -424,6 +557,45 @@ namespace chr::compiler::visitor
 			_os << "chr::Backtrack::back_to(depth" << _depth << ");\n";
 		}
 		_os << prefix() << "chr::reset();\n";
+		// A failure caught by the try statement must not explain a later failure
+		if (chr::compiler::Compiler_options::BACKJUMPING)
+			_os << prefix() << "chr::Backjump::unexplained();\n";
+		--_depth;
+		_os << prefix() << "}\n";
+	}
+
+	void BodyCppCode::visit(ast::ChrSearch& s)
+	{
+		chr::compiler::visitor::ExpressionCppCode v;
+		auto v_name = std::string(v.string_from( *s.variable() ));
+		_last_statement = false;
+		unsigned int id = _depth;
+		_context._local_variables.insert(v_name);
+
+		_os << prefix() << "{\n";
+		++_depth;
+		_os << prefix() << "auto&& _engine_" << id << "_ = " << ltrim(v.string_from( *s.engine() )) << ";\n";
+		_os << prefix() << "typename std::decay_t< decltype(_engine_" << id << "_) >::Decision_t " << v_name << "{};\n";
+		write_trace_statement("BACKTRACK",std::make_tuple(R"_STR("Start search at depth ")_STR","chr::Backtrack::depth()"));
+		_os << prefix() << "bool _found_" << id << "_ = _engine_" << id << "_." << s.name() << "([&](const auto& _decision_" << id << "_) {\n";
+		++_depth;
+		_os << prefix() << v_name << " = _decision_" << id << "_;\n";
+		write_trace_statement("BACKTRACK",std::make_tuple(R"_STR("Apply decision at depth ")_STR","chr::Backtrack::depth()"));
+		std::string exit_label = std::exchange(_exit_label, std::string());
+		s.body()->accept(*this);
+		_exit_label = std::move(exit_label);
+		_os << "\n";
+		_os << prefix() << "return chr::ES_CHR::SUCCESS;\n";
+		--_depth;
+		_os << prefix() << "}";
+		for (auto& a : s.args())
+			_os << ", [&]() { return (" << ltrim(v.string_from( *a )) << "); }";
+		_os << ");\n";
+		write_trace_statement("BACKTRACK",std::make_tuple(R"_STR("End search at depth ")_STR","chr::Backtrack::depth()"));
+		_os << prefix() << "chr::reset();\n";
+		if (chr::compiler::Compiler_options::BACKJUMPING)
+			_os << prefix() << "chr::Backjump::unexplained();\n";
+		_os << prefix() << "if (!_found_" << id << "_) " << exit_statement("(chr::failed()?chr::ES_CHR::FAILURE:chr::failure())") << ";\n";
 		--_depth;
 		_os << prefix() << "}\n";
 	}
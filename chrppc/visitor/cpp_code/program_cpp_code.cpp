@@ -24,6 +24,8 @@
 #include <visitor/body.hh>
 #include <visitor/expression.hh>
 #include <set>
+#include <unordered_set>
+#include <algorithm>
 
 namespace chr::compiler::visitor
 {
@@ -164,6 +166,17 @@ namespace chr::compiler::visitor
 			}
 		_os_ds << "); }\n";
 
+		// -----------------------------------------------------------------
+		// GENERATE COMPACTION OF CONSTRAINT STORES
+		_os_ds << prefix() << "bool chr_store_compact() { bool res = true; ";
+		for (auto& c : p.chr_constraints())
+			if (!c->_never_stored)
+			{
+				auto c_name = std::string( c->_c->constraint()->name()->value() );
+				_os_ds << "res = " << c_name << "_constraint_store->compact() && res; ";
+			}
+		_os_ds << "return res; }\n";
+
 		// -----------------------------------------------------------------
 		// GENERATE CONSTRAINT STORES GETTER
 		for (auto& c : p.chr_constraints())
@@ -173,6 +186,20 @@ namespace chr::compiler::visitor
 				_os_ds << prefix() << "typename " << c_name << "::Constraint_store_t& get_" << c_name << "_store() { return *" << c_name << "_constraint_store; }\n";
 			}
 
+		// -----------------------------------------------------------------
+		// GENERATE IMAGES AND FREEZE OF PERSISTENT CONSTRAINT STORES
+		for (auto& c : p.chr_constraints())
+		{
+			auto pragmas = c->_c->pragmas();
+			if (!c->_never_stored && (std::find(pragmas.begin(), pragmas.end(), Pragma::persistent) != pragmas.end()))
+			{
+				auto c_name = std::string( c->_c->constraint()->name()->value() );
+				_os_ds << prefix() << "bool save_" << c_name << "_image(const std::string& path) { return " << c_name << "_constraint_store->save_image(path, next_free_constraint_id); }\n";
+				_os_ds << prefix() << "bool load_" << c_name << "_image(const std::string& path) { std::uint64_t id = 0; if (!" << c_name << "_constraint_store->load_image(path, id)) return false; next_free_constraint_id = std::max< unsigned long int >(next_free_constraint_id, id); return true; }\n";
+				_os_ds << prefix() << "bool freeze_" << c_name << "_store() { return " << c_name << "_constraint_store->freeze(); }\n";
+			}
+		}
+
 		// -----------------------------------------------------------------
 		// GENERATE HISTORY
 		std::set< std::pair<unsigned int, unsigned int> > rule_history;
@@ -243,6 +270,95 @@ namespace chr::compiler::visitor
 			_os_ds << prefix() << "}\n";
 		}
 
+		// -----------------------------------------------------------------
+		// GENERATE BULK LOAD OF CONSTRAINTS
+		std::unordered_set< const ast::ChrConstraintDecl* > active_decls;
+		for (auto& r : p.occ_rules())
+			active_decls.insert( r->active_constraint().constraint()->decl().get() );
+		for (auto& c : p.chr_constraints())
+		{
+			auto c_name = std::string( c->_c->constraint()->name()->value() );
+			// Variables to schedule when a constraint is stored (see store_active_constraint())
+			std::vector< unsigned int > schedule_var_idx;
+			auto pragmas = c->_c->pragmas();
+			if (!c->_never_stored && (active_decls.find(c.get()) != active_decls.end())
+					&& (std::find(pragmas.begin(), pragmas.end(), Pragma::no_reactivate) == pragmas.end()))
+			{
+				unsigned int i = 0;
+				for (auto& t : c->_c->constraint()->children())
+				{
+					auto pt = dynamic_cast< ast::UnaryExpression* >( t.get() );
+					assert(pt != nullptr);
+					if (pt->op() != "+") schedule_var_idx.push_back(i);
+					++i;
+				}
+			}
+
+			_os_ds << prefix() << "template< typename Range >\n";
+			_os_ds << prefix() << "chr::ES_CHR load_" << c_name << "(const Range& r, [[maybe_unused]] bool defer_activation = false) {\n";
+			++_depth;
+			_os_ds << prefix() << "assert(!chr::failed() && (_ref_use_count >= 1));\n";
+			if (!c->_never_stored)
+			{
+				_os_ds << prefix() << "if (defer_activation) {\n";
+				++_depth;
+				_os_ds << prefix() << "std::vector< typename " << c_name << "::Type > cs;\n";
+				_os_ds << prefix() << "if constexpr (requires { std::size(r); }) cs.reserve(std::size(r));\n";
+				_os_ds << prefix() << "for (const auto& e : r)\n";
+				_os_ds << prefix() << "\tcs.push_back( std::apply([this](const auto&... a) { return typename " << c_name << "::Type(next_free_constraint_id++, a...); }, e) );\n";
+				_os_ds << prefix() << "auto c_first_id = next_free_constraint_id - cs.size();\n";
+				_os_ds << prefix() << "auto c_it = " << c_name << "_constraint_store->load( std::move(cs) );\n";
+				if (!schedule_var_idx.empty())
+				{
+					_os_ds << prefix() << "for (auto it = c_it; !it.at_end() && (std::get<0>(*it) >= c_first_id); ++it) {\n";
+					++_depth;
+					_os_ds << prefix() << "auto c_args = *it;\n";
+					_os_ds << prefix() << "auto it_cb = it;\n";
+					_os_ds << prefix() << "auto ccb = chr::Shared_x_obj< chr::Logical_var_imp_observer_constraint >(new typename " << c_name << "::Constraint_callback(this,it_cb));\n";
+					for (auto i : schedule_var_idx)
+						_os_ds << prefix() << "chr::schedule_constraint_callback(std::get<" << i+1 << ">(c_args), ccb);\n";
+					--_depth;
+					_os_ds << prefix() << "}\n";
+				}
+				// Activation pass: the loaded constraints are already stored
+				_os_ds << prefix() << "while (!c_it.at_end() && (std::get<0>(*c_it) >= c_first_id)) {\n";
+				++_depth;
+				write_trace_statement(_os_ds, c_name, "GOAL", std::make_tuple(R"_STR("Goal constraint: )_STR" + std::string(c_name) + R"_STR(")_STR", "*c_it"));
+				_os_ds << prefix() << "c_it.lock();\n";
+				_os_ds << prefix() << "if (do_" << c_name << "(*c_it, c_it) == chr::ES_CHR::FAILURE) { c_it.unlock(); return chr::ES_CHR::FAILURE; }\n";
+				_os_ds << prefix() << "c_it.next_and_unlock();\n";
+				--_depth;
+				_os_ds << prefix() << "}\n";
+				_os_ds << prefix() << "return chr::ES_CHR::SUCCESS;\n";
+				--_depth;
+				_os_ds << prefix() << "}\n";
+				_os_ds << prefix() << "if constexpr (requires { std::size(r); }) " << c_name << "_constraint_store->reserve(std::size(r));\n";
+			}
+			_os_ds << prefix() << "for (const auto& e : r)\n";
+			_os_ds << prefix() << "\tif (std::apply([this](const auto&... a) { return " << c_name << "(a...); }, e) == chr::ES_CHR::FAILURE) return chr::ES_CHR::FAILURE;\n";
+			_os_ds << prefix() << "return chr::ES_CHR::SUCCESS;\n";
+			--_depth;
+			_os_ds << prefix() << "}\n";
+
+			// Bulk load from a text file of facts (a template, so that
+			// the fact loader is instantiated only for the constraints loaded from a file)
+			_os_ds << prefix() << "template < typename Path_t = std::string >\n";
+			_os_ds << prefix() << "chr::ES_CHR load_" << c_name << "_file(const Path_t& path, char sep = ',', bool defer_activation = false, unsigned int nb_threads = 0) {\n";
+			++_depth;
+			_os_ds << prefix() << "return load_" << c_name << "(chr::read_facts<";
+			bool first = true;
+			for (auto& t : c->_c->constraint()->children())
+			{
+				auto pt = dynamic_cast< ast::UnaryExpression* >( t.get() );
+				assert(pt != nullptr);
+				_os_ds << (first?" ":", ") << venp.string_from(*pt->child());
+				first = false;
+			}
+			_os_ds << (first?"":" ") << ">(path, sep, nb_threads), defer_activation);\n";
+			--_depth;
+			_os_ds << prefix() << "}\n";
+		}
+
 		--_depth;
 		_os_ds << prefix() << "};\n";
 
@@ -333,7 +449,10 @@ namespace chr::compiler::visitor
 			bool first1 = true;
 			for (auto index : c->_indexes)
 			{
-				_os_ds << (first1?"":",") << " chr::LNS::Index<";
+				// An index whose parameters all have a range (pragma dense) is direct-mapped
+				auto& ranges = c->_dense_ranges;
+				bool dense = !ranges.empty() && std::all_of(index.begin(), index.end(), [&](unsigned int idx) { return ranges[idx].has_value(); });
+				_os_ds << (first1?"":",") << (dense?" chr::LNS::Dense_index< chr::LNS::Index<":" chr::LNS::Index<");
 				first1 = false;
 				bool first2 = true;
 				for (auto idx : index)
@@ -342,6 +461,12 @@ namespace chr::compiler::visitor
 					first2 = false;
 				}
 				_os_ds << ">";
+				if (dense)
+				{
+					for (auto idx : index)
+						_os_ds << ", chr::LNS::Range<" << ranges[idx]->first << "," << ranges[idx]->second << ">";
+					_os_ds << " >";
+				}
 			}
 			if (std::find(pragmas.begin(), pragmas.end(), Pragma::persistent) != pragmas.end())
 				_os_ds << " >, false";
@@ -0,0 +1,164 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_ASYNC_HH_
+#define RUNTIME_ASYNC_HH_
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <backtrack.hh>
+
+namespace chr
+{
+	/**
+	 * @brief Token used to cancel a CHR run from another thread
+	 *
+	 * Copies of a token share the same flag: one copy is given to the
+	 * run and another one is kept by the thread which may cancel it.
+	 */
+	class Cancellation_token
+	{
+	public:
+		/**
+		 * Initialize a token which is not cancelled.
+		 */
+		Cancellation_token() : _flag( std::make_shared< std::atomic< bool > >(false) ) { }
+
+		/**
+		 * Request the cancellation of the run(s) which use this token.
+		 * The run stops at its next choice point.
+		 */
+		void cancel()
+		{
+			_flag->store(true, std::memory_order_relaxed);
+		}
+
+		/**
+		 * Check if the cancellation has been requested.
+		 * @return True if cancel() has been called, false otherwise
+		 */
+		bool cancelled() const
+		{
+			return _flag->load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * Return the shared flag polled by the generated code.
+		 * @return A pointer to the flag
+		 */
+		std::atomic< bool >* flag() const
+		{
+			return _flag.get();
+		}
+
+	private:
+		std::shared_ptr< std::atomic< bool > > _flag;	///< Flag shared by all copies of the token
+	};
+
+	/**
+	 * @brief Scope of a cancellable run
+	 *
+	 * Attach the flag of a token to the current thread for the lifetime
+	 * of the object. When the scope is left, the backtrack depth of the thread
+	 * is restored to the one of the creation of the scope (each observer is
+	 * rewound) and the execution status is reset. It is a back_to(0)-like
+	 * cleanup when the scope is opened at the root of a run.
+	 */
+	class Cancellation_scope
+	{
+	public:
+		/**
+		 * Initialize and attach the token to the current thread.
+		 * @param token The token to poll
+		 */
+		explicit Cancellation_scope(const Cancellation_token& token)
+			: _token(token), _depth(chr::Backtrack::depth()), _previous( chr::Cancellation::attach(token.flag()) )
+		{ }
+
+		/**
+		 * Copy constructor: disabled.
+		 */
+		Cancellation_scope(const Cancellation_scope&) =delete;
+
+		/**
+		 * Assignment operator: disabled.
+		 */
+		Cancellation_scope& operator=(const Cancellation_scope&) =delete;
+
+		/**
+		 * Detach the token and clean up the run if it has been cancelled.
+		 */
+		~Cancellation_scope()
+		{
+			chr::Cancellation::attach(_previous);
+			if (_token.cancelled())
+			{
+				if (chr::Backtrack::depth() > _depth)
+					chr::Backtrack::back_to(_depth);
+				chr::reset();
+			}
+		}
+
+	private:
+		Cancellation_token _token;			///< Token attached to the current thread
+		chr::Depth_t _depth;				///< Backtrack depth when the scope was opened
+		std::atomic< bool >* _previous;		///< Flag attached before this scope
+	};
+
+	/**
+	 * Run a function in the current thread and let it be cancelled by \a token.
+	 * @param token The token used to cancel the run
+	 * @param f The function to run (it creates and calls the CHR program)
+	 * @return The value returned by \a f
+	 */
+	template < typename F >
+	std::invoke_result_t< F > run_cancellable(const Cancellation_token& token, F&& f)
+	{
+		Cancellation_scope scope(token);
+		return std::forward< F >(f)();
+	}
+
+	/**
+	 * Start a function on a new worker thread and let it be cancelled by \a token.
+	 * The backtrack state is local to each thread, so the CHR program must be
+	 * created and used only inside \a f. The search statistics of the worker
+	 * thread are merged into the ones of the program when \a f returns.
+	 * The run stops at a choice point only if the CHR program is compiled with
+	 * the --enable-cancellation_points option of chrppc.
+	 * @param token The token used to cancel the run
+	 * @param f The function to run (it creates and calls the CHR program)
+	 * @return A future on the value returned by \a f
+	 */
+	template < typename F >
+	std::future< std::invoke_result_t< std::decay_t< F > > > run_async(Cancellation_token token, F&& f)
+	{
+		return std::async(std::launch::async, [token = std::move(token), f = std::forward< F >(f)]() mutable {
+			chr::Statistics_thread_scope statistics_scope;
+			return run_cancellable(token, f);
+		});
+	}
+}
+
+#endif /* RUNTIME_ASYNC_HH_ */
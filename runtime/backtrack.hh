@@ -24,8 +24,13 @@
 
 #include <statistics.hh>
 #include <list>
+#include <vector>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <limits>
 #include <memory>
+#include <utility>
 
 #include <trace.hh>
 #include <shared_obj.hh>
@@ -94,6 +99,8 @@ namespace chr {
 	 * choice.
 	 * The template parameter is only here to allow static initialization
 	 * in a .hh file (useful tip).
+	 * The state is local to each thread, so that several CHR programs can be
+	 * run concurrently as long as each one stays in its own thread.
 	 * \ingroup Backtrack
 	 */
 	template < typename T >
@@ -202,19 +209,41 @@ namespace chr {
 			return _backtrack_depth;
 		}
 
+		/**
+		 * @brief Backtrack state of a thread
+		 */
+		struct Thread_state
+		{
+			Depth_t depth = 0;											///< Backtrack depth
+			chr::ES_CHR es_state = chr::ES_CHR::SUCCESS;				///< Execution status
+			std::list< chr::Weak_obj<Backtrack_observer> > wake_up;		///< Backtrack observers
+		};
+
+		/**
+		 * Exchange the backtrack state of the current thread with \a s.
+		 * It is used to run several CHR programs on the same thread (see chr::Fiber).
+		 * @param s The state to exchange
+		 */
+		static void swap_state(Thread_state& s)
+		{
+			std::swap(_backtrack_depth, s.depth);
+			std::swap(_es_state, s.es_state);
+			_wake_up.swap(s.wake_up);
+		}
+
 	private:
-		static Depth_t _backtrack_depth;								///< Current depth in CHR program runtime tree
-		static chr::ES_CHR _es_state;									///< Current depth in CHR program runtime tree
-		static std::list< chr::Weak_obj<Backtrack_observer> > _wake_up;	///< List of callback to wake up after a Backtrack event
+		static thread_local Depth_t _backtrack_depth;								///< Current depth in CHR program runtime tree
+		static thread_local chr::ES_CHR _es_state;									///< Current depth in CHR program runtime tree
+		static thread_local std::list< chr::Weak_obj<Backtrack_observer> > _wake_up;	///< List of callback to wake up after a Backtrack event
 	};
 
 	// Initialization of static members
 	template< typename T >
-	Depth_t chr::Backtrack_t<T>::_backtrack_depth = 0;
+	thread_local Depth_t chr::Backtrack_t<T>::_backtrack_depth = 0;
 	template< typename T >
-	chr::ES_CHR chr::Backtrack_t<T>::_es_state = chr::ES_CHR::SUCCESS;
+	thread_local chr::ES_CHR chr::Backtrack_t<T>::_es_state = chr::ES_CHR::SUCCESS;
 	template< typename T >
-	std::list< chr::Weak_obj<Backtrack_observer> > chr::Backtrack_t<T>::_wake_up;
+	thread_local std::list< chr::Weak_obj<Backtrack_observer> > chr::Backtrack_t<T>::_wake_up;
 
 	// Dummy class to get rid off the template parameter
 	struct Dummy_backtrack { };
@@ -223,6 +252,654 @@ namespace chr {
 	// class.
 	using Backtrack = Backtrack_t< Dummy_backtrack >;
 
+	/**
+	 * @brief Cooperative cancellation of a CHR run
+	 *
+	 * A cancellation flag can be attached to the current thread. The generated
+	 * code polls it at each choice point (disjunction and behavior iteration)
+	 * and raises a failure when it is set, so that the run unwinds through the
+	 * usual backtrack mechanism. The polls are only generated when the CHR
+	 * program is compiled with the --enable-cancellation_points option of
+	 * chrppc, otherwise a cancelled run goes on up to its end.
+	 * A failure limit may also be set on the current thread (it is used by the
+	 * restart statement): once the given number of alternatives of choice points
+	 * have failed, the run is cancelled in the same way. The failed alternatives
+	 * are counted by the same generated code, so chr::failure() is left untouched.
+	 * Only the failures counted while a limit is set are recorded.
+	 * The template parameter is only here to allow static initialization
+	 * in a .hh file (useful tip).
+	 * \ingroup Backtrack
+	 */
+	template < typename T >
+	class Cancellation_t
+	{
+	public:
+		/**
+		 * Initialize: disabled.
+		 */
+		Cancellation_t() =delete;
+
+		/**
+		 * Check if the cancellation of the run of the current thread has been requested.
+		 * @return True if the run must be cancelled, false otherwise
+		 */
+		static bool requested()
+		{
+			return _limit_reached || ((_flag != nullptr) && _flag->load(std::memory_order_relaxed));
+		}
+
+		/**
+		 * @brief Failure limit of the current thread
+		 */
+		struct Failure_limit
+		{
+			bool enabled = false;			///< True if the failures are counted
+			bool reached = false;			///< True if the limit has been reached
+			unsigned long remaining = 0;	///< Number of failures before the limit is reached
+			unsigned long failures = 0;		///< Number of failures raised by the thread when the limit was saved
+		};
+
+		/**
+		 * Set the failure limit of the current thread: the run is cancelled
+		 * once \a n failures have been raised.
+		 * @param n The maximum number of failures (at least 1)
+		 * @return The previous failure limit, to be restored later
+		 */
+		static Failure_limit limit_failures(unsigned long n)
+		{
+			Failure_limit previous = { _limit_enabled, _limit_reached, _remaining_failures, _nb_failures };
+			_limit_enabled = true;
+			_limit_reached = false;
+			_remaining_failures = (n > 0) ? n : 1;
+			return previous;
+		}
+
+		/**
+		 * Restore a failure limit returned by limit_failures(). The failures
+		 * raised since then are counted against the restored limit.
+		 * @param l The failure limit to restore
+		 */
+		static void restore(const Failure_limit& l)
+		{
+			unsigned long n = _nb_failures - l.failures;
+			_limit_enabled = l.enabled;
+			_limit_reached = l.reached || (l.enabled && (n >= l.remaining));
+			_remaining_failures = _limit_reached ? 0 : (l.remaining - n);
+		}
+
+		/**
+		 * Check if the failure limit of the current thread has been reached.
+		 * @return True if the limit has been reached, false otherwise
+		 */
+		static bool limit_reached()
+		{
+			return _limit_reached;
+		}
+
+		/**
+		 * Count a failed alternative against the failure limit of the current thread.
+		 * It is called by the code generated with --enable-cancellation_points.
+		 */
+		static void count_failure()
+		{
+			if (!_limit_enabled) return;
+			++_nb_failures;
+			if (!_limit_reached && (--_remaining_failures == 0))
+				_limit_reached = true;
+		}
+
+		/**
+		 * Attach a cancellation flag to the current thread.
+		 * @param flag The new flag to poll (nullptr to detach)
+		 * @return The previously attached flag
+		 */
+		static std::atomic< bool >* attach(std::atomic< bool >* flag)
+		{
+			std::atomic< bool >* previous = _flag;
+			_flag = flag;
+			return previous;
+		}
+
+		/**
+		 * Return the cancellation flag attached to the current thread.
+		 * @return The attached flag (nullptr if none)
+		 */
+		static std::atomic< bool >* attached()
+		{
+			return _flag;
+		}
+
+		/**
+		 * @brief Cancellation state of a thread
+		 */
+		struct Thread_state
+		{
+			std::atomic< bool >* flag = nullptr;	///< Attached cancellation flag
+			Failure_limit limit;					///< Failure limit
+		};
+
+		/**
+		 * Exchange the cancellation state of the current thread with \a s.
+		 * @param s The state to exchange
+		 */
+		static void swap_state(Thread_state& s)
+		{
+			std::swap(_flag, s.flag);
+			std::swap(_limit_enabled, s.limit.enabled);
+			std::swap(_limit_reached, s.limit.reached);
+			std::swap(_remaining_failures, s.limit.remaining);
+			std::swap(_nb_failures, s.limit.failures);
+		}
+
+	private:
+		static thread_local std::atomic< bool >* _flag;			///< Cancellation flag polled by the current thread
+		static thread_local bool _limit_enabled;				///< True if the failures are counted
+		static thread_local bool _limit_reached;				///< True if the failure limit has been reached
+		static thread_local unsigned long _remaining_failures;	///< Number of failures before the limit is reached
+		static thread_local unsigned long _nb_failures;			///< Number of failures raised by the current thread
+	};
+
+	// Initialization of static members
+	template< typename T >
+	thread_local std::atomic< bool >* chr::Cancellation_t<T>::_flag = nullptr;
+	template< typename T >
+	thread_local bool chr::Cancellation_t<T>::_limit_enabled = false;
+	template< typename T >
+	thread_local bool chr::Cancellation_t<T>::_limit_reached = false;
+	template< typename T >
+	thread_local unsigned long chr::Cancellation_t<T>::_remaining_failures = 0;
+	template< typename T >
+	thread_local unsigned long chr::Cancellation_t<T>::_nb_failures = 0;
+
+	// Alias to get rid off the template parameter when calling Cancellation
+	// class.
+	using Cancellation = Cancellation_t< Dummy_backtrack >;
+
+	/**
+	 * @brief Limited discrepancy and limited width of disjunctions
+	 *
+	 * Limits may be set on the current thread to make the search incomplete.
+	 * The generated code of a disjunction asks allow() before trying each
+	 * alternative but the first one. Taking a non-first alternative costs one
+	 * discrepancy and is refused when the discrepancies spent along the current
+	 * branch reach the discrepancy limit (limited discrepancy search). Only the
+	 * \e width first alternatives of a disjunction are tried (beam search
+	 * of width \e width). A refused alternative fails.
+	 * The template parameter is only here to allow static initialization
+	 * in a .hh file (useful tip).
+	 * \ingroup Backtrack
+	 */
+	template < typename T >
+	class Search_limit_t
+	{
+	public:
+		static constexpr unsigned long UNLIMITED = std::numeric_limits< unsigned long >::max();	///< No limit
+
+		/**
+		 * Initialize: disabled.
+		 */
+		Search_limit_t() =delete;
+
+		/**
+		 * @brief Search limits of the current thread
+		 */
+		struct Limits
+		{
+			bool enabled = false;					///< True if the limits are checked
+			bool pruned = false;					///< True if an alternative has been refused
+			unsigned long discrepancies = UNLIMITED;	///< Maximum number of discrepancies of a branch
+			unsigned long width = UNLIMITED;		///< Maximum number of alternatives tried by a disjunction
+			unsigned long spent = 0;				///< Number of discrepancies spent by the current branch
+			unsigned long refusals = 0;				///< Number of alternatives refused (never restored)
+		};
+
+		/**
+		 * Set the limits of the current thread.
+		 * @param discrepancies The maximum number of discrepancies of a branch
+		 * @param width The maximum number of alternatives tried by a disjunction
+		 * @return The previous limits, to be restored later
+		 */
+		static Limits set(unsigned long discrepancies, unsigned long width = UNLIMITED)
+		{
+			Limits previous = { _enabled, _pruned, _discrepancies, _width, _spent, _refusals };
+			_enabled = true;
+			_pruned = false;
+			_discrepancies = discrepancies;
+			_width = (width > 0) ? width : 1;
+			_spent = 0;
+			return previous;
+		}
+
+		/**
+		 * Restore limits returned by set(). If an alternative has been refused
+		 * since then, the restored limits are marked as pruned too.
+		 * @param l The limits to restore
+		 */
+		static void restore(const Limits& l)
+		{
+			bool pruned = _pruned;
+			_enabled = l.enabled;
+			_pruned = l.pruned || (l.enabled && pruned);
+			_discrepancies = l.discrepancies;
+			_width = l.width;
+			_spent = l.spent;
+		}
+
+		/**
+		 * Return the number of discrepancies spent by the current branch.
+		 * @return The number of discrepancies
+		 */
+		static unsigned long spent()
+		{
+			return _spent;
+		}
+
+		/**
+		 * Check if an alternative has been refused since the limits have been set.
+		 * @return True if the search has been pruned, false otherwise
+		 */
+		static bool pruned()
+		{
+			return _pruned;
+		}
+
+		/**
+		 * Return the number of alternatives refused by the current thread.
+		 * The number only grows (it is not restored with the limits): a subtree
+		 * has been pruned if the number has changed while it was explored.
+		 * @return The number of refused alternatives
+		 */
+		static unsigned long refusals()
+		{
+			return _refusals;
+		}
+
+		/**
+		 * Check if the alternative \a i (not the first one) of a disjunction may
+		 * be tried, and spend a discrepancy if it is the case.
+		 * @param spent The number of discrepancies spent when the disjunction was entered
+		 * @param i The index of the alternative
+		 * @return True if the alternative may be tried, false otherwise
+		 */
+		static bool allow(unsigned long spent, unsigned long i)
+		{
+			if (!_enabled) return true;
+			_spent = spent;
+			if ((i >= _width) || (_spent >= _discrepancies))
+			{
+				_pruned = true;
+				++_refusals;
+				return false;
+			}
+			++_spent;
+			return true;
+		}
+
+		/**
+		 * Exchange the limits of the current thread with \a l.
+		 * @param l The limits to exchange
+		 */
+		static void swap_state(Limits& l)
+		{
+			std::swap(_enabled, l.enabled);
+			std::swap(_pruned, l.pruned);
+			std::swap(_discrepancies, l.discrepancies);
+			std::swap(_width, l.width);
+			std::swap(_spent, l.spent);
+			std::swap(_refusals, l.refusals);
+		}
+
+	private:
+		static thread_local bool _enabled;					///< True if the limits are checked
+		static thread_local bool _pruned;					///< True if an alternative has been refused
+		static thread_local unsigned long _discrepancies;	///< Maximum number of discrepancies of a branch
+		static thread_local unsigned long _width;			///< Maximum number of alternatives tried by a disjunction
+		static thread_local unsigned long _spent;			///< Number of discrepancies spent by the current branch
+		static thread_local unsigned long _refusals;		///< Number of alternatives refused by the current thread
+	};
+
+	// Initialization of static members
+	template< typename T >
+	thread_local bool chr::Search_limit_t<T>::_enabled = false;
+	template< typename T >
+	thread_local bool chr::Search_limit_t<T>::_pruned = false;
+	template< typename T >
+	thread_local unsigned long chr::Search_limit_t<T>::_discrepancies = chr::Search_limit_t<T>::UNLIMITED;
+	template< typename T >
+	thread_local unsigned long chr::Search_limit_t<T>::_width = chr::Search_limit_t<T>::UNLIMITED;
+	template< typename T >
+	thread_local unsigned long chr::Search_limit_t<T>::_spent = 0;
+	template< typename T >
+	thread_local unsigned long chr::Search_limit_t<T>::_refusals = 0;
+
+	// Alias to get rid off the template parameter when calling Search_limit
+	// class.
+	using Search_limit = Search_limit_t< Dummy_backtrack >;
+
+	/**
+	 * @brief Conflict-directed backjumping
+	 *
+	 * A failure may be explained by the depths of the decisions it depends on
+	 * (its culprits). A failure raised by chr::failure() is not explained: it
+	 * may depend on every decision of the current branch and leads to the usual
+	 * chronological backtrack.
+	 * The explanation of a failure is read (and forgotten) by the frame of the
+	 * enclosing choice point, so that chr::failure() and chr::reset() don't have
+	 * to clear it. Code which catches an explained failure and goes on must
+	 * forget the explanation with unexplained() (the try and search statements
+	 * generated with --enable-backjumping do it).
+	 * Each disjunction and behavior opens a frame at its depth (the frames are
+	 * generated by chrppc with the --enable-backjumping option). When one of its
+	 * alternatives fails, the culprits of the failure are gathered in the frame.
+	 * If none of them is deeper than the choice point, the next alternatives would
+	 * fail for the same reason: they are skipped and the failure is propagated with
+	 * the culprits gathered by the frame. The search thus back-jumps to the deepest
+	 * culprit. When all alternatives fail, the failure of the choice point is
+	 * explained by the union of the culprits of its alternatives.
+	 * The culprits must cover every decision that the failure depends on. The
+	 * choice points between the deepest culprit and the failure must not change
+	 * the outcome (as for a labeling of the variables of a CSP).
+	 * The template parameter is only here to allow static initialization
+	 * in a .hh file (useful tip).
+	 * \ingroup Backtrack
+	 */
+	template < typename T >
+	class Backjump_t
+	{
+	public:
+		/**
+		 * Initialize: disabled.
+		 */
+		Backjump_t() =delete;
+
+		/**
+		 * Raise a CHR failure explained by the decisions taken at depths \a culprits.
+		 * A decision taken inside an alternative is at depth chr::Backtrack::depth()
+		 * of this alternative.
+		 * @param culprits The depths of the decisions the failure depends on
+		 * @return ES_CHR::FAILURE
+		 */
+		template < typename... D >
+		static chr::ES_CHR fail(D... culprits);
+
+		/**
+		 * Forget the explanation of the last failure. The next failure is
+		 * considered as not explained unless it is raised with culprits.
+		 */
+		static void unexplained()
+		{
+			_explained = false;
+		}
+
+		/**
+		 * Open the frame of a choice point created at depth \a depth.
+		 * The frames of the choice points that have been left are discarded.
+		 * @param depth The depth of the choice point (before its alternatives)
+		 */
+		static void open(Depth_t depth)
+		{
+			_explained = false;
+			while (!_frames.empty() && (_frames.back().depth >= depth))
+				_frames.pop_back();
+			_frames.push_back( Frame{depth, true, 0, {}} );
+		}
+
+		/**
+		 * Record the result of an alternative of the choice point created at depth \a depth.
+		 * It must be called just after the alternative, before chr::reset().
+		 * @param depth The depth of the choice point
+		 * @param status The result of the alternative
+		 * @return True if the next alternatives fail for the same reason and can be skipped
+		 */
+		static bool jump(Depth_t depth, chr::ES_CHR status = chr::ES_CHR::FAILURE)
+		{
+			collect(depth);
+			assert(!_frames.empty() && (_frames.back().depth == depth));
+			Frame& f = _frames.back();
+			// The explanation is consumed, the next alternative starts without one
+			bool explained = std::exchange(_explained, false);
+			if (status == chr::ES_CHR::SUCCESS)
+			{
+				f.explained = false;
+				return false;
+			}
+			++f.failures;
+			if (!explained)
+			{
+				f.explained = false;
+				return false;
+			}
+			auto it = std::upper_bound(_conflict.begin(), _conflict.end(), depth);
+			bool independent = (it == _conflict.end());
+			_conflict.erase(it, _conflict.end());
+			merge(f.culprits, _conflict);
+			if (independent)
+				chr::Statistics::inc_nb_backjumps();
+			return independent;
+		}
+
+		/**
+		 * Leave the choice point created at depth \a depth on a failure.
+		 * The current failure is explained by the culprits gathered by the frame.
+		 * @param depth The depth of the choice point
+		 * @return ES_CHR::FAILURE
+		 */
+		static chr::ES_CHR leave(Depth_t depth)
+		{
+			collect(depth);
+			assert(!_frames.empty() && (_frames.back().depth == depth));
+			Frame& f = _frames.back();
+			_conflict.swap(f.culprits);
+			_explained = f.explained && (f.failures > 0);
+			_frames.pop_back();
+			return chr::ES_CHR::FAILURE;
+		}
+
+		/**
+		 * Raise a CHR failure for the choice point created at depth \a depth
+		 * once all its alternatives have been tried.
+		 * @param depth The depth of the choice point
+		 * @return ES_CHR::FAILURE
+		 */
+		static chr::ES_CHR raise(Depth_t depth);
+
+		/**
+		 * Close the frame of the choice point created at depth \a depth
+		 * when it succeeded.
+		 * @param depth The depth of the choice point
+		 */
+		static void close(Depth_t depth)
+		{
+			while (!_frames.empty() && (_frames.back().depth >= depth))
+				_frames.pop_back();
+		}
+
+	private:
+		/**
+		 * @brief Culprits gathered by a choice point
+		 */
+		struct Frame
+		{
+			Depth_t depth;					///< Depth of the choice point
+			bool explained;					///< True if all alternatives failed with an explanation
+			unsigned int failures;			///< Number of failed alternatives
+			std::vector< Depth_t > culprits;///< Sorted culprits of the failed alternatives
+		};
+
+	public:
+		/**
+		 * @brief Backjumping state of a thread
+		 */
+		struct Thread_state
+		{
+			bool explained = false;				///< True if the current failure is explained
+			std::vector< Depth_t > conflict;	///< Sorted culprits of the current failure
+			std::vector< Frame > frames;		///< Frames of the open choice points
+		};
+
+		/**
+		 * Exchange the backjumping state of the current thread with \a s.
+		 * @param s The state to exchange
+		 */
+		static void swap_state(Thread_state& s)
+		{
+			std::swap(_explained, s.explained);
+			_conflict.swap(s.conflict);
+			_frames.swap(s.frames);
+		}
+
+	private:
+
+		/**
+		 * Merge the sorted set of depths \a src into the sorted set \a dst.
+		 * @param dst The destination set
+		 * @param src The set to add
+		 */
+		static void merge(std::vector< Depth_t >& dst, const std::vector< Depth_t >& src)
+		{
+			if (src.empty()) return;
+			std::size_t n = dst.size();
+			dst.insert(dst.end(), src.begin(), src.end());
+			std::inplace_merge(dst.begin(), dst.begin() + n, dst.end());
+			dst.erase(std::unique(dst.begin(), dst.end()), dst.end());
+		}
+
+		/**
+		 * Merge the frames of the choice points deeper than \a depth
+		 * into the current failure. They have been left by the current failure.
+		 * @param depth The depth of the current choice point
+		 */
+		static void collect(Depth_t depth)
+		{
+			while (!_frames.empty() && (_frames.back().depth > depth))
+			{
+				Frame& f = _frames.back();
+				_explained = _explained && f.explained;
+				if (_explained) merge(_conflict, f.culprits);
+				_frames.pop_back();
+			}
+		}
+
+		static thread_local bool _explained;						///< True if the current failure is explained by _conflict
+		static thread_local std::vector< Depth_t > _conflict;		///< Sorted culprits of the current failure
+		static thread_local std::vector< Frame > _frames;			///< Frames of the open choice points
+	};
+
+	// Initialization of static members
+	template< typename T >
+	thread_local bool chr::Backjump_t<T>::_explained = false;
+	template< typename T >
+	thread_local std::vector< Depth_t > chr::Backjump_t<T>::_conflict;
+	template< typename T >
+	thread_local std::vector< typename chr::Backjump_t<T>::Frame > chr::Backjump_t<T>::_frames;
+
+	// Alias to get rid off the template parameter when calling Backjump
+	// class.
+	using Backjump = Backjump_t< Dummy_backtrack >;
+
+	/**
+	 * @brief Bound of a branch and bound search
+	 *
+	 * A bound hook can be attached to the current thread by a branch and bound
+	 * search (see chr::Incumbent). The generated code polls it at each choice
+	 * point (disjunction and behavior iteration) and raises a failure when the
+	 * hook tells that the current branch cannot improve the best solution found
+	 * so far. The solutions marked with chr::yield_solution() are given to the
+	 * hook, which records them and makes the search go on. The polls are only
+	 * generated when the CHR program is compiled with the --enable-bound_pruning
+	 * option of chrppc, otherwise the whole tree is explored.
+	 * The template parameter is only here to allow static initialization
+	 * in a .hh file (useful tip).
+	 * \ingroup Backtrack
+	 */
+	template < typename T >
+	class Bound_t
+	{
+	public:
+		/**
+		 * Initialize: disabled.
+		 */
+		Bound_t() =delete;
+
+		/**
+		 * @brief Bound hook of a thread
+		 */
+		struct Hook
+		{
+			bool (*prune)(void*) = nullptr;				///< Return true if the current branch must be pruned
+			chr::ES_CHR (*solution)(void*) = nullptr;	///< Record the current solution and return the status of yield_solution()
+			void* context = nullptr;					///< Context given to the functions of the hook
+		};
+
+		/**
+		 * Attach a bound hook to the current thread.
+		 * @param h The new hook
+		 * @return The previous hook, to be restored later
+		 */
+		static Hook set(const Hook& h)
+		{
+			Hook previous = _hook;
+			_hook = h;
+			return previous;
+		}
+
+		/**
+		 * Restore a bound hook returned by set().
+		 * @param h The hook to restore
+		 */
+		static void restore(const Hook& h)
+		{
+			_hook = h;
+		}
+
+		/**
+		 * Check if a bound hook is attached to the current thread.
+		 * @return True if a hook is attached, false otherwise
+		 */
+		static bool active()
+		{
+			return _hook.solution != nullptr;
+		}
+
+		/**
+		 * Check if the current branch must be pruned by the bound.
+		 * @return True if the branch cannot improve the best solution, false otherwise
+		 */
+		static bool prune()
+		{
+			return (_hook.prune != nullptr) && _hook.prune(_hook.context);
+		}
+
+		/**
+		 * Give the current solution to the bound hook.
+		 * @return The status of chr::yield_solution() for this solution
+		 */
+		static chr::ES_CHR solution()
+		{
+			return _hook.solution(_hook.context);
+		}
+
+		/**
+		 * Exchange the bound hook of the current thread with \a h.
+		 * @param h The hook to exchange
+		 */
+		static void swap_state(Hook& h)
+		{
+			std::swap(_hook, h);
+		}
+
+	private:
+		static thread_local Hook _hook;	///< Bound hook of the current thread
+	};
+
+	// Initialization of static members
+	template< typename T >
+	thread_local typename chr::Bound_t<T>::Hook chr::Bound_t<T>::_hook;
+
+	// Alias to get rid off the template parameter when calling Bound
+	// class.
+	using Bound = Bound_t< Dummy_backtrack >;
+
 	/**
 	 * Raise a CHR failure.
 	 * Set the global execution status to FAILURE and increases the number
@@ -264,6 +941,49 @@ namespace chr {
 		chr::Backtrack::reset();
 	}
 
+	template < typename T >
+	template < typename... D >
+	chr::ES_CHR Backjump_t<T>::fail(D... culprits)
+	{
+		chr::failure();
+		_conflict.assign({ static_cast< Depth_t >(culprits)... });
+		assert(std::all_of(_conflict.begin(), _conflict.end(), [](Depth_t d) { return d <= chr::Backtrack::depth(); }));
+		std::sort(_conflict.begin(), _conflict.end());
+		_conflict.erase(std::unique(_conflict.begin(), _conflict.end()), _conflict.end());
+		_explained = true;
+		return chr::ES_CHR::FAILURE;
+	}
+
+	template < typename T >
+	chr::ES_CHR Backjump_t<T>::raise(Depth_t depth)
+	{
+		chr::failure();
+		return leave(depth);
+	}
+
+	/**
+	 * Raise a CHR failure explained by the decisions taken at depths \a culprits
+	 * (see Backjump_t). Convenient function used to design CHR rules.
+	 * @param culprits The depths of the decisions the failure depends on
+	 * @return ES_CHR::FAILURE
+	 */
+	template < typename... D >
+	inline chr::ES_CHR explained_failure(D... culprits)
+	{
+		return chr::Backjump::fail(culprits...);
+	}
+
+	/**
+	 * Return the depth of the current decision, it may be used later
+	 * as a culprit of an explained failure. Convenient function used
+	 * to design CHR rules.
+	 * @return The current backtrack depth
+	 */
+	inline Depth_t decision_depth()
+	{
+		return chr::Backtrack::depth();
+	}
+
 }
 
 #endif /* RUNTIME_BACKTRACK_HH_ */
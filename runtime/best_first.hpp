@@ -0,0 +1,265 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_BEST_FIRST_HH_
+#define RUNTIME_BEST_FIRST_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <statistics.hh>
+#include <backtrack.hh>
+
+namespace chr
+{
+	/**
+	 * @brief Best-first and A* search over CHR choice points
+	 *
+	 * The open nodes of the search are kept in a priority queue and expanded
+	 * by increasing priority. A node is not a copy of the CHR store: it is
+	 * the last decision of a path in a decision log (each node references its
+	 * parent). The state of a node is materialized by recomputation: the
+	 * engine backtracks to the deepest ancestor which is still materialized and
+	 * replays the missing decisions. When the next node to expand is a child of
+	 * the current one (a depth-first dive), its decision is simply applied on
+	 * top of the current state, the trail is used as usual.
+	 *
+	 * It is the engine of the best_first and astar CHR statements, which leave
+	 * the CHR store in the state of the goal node when a goal is found.
+	 * @tparam Decision The type of a decision (default constructible and copyable)
+	 * @tparam Priority The type of the priority of a node (lower is expanded first)
+	 */
+	template < typename Decision, typename Priority = double >
+	class Best_first
+	{
+	public:
+		using Decision_t = Decision;	///< Type of a decision
+		using Priority_t = Priority;	///< Type of the priority of a node
+
+		/**
+		 * Initialize.
+		 * @param max_expansions The maximum number of node expansions (0 for no limit)
+		 */
+		explicit Best_first(unsigned long max_expansions = 0) : _max_expansions(max_expansions) { }
+
+		/**
+		 * Run a best-first search from the current state of the CHR program.
+		 * @param apply Function applying a decision to the current state (it returns ES_CHR::FAILURE if the decision is not valid)
+		 * @param children Function returning the range of decisions of the current state
+		 * @param priority Function returning the priority of the current state (called just after a successful apply)
+		 * @param goal Function returning true if the current state is a goal
+		 * @return True if a goal has been found, false otherwise
+		 */
+		template < typename Apply, typename Children, typename Prio, typename Goal >
+		bool best_first(Apply apply, Children children, Prio priority, Goal goal)
+		{
+			auto eval = [&](const Node&) { return static_cast< Priority >(priority()); };
+			return search(apply, children, eval, goal);
+		}
+
+		/**
+		 * Run an A* search from the current state of the CHR program.
+		 * The priority of a node is g + h where g is the sum of the costs of the
+		 * decisions from the root and h the heuristic value of the node.
+		 * @param apply Function applying a decision to the current state (it returns ES_CHR::FAILURE if the decision is not valid)
+		 * @param children Function returning the range of decisions of the current state
+		 * @param cost Function returning the cost of the decision which has just been applied
+		 * @param heuristic Function returning the estimated remaining cost of the current state
+		 * @param goal Function returning true if the current state is a goal
+		 * @return True if a goal has been found, false otherwise
+		 */
+		template < typename Apply, typename Children, typename Cost, typename Heuristic, typename Goal >
+		bool astar(Apply apply, Children children, Cost cost, Heuristic heuristic, Goal goal)
+		{
+			auto eval = [&](Node& n) {
+				n.g = _nodes[n.parent].g + static_cast< Priority >(cost());
+				return n.g + static_cast< Priority >(heuristic());
+			};
+			return search(apply, children, eval, goal);
+		}
+
+		/**
+		 * Return the decisions from the root to the goal found by the last search.
+		 * @return The path of decisions (empty if no goal has been found)
+		 */
+		const std::vector< Decision >& solution() const { return _solution; }
+
+		/**
+		 * Return the priority of the goal found by the last search.
+		 * With astar, it is the cost of the path.
+		 * @return The priority of the goal
+		 */
+		Priority solution_priority() const { return _solution_priority; }
+
+		/**
+		 * Return the number of nodes expanded by the last search.
+		 * @return The number of expansions
+		 */
+		unsigned long expansions() const { return _expansions; }
+
+		/**
+		 * Return the number of decisions replayed to materialize nodes
+		 * (the recomputation cost of the last search).
+		 * @return The number of replayed decisions
+		 */
+		unsigned long replayed() const { return _replayed; }
+
+		/**
+		 * Set the maximum number of node expansions of the next searches.
+		 * @param max_expansions The maximum number of expansions (0 for no limit)
+		 */
+		void set_max_expansions(unsigned long max_expansions) { _max_expansions = max_expansions; }
+
+	private:
+		static constexpr std::size_t _npos = std::numeric_limits< std::size_t >::max();	///< Parent of the root node
+
+		/**
+		 * @brief Node of the decision log
+		 */
+		struct Node
+		{
+			std::size_t parent;		///< Index of the parent node
+			Decision decision;		///< Decision which leads from the parent to this node
+			Priority g;				///< Cost of the path from the root (A* only)
+		};
+
+		/**
+		 * Bring the CHR program to the state of the node \a k.
+		 * @param apply Function applying a decision to the current state
+		 * @param root The backtrack depth of the root state
+		 * @param k The node to materialize
+		 * @return True if the state has been materialized, false otherwise
+		 */
+		template < typename Apply >
+		bool materialize(Apply& apply, Depth_t root, std::size_t k)
+		{
+			std::vector< std::size_t > chain;
+			for (std::size_t x = k; x != _npos; x = _nodes[x].parent)
+				chain.push_back(x);
+			std::reverse(chain.begin(), chain.end());
+
+			// _path[i] is materialized at depth root + i
+			std::size_t common = 0;
+			while ((common < _path.size()) && (common < chain.size()) && (_path[common] == chain[common]))
+				++common;
+			assert(common > 0);
+			if (common < _path.size())
+			{
+				chr::Backtrack::back_to(root + common - 1);
+				_path.resize(common);
+			}
+			chr::reset();
+			for (std::size_t i = common; i < chain.size(); ++i)
+			{
+				if (i > common) ++_replayed;
+				chr::Backtrack::inc_backtrack_depth();
+				if ((apply(_nodes[chain[i]].decision) != chr::ES_CHR::SUCCESS) || chr::failed())
+				{
+					chr::Backtrack::back_to(root + _path.size() - 1);
+					chr::reset();
+					return false;
+				}
+				_path.push_back(chain[i]);
+			}
+			return true;
+		}
+
+		/**
+		 * Main loop shared by best_first and astar.
+		 * @param apply Function applying a decision to the current state
+		 * @param children Function returning the range of decisions of the current state
+		 * @param eval Function computing the priority of a new node
+		 * @param goal Function returning true if the current state is a goal
+		 * @return True if a goal has been found, false otherwise
+		 */
+		template < typename Apply, typename Children, typename Eval, typename Goal >
+		bool search(Apply& apply, Children& children, Eval& eval, Goal& goal)
+		{
+			using Entry = std::pair< Priority, std::size_t >;
+			std::priority_queue< Entry, std::vector< Entry >, std::greater< Entry > > open;
+			_nodes.clear();
+			_path.clear();
+			_solution.clear();
+			_expansions = 0;
+			_replayed = 0;
+
+			Depth_t root = chr::Backtrack::depth();
+			_nodes.push_back( Node{_npos, Decision{}, Priority{}} );
+			_path.push_back(0);
+			open.emplace(Priority{}, 0);
+			while (!open.empty())
+			{
+				if (chr::Cancellation::requested()) break;
+				if ((_max_expansions > 0) && (_expansions >= _max_expansions)) break;
+				auto [f, k] = open.top();
+				open.pop();
+				if (!materialize(apply, root, k)) continue;
+
+				if (goal())
+				{
+					for (std::size_t i = 1; i < _path.size(); ++i)
+						_solution.push_back(_nodes[_path[i]].decision);
+					_solution_priority = f;
+					return true;
+				}
+
+				++_expansions;
+				chr::Statistics::open_choice();
+				Depth_t d = chr::Backtrack::depth();
+				for (auto&& c : children())
+				{
+					chr::reset();
+					chr::Backtrack::inc_backtrack_depth();
+					if ((apply(c) == chr::ES_CHR::SUCCESS) && !chr::failed())
+					{
+						Node n{k, c, Priority{}};
+						Priority p = eval(n);
+						_nodes.push_back( std::move(n) );
+						open.emplace(p, _nodes.size() - 1);
+					}
+					chr::Backtrack::back_to(d);
+				}
+				chr::Statistics::close_choice();
+				chr::reset();
+			}
+			if (chr::Backtrack::depth() > root)
+				chr::Backtrack::back_to(root);
+			chr::reset();
+			return false;
+		}
+
+		unsigned long _max_expansions;				///< Maximum number of expansions (0 for no limit)
+		unsigned long _expansions = 0;				///< Number of expansions of the last search
+		unsigned long _replayed = 0;				///< Number of decisions replayed by the last search
+		std::vector< Node > _nodes;					///< Decision log (all generated nodes)
+		std::vector< std::size_t > _path;			///< Nodes currently materialized, from the root
+		std::vector< Decision > _solution;			///< Path to the goal found by the last search
+		Priority _solution_priority = Priority{};	///< Priority of the goal found by the last search
+	};
+}
+
+#endif /* RUNTIME_BEST_FIRST_HH_ */
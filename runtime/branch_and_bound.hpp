@@ -0,0 +1,214 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_BRANCH_AND_BOUND_HH_
+#define RUNTIME_BRANCH_AND_BOUND_HH_
+
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <mutex>
+
+#include <backtrack.hh>
+
+namespace chr
+{
+	/**
+	 * @brief Shared incumbent of a branch and bound search
+	 *
+	 * The incumbent is the cost of the best solution found so far. It lives
+	 * outside of the CHR space, so it survives the backtracks of the search,
+	 * and it is an atomic value, so one incumbent can be shared by the
+	 * workers of a parallel search (chr::parallel_exists(), chr::parallel_forall(), ...):
+	 * a solution found by a worker tightens the bound of all the others.
+	 *
+	 * It is the engine of the minimize CHR statement:
+	 *     minimize(incumbent, cost, lower_bound, body)
+	 * The body explores the search tree and marks each solution with
+	 * chr::yield_solution() # catch_failure. The cost of a solution is
+	 * evaluated when it is marked: if it is better than the incumbent, the
+	 * incumbent is updated, then the search goes on. At each choice point,
+	 * the branch is pruned when the lower bound (user hook evaluated in the
+	 * current state) of its cost cannot beat the incumbent: a constant lower
+	 * bound, such as 0 for non negative costs, only prunes when the incumbent
+	 * reaches it (the pruning at choice points needs the --enable-bound_pruning
+	 * option of chrppc). The CHR store is restored at the end
+	 * of the statement, which fails if no better solution has been found.
+	 * The solutions can be recorded with on_improve().
+	 * @tparam Cost The type of the cost (a type supported by std::atomic)
+	 */
+	template < typename Cost = double >
+	class Incumbent
+	{
+	public:
+		using Decision_t = bool;	///< Type of the decision of the minimize statement (unused)
+
+		/**
+		 * Initialize: no solution found.
+		 */
+		Incumbent() =default;
+
+		/**
+		 * Copy constructor (deleted).
+		 */
+		Incumbent(const Incumbent&) =delete;
+
+		/**
+		 * Assignment operator (deleted).
+		 */
+		Incumbent& operator=(const Incumbent&) =delete;
+
+		/**
+		 * Return the cost of the best solution found so far.
+		 * @return The bound (the maximum value of Cost if no solution has been found)
+		 */
+		Cost bound() const { return _bound.load(std::memory_order_acquire); }
+
+		/**
+		 * Check if a solution has been found.
+		 * @return True if a solution has been found, false otherwise
+		 */
+		bool found() const { return _improvements.load(std::memory_order_acquire) > 0; }
+
+		/**
+		 * Return the number of times the incumbent has been improved.
+		 * @return The number of improvements
+		 */
+		unsigned long improvements() const { return _improvements.load(std::memory_order_acquire); }
+
+		/**
+		 * Try to improve the incumbent with a solution of cost \a c.
+		 * The callback set by on_improve() is called when \a c is better than the incumbent.
+		 * @param c The cost of the solution
+		 * @return True if the incumbent has been improved, false otherwise
+		 */
+		bool improve(Cost c)
+		{
+			// Most solutions don't beat the incumbent, they are rejected without locking
+			if (!(c < _bound.load(std::memory_order_acquire))) return false;
+			// The update and the callback are done under the lock, so the
+			// callbacks are called in the order of the improvements
+			std::lock_guard< std::mutex > lock(_mutex);
+			if (!(c < _bound.load(std::memory_order_acquire))) return false;
+			_bound.store(c, std::memory_order_release);
+			_improvements.fetch_add(1, std::memory_order_acq_rel);
+			if (_on_improve) _on_improve(c);
+			return true;
+		}
+
+		/**
+		 * Set the function called each time the incumbent is improved, on the
+		 * thread of the search which found the solution (the calls are serialized).
+		 * The CHR store is in the state of the solution during the call.
+		 * @param f The function called with the new cost
+		 */
+		void on_improve(std::function< void (Cost) > f) { _on_improve = std::move(f); }
+
+		/**
+		 * Forget the solutions found so far.
+		 */
+		void reset()
+		{
+			_bound.store(std::numeric_limits< Cost >::max(), std::memory_order_release);
+			_improvements.store(0, std::memory_order_release);
+		}
+
+		/**
+		 * Run a branch and bound search from the current state of the CHR program.
+		 * @param apply Function exploring the search tree (the body of the minimize statement)
+		 * @param cost Function returning the cost of the current solution
+		 * @return True if the incumbent has been improved by the search, false otherwise
+		 */
+		template < typename Apply, typename Cost_f >
+		bool minimize(Apply apply, Cost_f cost)
+		{
+			return minimize(std::move(apply), std::move(cost), []() { return std::numeric_limits< Cost >::lowest(); });
+		}
+
+		/**
+		 * Run a branch and bound search from the current state of the CHR program.
+		 * @param apply Function exploring the search tree (the body of the minimize statement)
+		 * @param cost Function returning the cost of the current solution
+		 * @param lower_bound Function returning a lower bound of the cost of the solutions of the current branch
+		 * @return True if the incumbent has been improved by the search, false otherwise
+		 */
+		template < typename Apply, typename Cost_f, typename Lower_bound_f >
+		bool minimize(Apply apply, Cost_f cost, Lower_bound_f lower_bound)
+		{
+			Search< Cost_f, Lower_bound_f > s{ this, cost, lower_bound, false };
+			chr::Bound::Hook previous = chr::Bound::set( { &Search< Cost_f, Lower_bound_f >::prune, &Search< Cost_f, Lower_bound_f >::solution, &s } );
+			Depth_t root = chr::Backtrack::depth();
+			chr::reset();
+			chr::Backtrack::inc_backtrack_depth();
+			if (!chr::Bound::prune() && (apply(false) == chr::ES_CHR::SUCCESS) && !chr::failed())
+				// The body ended without marking a solution: its end is a solution
+				chr::Bound::solution();
+			chr::Bound::restore(previous);
+			chr::Backtrack::back_to(root);
+			chr::reset();
+			return s.improved;
+		}
+
+	private:
+		/**
+		 * @brief Context of the bound hook of a minimize search
+		 */
+		template < typename Cost_f, typename Lower_bound_f >
+		struct Search
+		{
+			Incumbent* incumbent;			///< Incumbent of the search
+			Cost_f& cost;					///< Function returning the cost of the current solution
+			Lower_bound_f& lower_bound;		///< Function returning a lower bound of the current branch
+			bool improved;					///< True if the search has improved the incumbent
+
+			/**
+			 * Check if the current branch cannot beat the incumbent.
+			 * @param c The context (a Search)
+			 * @return True if the branch must be pruned, false otherwise
+			 */
+			static bool prune(void* c)
+			{
+				Search* s = static_cast< Search* >(c);
+				return !(static_cast< Cost >(s->lower_bound()) < s->incumbent->bound());
+			}
+
+			/**
+			 * Record the current solution and go on with the search.
+			 * @param c The context (a Search)
+			 * @return ES_CHR::FAILURE
+			 */
+			static chr::ES_CHR solution(void* c)
+			{
+				Search* s = static_cast< Search* >(c);
+				if (s->incumbent->improve( static_cast< Cost >(s->cost()) ))
+					s->improved = true;
+				return chr::failure();
+			}
+		};
+
+		std::atomic< Cost > _bound = std::numeric_limits< Cost >::max();	///< Cost of the best solution found so far
+		std::atomic< unsigned long > _improvements = 0;						///< Number of improvements of the incumbent
+		std::mutex _mutex;													///< Mutex which serializes the improvements and the calls of the improve callback
+		std::function< void (Cost) > _on_improve;							///< Function called when the incumbent is improved
+	};
+}
+
+#endif /* RUNTIME_BRANCH_AND_BOUND_HH_ */
@@ -23,18 +23,38 @@
 #define RUNTIME_BT_LIST_HH_
 
 #include "statistics.hh"
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstdint>
 #include <cstring>
 #include <memory>
 #include <functional>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
 
 #include <type_traits>
 #include <utils.hpp>
 #include <backtrack.hh>
 
+#ifndef CHR_STORE_SEGMENT_BITS
+/// Log2 of the number of nodes of a segment of the constraint stores (0 for contiguous stores, see chr::Bt_list)
+#define CHR_STORE_SEGMENT_BITS 0
+#endif
+
+#ifndef CHR_STORE_SOA
+/// 1 to store the constraints of the constraint stores apart from the links of their nodes (see chr::Bt_list)
+#define CHR_STORE_SOA 0
+#endif
+
+#ifndef CHR_INDEX_INLINE_CAPACITY
+/// Number of nodes stored inside the index sublists of the constraint stores before they spill to the heap (0, the default, to disable, see chr::Bt_list)
+#define CHR_INDEX_INLINE_CAPACITY 0
+#endif
+
 // Forward declaration
 namespace tests {
 	namespace bt_list {
@@ -86,19 +106,62 @@ namespace chr {
 	 *
 	 * Each Bt_list is backtrackable. Modifications of the list are recorded and undone
 	 * when the list is rewind to a previous backtrack depth.
+	 *
+	 * By default (SEGMENT_BITS = 0), the nodes are stored in a single array which
+	 * doubles its size when it is full: all nodes are moved at each growth.
+	 * When SEGMENT_BITS > 0, the nodes are stored in segments of 2^SEGMENT_BITS nodes.
+	 * The high bits of a PID give the segment and the low bits the node in the segment.
+	 * A new segment is added when the list is full, existing nodes are never moved:
+	 * the growth of a large list is cheap and references to nodes remain valid.
+	 * As a segment is allocated in one block, it better suits large lists
+	 * (the constraint stores use CHR_STORE_SEGMENT_BITS).
+	 *
+	 * By default (SOA = false), an element is stored inside its node, together with
+	 * the status and the links of the node. When SOA is true (structure of arrays),
+	 * the elements are stored in a separate array (or segments) indexed by the same
+	 * PIDs: browsing the list and checking if a node is alive only touch the small
+	 * nodes, which better suits lists of large elements (the constraint stores
+	 * use CHR_STORE_SOA, the store-traversal check of the stores example times
+	 * both layouts).
+	 *
+	 * When INLINE_CAPACITY > 0, the first INLINE_CAPACITY nodes are stored inside
+	 * the Bt_list object itself: a small list needs no allocation of its own.
+	 * The nodes spill to a heap array (which then doubles as usual) when the
+	 * list grows beyond the inline buffer. It is only available for contiguous
+	 * lists of trivially copyable elements (the index sublists of the constraint
+	 * stores use CHR_INDEX_INLINE_CAPACITY, the inline-sublists check of the stores
+	 * example compares the spill with a list without inline nodes).
+	 *
+	 * A contiguous list (no SEGMENT_BITS, no SOA, no INLINE_CAPACITY) of relocatable
+	 * elements (see chr::Is_image_relocatable) can be written to a binary image
+	 * (write_image()). As nodes are linked by PIDs, the nodes of an image can be used
+	 * in place by another list (map_image()), for example from a memory mapped file:
+	 * the list doesn't own these nodes, they are copied to an allocated array at the
+	 * first reallocation of the list.
 	 */
-	template< typename T, bool ENABLE_BACKTRACK = true, bool SAFE_DELETE = false, unsigned int STATISTICS_T = chr::Statistics::OTHER, typename Allocator_t = std::allocator< T > >
+	template< typename T, bool ENABLE_BACKTRACK = true, bool SAFE_DELETE = false, unsigned int STATISTICS_T = chr::Statistics::OTHER, typename Allocator_t = std::allocator< T >, unsigned int SEGMENT_BITS = 0, bool SOA = false, unsigned int INLINE_CAPACITY = 0 >
 	class Bt_list
 	{
 	public:
 		typedef T Value_t;
 		typedef std::uint32_t PID_t;
-		typedef class Bt_list_iterator< Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t > > iterator;
+		typedef class Bt_list_iterator< Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY > > iterator;
 		typedef Allocator_t _Allocator_t; // Shortcut to access template parameter from outside the class
 
 		static constexpr bool _ENABLE_BACKTRACK = ENABLE_BACKTRACK;
 		static constexpr bool _SAFE_DELETE = SAFE_DELETE;
 		static constexpr unsigned int _STATISTICS_T = STATISTICS_T;
+		static constexpr unsigned int _SEGMENT_BITS = SEGMENT_BITS;
+		static constexpr bool SEGMENTED = (SEGMENT_BITS > 0);
+		static constexpr std::size_t SEGMENT_SIZE = std::size_t(1) << SEGMENT_BITS;
+		static constexpr PID_t SEGMENT_MASK = static_cast< PID_t >(SEGMENT_SIZE - 1);
+		static_assert(SEGMENT_BITS < 32, "SEGMENT_BITS must be lower than the number of bits of PID_t");
+		static constexpr bool _SOA = SOA;
+		static constexpr unsigned int _INLINE_CAPACITY = INLINE_CAPACITY;
+		static constexpr bool INLINE = (INLINE_CAPACITY > 0);
+		static_assert(!INLINE || (!SEGMENTED && !SOA && std::is_trivially_copyable_v< T >), "INLINE_CAPACITY requires a contiguous list (no SEGMENT_BITS, no SOA) of trivially copyable elements");
+		static_assert(INLINE_CAPACITY != 1, "INLINE_CAPACITY must be 0 or at least 2 (a rollback point needs two free slots)");
+		static constexpr bool IMAGE = !SEGMENTED && !SOA && !INLINE;
 		static constexpr unsigned int NB_SPECIAL_SLOTS = 1;
 		static constexpr PID_t END_LIST = ~0u;
 
@@ -116,13 +179,18 @@ namespace chr {
 		template < typename TT > friend class Logical_var_imp;
 		template < typename TT, bool RANGE > friend class Interval;
 		template < typename TT, typename TupIndexes, bool C_ENABLE_BACKTRACK > friend class Constraint_store_index;
-		friend class Bt_list_iterator< Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t > >;
+		friend class Bt_list_iterator< Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY > >;
 		// Friend for Unit tests
 		friend void tests::bt_list::insert_remove_tests();
 		friend void tests::bt_list::iterators();
 		friend void tests::bt_list::backtrack_tests();
 		friend void tests::bt_list::replace_backtrack_tests();
 	public:
+		/**
+		 * Element stored inside a node when SOA is true (the element is stored apart)
+		 */
+		struct No_element { };
+
 		/**
 		 * Bt_list is composed of linked Node(s)
 		 */
@@ -152,7 +220,7 @@ namespace chr {
 						struct
 						{
 							PID_t _next;				///< Link to next node
-							T _e;						///< Element stored in the node
+							std::conditional_t< SOA, No_element, T > _e;	///< Element stored in the node (if not SOA)
 						};
 						/**
 						 * Struct used for closure slot.
@@ -210,6 +278,34 @@ namespace chr {
 			~Node() {}
 		};
 
+		/**
+		 * Header of the binary image of a list (see write_image()), the nodes follow
+		 * at offset IMAGE_NODES_OFFSET.
+		 */
+		struct Image_header
+		{
+			char _magic[8];						///< Magic string of a list image
+			std::uint32_t _version;				///< Version of the image format
+			std::uint32_t _node_size;			///< Size of a node
+			std::uint64_t _type_hash;			///< Hash of the type of the nodes
+			std::uint64_t _tag;					///< Value given by the writer of the image
+			PID_t _first;						///< First node of the list
+			PID_t _last;						///< Last node of the list
+			PID_t _first_unused_pid;			///< First unused pid of the list (number of nodes of the image)
+			PID_t _first_free;					///< First free node
+			std::uint32_t _size;				///< Number of elements of the list
+			std::uint32_t _nb_free;				///< Number of free nodes (if SAFE_DELETE)
+		};
+		static constexpr std::size_t IMAGE_NODES_OFFSET = ((sizeof(Image_header) + 63) / 64) * 64;	///< Offset of the nodes in an image
+
+		/**
+		 * Buffer of nodes stored inside the list when INLINE is true
+		 */
+		struct Inline_nodes
+		{
+			alignas(Node) unsigned char _buffer[sizeof(Node) * INLINE_CAPACITY];	///< Raw storage of the inline nodes
+		};
+
 	public:
 		/**
 		 * Initialize.
@@ -221,9 +317,12 @@ namespace chr {
 			  _first_free(END_LIST),
 			  _first_rewind(END_LIST),
 			  _size(0),
+			  _nb_locks(0),
 			  _backtrack_depth(Backtrack::depth()),
 			  _capacity(0),
-			  _data(nullptr)
+			  _data(nullptr),
+			  _values(),
+			  _image()
 		{ }
 
 		/**
@@ -243,18 +342,25 @@ namespace chr {
 			  _first_free(o._first_free),
 			  _first_rewind(o._first_rewind),
 			  _size(o._size),
+			  _nb_locks(o._nb_locks),
 			  _backtrack_depth(o._backtrack_depth),
 			  _capacity(o._capacity),
-			  _data(o._data)
+			  _data(o._data),
+			  _values(o._values),
+			  _image(o._image)
 		{
+			take_inline_nodes(o);
 			o._first = END_LIST;
 			o._last = END_LIST;
 			o._first_unused_pid = 0;
 			o._first_free = END_LIST;
 			o._first_rewind = END_LIST;
 			o._size = 0;
+			o._nb_locks = 0;
 			o._capacity = 0;
 			o._data = nullptr;
+			o._values = Values_t();
+			o._image = Image_t();
 			if constexpr (SAFE_DELETE)
 			{
 				extra._nb_free = o.extra._nb_free;
@@ -284,17 +390,24 @@ namespace chr {
 			_first_free = o._first_free;
 			_first_rewind = o._first_rewind;
 			_size = o._size;
+			_nb_locks = o._nb_locks;
 			_backtrack_depth = o._backtrack_depth;
 			_capacity = o._capacity;
 			_data = o._data;
+			_values = o._values;
+			_image = o._image;
+			take_inline_nodes(o);
 			o._first = END_LIST;
 			o._last = END_LIST;
 			o._first_unused_pid = 0;
 			o._first_free = END_LIST;
 			o._first_rewind = END_LIST;
 			o._size = 0;
+			o._nb_locks = 0;
 			o._capacity = 0;
 			o._data = nullptr;
+			o._values = Values_t();
+			o._image = Image_t();
 			return *this;
 		}
 
@@ -334,13 +447,19 @@ namespace chr {
 		 */
 		bool has_rollback_point() const { return (_first_rewind != END_LIST); }
 
+		/**
+		 * Check if a node of the list is locked by an iterator.
+		 * @return True if a node is locked, false otherwise
+		 */
+		bool has_locked_node() const { return (_nb_locks > 0); }
+
 		/**
 		 * Return the current element at index \a p
 		 * @param p The index of the element to retrieve
 		 * @return A const reference to the element pointed
 		 */
 		const T& get(PID_t p) const {
-			return _data[p]._e;
+			return value(p);
 		}
 
 		/**
@@ -422,7 +541,7 @@ namespace chr {
 		 */
 		bool alive(PID_t p) const
 		{
-			return _data[p]._status == ALIVE;
+			return node(p)._status == ALIVE;
 		}
 
 		/**
@@ -437,6 +556,66 @@ namespace chr {
 		template< bool EB = ENABLE_BACKTRACK >
 		std::enable_if_t<EB, bool> rewind(Depth_t previous_depth, Depth_t new_depth);
 
+		/**
+		 * Make room for \a n more elements (and a rollback point), so that they can
+		 * be inserted without reallocation of the list.
+		 * @param n The number of elements to make room for
+		 */
+		void reserve(std::size_t n);
+
+		/**
+		 * Compact the list: the alive elements are renumbered contiguously in the
+		 * order of the list and the capacity is shrunk to fit them. The free slots
+		 * left by the removed elements are thus given back.
+		 * It is only possible when the list has no rollback point (the depth of all
+		 * rollback points has been left) and when no node is locked by an iterator.
+		 * The PIDs of the elements change: \a remap gives the new PID of each
+		 * old PID (END_LIST for a free slot) and must be used to update the PIDs
+		 * kept outside of the list.
+		 * @param remap The table which maps the old PIDs to the new ones
+		 * @return True if the list has been compacted, false otherwise (the list is unchanged)
+		 */
+		bool compact(std::vector< PID_t >& remap);
+
+		/**
+		 * Write the binary image of the list to \a os: a header (Image_header) followed
+		 * by the nodes, as they are in memory. It is only possible when the list has
+		 * no rollback point and when no node is locked by an iterator. The write_image()
+		 * member function exists only if IMAGE is true and if the elements are relocatable.
+		 * @param os The output stream (opened in binary mode)
+		 * @param tag A value kept in the image (returned by map_image())
+		 * @return True if the image has been written, false otherwise
+		 */
+		template< bool I = IMAGE >
+		std::enable_if_t<I && chr::Is_image_relocatable<T>::value, bool> write_image(std::ostream& os, std::uint64_t tag = 0) const;
+
+		/**
+		 * Use the nodes of the image \a data (see write_image()) as the nodes of this
+		 * list, without copy. The list must be empty and not allocated. The memory of
+		 * the image must be writable (nodes are locked by iterators), aligned for a
+		 * Node and it must outlive the list (or its next reallocation).
+		 * The map_image() member function exists only if IMAGE is true and if the
+		 * elements are relocatable.
+		 * @param data The image (its header)
+		 * @param size The size of the image
+		 * @param tag The value given to write_image()
+		 * @return True if the image has been mapped, false if it is not an image of this type of list
+		 */
+		template< bool I = IMAGE >
+		std::enable_if_t<I && chr::Is_image_relocatable<T>::value, bool> map_image(char* data, std::size_t size, std::uint64_t& tag);
+
+		/**
+		 * Check if the nodes of the list are the nodes of an image (see map_image()).
+		 * @return True if the nodes are mapped from an image, false otherwise
+		 */
+		bool is_mapped() const
+		{
+			if constexpr (IMAGE)
+				return _image._mapped;
+			else
+				return false;
+		}
+
 		/**
 		 * Return a string representation of the list. Useful for debugging
 		 * purpose.
@@ -461,6 +640,23 @@ namespace chr {
 			// exists, there is some pid used to store values to remember and _first_unused_pid > _nb_free
 			return _first_unused_pid == extra._nb_free;
 		}
+
+		/**
+		 * Prepare a list which can be safely deleted (see safe_delete()) to be
+		 * reused at the current backtrack depth, as if it was a new list.
+		 * The allocated nodes are kept.
+		 * The recycle() member function exists only if SAFE_DELETE is true. Otherwise,
+		 * SFINAE disables it.
+		 */
+		template< bool SD = SAFE_DELETE >
+		std::enable_if_t<SD, void> recycle() {
+			assert(safe_delete() && empty());
+			// All slots are free: forget the free list and start again from the first slot
+			_first_unused_pid = 0;
+			_first_free = END_LIST;
+			extra._nb_free = 0;
+			_backtrack_depth = Backtrack::depth();
+		}
 	protected:
 		PID_t _first;								    ///< First node of the list
 		PID_t _last;								    ///< Last node of the list
@@ -468,10 +664,23 @@ namespace chr {
 		PID_t _first_free;							    ///< First free node
 		PID_t _first_rewind;						    ///< The pid of the first element to rewind
 		unsigned int _size;						        ///< The number of elements in the list
+		unsigned int _nb_locks;						    ///< The number of locks of nodes held by iterators (see has_locked_node())
 		Depth_t _backtrack_depth;					    ///< The depth which is relevant to this list (snapshot)
 
 		std::size_t _capacity;						    ///< The allocated size for data
-		Node* _data;								    ///< Data (nodes) of the list
+		/// Data of the list: the array of nodes, or the table of segments if SEGMENTED
+		using Data_t = std::conditional_t< SEGMENTED, Node**, Node* >;
+		Data_t _data;								    ///< Data (nodes) of the list
+		/// Elements of the list if SOA: the array of elements, or the table of segments if SEGMENTED
+		using Values_t = std::conditional_t< SOA, std::conditional_t< SEGMENTED, T**, T* >, No_element >;
+		[[no_unique_address]] Values_t _values;		    ///< Elements of the list (if SOA)
+		/// Nodes stored inside the list if INLINE
+		using Inline_t = std::conditional_t< INLINE, Inline_nodes, No_element >;
+		[[no_unique_address]] Inline_t _inline;		    ///< Inline buffer of nodes (if INLINE)
+		/// State of the image of the list if IMAGE
+		struct Image_state { bool _mapped = false; };
+		using Image_t = std::conditional_t< IMAGE, Image_state, No_element >;
+		[[no_unique_address]] Image_t _image;		    ///< True if the nodes are mapped from an image (if IMAGE)
 
 		Extra<SAFE_DELETE> extra;						///< Number of free elements (size of the free list)
 
@@ -479,7 +688,110 @@ namespace chr {
 		 * Return the node pointed by the pid \a p
 		 * @param p The PID of the node to return
 		 */
-		const Node& data(PID_t p) const { return _data[p]; }
+		const Node& data(PID_t p) const { return node(p); }
+
+		/**
+		 * Return the node pointed by the pid \a p. The node is not constant,
+		 * the same way as the nodes pointed by _data.
+		 * @param p The PID of the node to return
+		 */
+		Node& node(PID_t p) const
+		{
+			if constexpr (SEGMENTED)
+				return _data[p >> SEGMENT_BITS][p & SEGMENT_MASK];
+			else
+				return _data[p];
+		}
+
+		/**
+		 * Return the element of the node pointed by the pid \a p.
+		 * @param p The PID of the node
+		 */
+		T& value(PID_t p) const
+		{
+			if constexpr (!SOA)
+				return node(p)._e;
+			else if constexpr (SEGMENTED)
+				return _values[p >> SEGMENT_BITS][p & SEGMENT_MASK];
+			else
+				return _values[p];
+		}
+
+		/**
+		 * Return the first node of the inline buffer.
+		 * @return The inline nodes (nullptr if not INLINE)
+		 */
+		Node* inline_nodes() const
+		{
+			if constexpr (INLINE)
+				return reinterpret_cast< Node* >(const_cast< unsigned char* >(_inline._buffer));
+			else
+				return nullptr;
+		}
+
+		/**
+		 * Check if the nodes of the list are stored in its inline buffer.
+		 * @return True if the nodes are inline, false otherwise
+		 */
+		bool is_inline() const
+		{
+			if constexpr (INLINE)
+				return (_data != nullptr) && (_data == inline_nodes());
+			else
+				return false;
+		}
+
+		/**
+		 * Copy the inline nodes of \a o to the inline buffer of this list if \a o
+		 * stores its nodes inline. Called when the data of \a o have been moved
+		 * to this list (o._data is still set).
+		 * @param o The list moved to this one
+		 */
+		void take_inline_nodes(const Bt_list& o)
+		{
+			if constexpr (INLINE)
+				if (o.is_inline())
+				{
+					std::memcpy(_inline._buffer, o._inline._buffer, sizeof(Node) * o._first_unused_pid);
+					_data = inline_nodes();
+				}
+		}
+
+		/**
+		 * Return the hash of the type of the nodes, used to check that an image
+		 * has been written by the same type of list.
+		 * @return The hash value
+		 */
+		static std::uint64_t image_type_hash()
+		{
+			return std::hash< std::string_view >()(typeid(Node).name());
+		}
+
+		/**
+		 * Return the number of entries allocated for the table of segments
+		 * when the list has \a nb_segments segments (the table doubles its size when full).
+		 * @param nb_segments The number of segments
+		 * @return The capacity of the table of segments
+		 */
+		static std::size_t segment_table_capacity(std::size_t nb_segments)
+		{
+			std::size_t c = 0;
+			if (nb_segments > 0)
+				for (c = 1; c < nb_segments; c *= 2) { }
+			return c;
+		}
+
+		/**
+		 * Allocate the nodes (and the table of segments) of an empty list.
+		 * @param capacity The number of nodes to allocate (a multiple of SEGMENT_SIZE if SEGMENTED)
+		 */
+		void allocate_list(std::size_t capacity);
+
+		/**
+		 * Free the nodes (and the table of segments) of the list. The elements must
+		 * have been destroyed before.
+		 */
+		void deallocate_list();
 
 		/**
 		 * Set a slot to be a free one. It may be reused for a further add.
@@ -488,9 +800,11 @@ namespace chr {
 		void free(PID_t p);
 
 		/**
-		 * Reallocate list (the first unused pid have to reach the capacity of the list).
+		 * Reallocate list (the first unused pid have to reach the capacity of the list,
+		 * unless a minimum capacity is given).
+		 * @param min_capacity The minimum capacity of the list after the reallocation (0 for the next growth step)
 		 */
-		void reallocate_list();
+		void reallocate_list(std::size_t min_capacity = 0);
 
 		/**
 		 * Increment the number of observers of slot \a p.
@@ -498,10 +812,10 @@ namespace chr {
 		 */
 		void do_inc_obs_count(PID_t p)
 		{
-			assert(_data[ p ]._status == ALIVE);
+			assert(node(p)._status == ALIVE);
 			// Lock only if it is not part of backtrackable elements
 			if ((_first_rewind == END_LIST) || (p > _first_rewind))
-				++_data[p]._obs_count;
+				++node(p)._obs_count;
 		}
 
 		/**
@@ -513,6 +827,7 @@ namespace chr {
 		{
 			// Test if we need to start a new rollback point
 			create_rollback_point();
+			++_nb_locks;
 			do_inc_obs_count(p);
 		}
 
@@ -525,12 +840,14 @@ namespace chr {
 		{
 			// Test if we need to start a new rollback point
 			create_rollback_point();
+			assert(_nb_locks > 0);
+			--_nb_locks;
 
 			// Unlock only if it is not part of backtrackable elements
 			if ((_first_rewind == END_LIST) || (p > _first_rewind))
 			{
-				assert(_data[p]._obs_count > 0);
-				--_data[p]._obs_count;
+				assert(node(p)._obs_count > 0);
+				--node(p)._obs_count;
 			}
 		}
 
@@ -546,7 +863,7 @@ namespace chr {
 	 */
 	template< typename Bt_list_t >
 	class Bt_list_iterator {
-		friend class Bt_list< typename Bt_list_t::Value_t, Bt_list_t::_ENABLE_BACKTRACK, Bt_list_t::_SAFE_DELETE, Bt_list_t::_STATISTICS_T, typename Bt_list_t::_Allocator_t >;
+		friend class Bt_list< typename Bt_list_t::Value_t, Bt_list_t::_ENABLE_BACKTRACK, Bt_list_t::_SAFE_DELETE, Bt_list_t::_STATISTICS_T, typename Bt_list_t::_Allocator_t, Bt_list_t::_SEGMENT_BITS, Bt_list_t::_SOA, Bt_list_t::_INLINE_CAPACITY >;
 	public:
 		/**
 		 * Copy constructor set default.
@@ -571,7 +888,7 @@ namespace chr {
 		const typename Bt_list_t::Value_t& operator*() const
 		{
 			assert(_current != Bt_list_t::END_LIST);
-			return _list._data[_current]._e;
+			return _list.value(_current);
 		}
 
 		/**
@@ -590,7 +907,7 @@ namespace chr {
 		Bt_list_iterator& operator++()
 		{
 			assert(_current != Bt_list_t::END_LIST);
-			_current = _list._data[_current]._next;
+			_current = _list.node(_current)._next;
 			return *this;
 		}
 
@@ -622,7 +939,7 @@ namespace chr {
 		{
 			assert(_current != Bt_list_t::END_LIST);
 			_list.dec_obs_count(_current);
-			if (_list._data[_current]._status == Bt_list_t::REMOVE)
+			if (_list.node(_current)._status == Bt_list_t::REMOVE)
 				_list.free(_current);
 		}
 
@@ -637,7 +954,7 @@ namespace chr {
 			auto p =_current;
 			next_alive();
 			_list.dec_obs_count(p);
-			if (_list._data[p]._status == Bt_list_t::REMOVE)
+			if (_list.node(p)._status == Bt_list_t::REMOVE)
 				_list.free(p);
 		}
 
@@ -647,17 +964,17 @@ namespace chr {
 		void next_alive()
 		{
 			assert(_current != Bt_list_t::END_LIST);
-			if (_list._data[_current]._status == Bt_list_t::ALIVE)
+			if (_list.node(_current)._status == Bt_list_t::ALIVE)
 			{
 				// Go to next element
-				_current = _list._data[_current]._next;
+				_current = _list.node(_current)._next;
 			} else {
 				// If the underlying element is not alive, we go to the next living one.
 				while ( (_current != Bt_list_t::END_LIST)
-						&& (_list._data[ _current ]._status != Bt_list_t::ALIVE))
+						&& (_list.node(_current)._status != Bt_list_t::ALIVE))
 				{
-					assert((_list._data[_current]._status == Bt_list_t::REMOVE) || _list._data[_current]._status == Bt_list_t::BACKTRACK);
-					_current = _list._data[_current]._next;
+					assert((_list.node(_current)._status == Bt_list_t::REMOVE) || _list.node(_current)._status == Bt_list_t::BACKTRACK);
+					_current = _list.node(_current)._next;
 				}
 			}
 		}
@@ -692,7 +1009,7 @@ namespace chr {
 		bool valid() const
 		{
 			assert(_current != Bt_list_t::END_LIST);
-			return _list._data[_current]._status == Bt_list_t::ALIVE;
+			return _list.node(_current)._status == Bt_list_t::ALIVE;
 		}
 
 		/**
@@ -702,7 +1019,7 @@ namespace chr {
 		unsigned int status() const
 		{
 			assert(_current != Bt_list_t::END_LIST);
-			return _list._data[_current]._status;
+			return _list.node(_current)._status;
 		}
 
 		/**
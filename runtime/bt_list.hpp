@@ -25,24 +25,116 @@ namespace chr
 	/*
 	 * Bt_list
 	 */
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::~Bt_list()
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::~Bt_list()
 	{
 		if constexpr (NEED_DESTROY)
 		{
-			for (Node* p = _data; p != (_data + _first_unused_pid); ++p)
+			for (PID_t i = 0; i != _first_unused_pid; ++i)
 			{
-				if (p->_status < REMOVE)
-					std::destroy_at(std::addressof(p->_e)); // Call the destructor of _e
+				if (node(i)._status < REMOVE)
+					std::destroy_at(std::addressof(value(i))); // Call the destructor of _e
 			}
 		}
+		deallocate_list();
+	}
+
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::deallocate_list()
+	{
 		typename Node::Allocator na;
-		na.deallocate(_data,_capacity);
-		Statistics::dec_memory<STATISTICS_T>(sizeof(Node)*_capacity);
+		if constexpr (SEGMENTED)
+		{
+			using Table_allocator = typename std::allocator_traits< Allocator_t >::template rebind_alloc< Node* >;
+			const std::size_t nb_segments = _capacity >> SEGMENT_BITS;
+			for (std::size_t i = 0; i < nb_segments; ++i)
+				na.deallocate(_data[i],SEGMENT_SIZE);
+			if (_data != nullptr)
+			{
+				Table_allocator ta;
+				ta.deallocate(_data,segment_table_capacity(nb_segments));
+			}
+			Statistics::dec_memory<STATISTICS_T>(sizeof(Node)*_capacity + sizeof(Node*)*segment_table_capacity(nb_segments));
+		} else if (!is_inline() && !is_mapped()) {
+			na.deallocate(_data,_capacity);
+			Statistics::dec_memory<STATISTICS_T>(sizeof(Node)*_capacity);
+		}
+		if constexpr (SOA)
+		{
+			Allocator_t va;
+			if constexpr (SEGMENTED)
+			{
+				using Value_table_allocator = typename std::allocator_traits< Allocator_t >::template rebind_alloc< T* >;
+				const std::size_t nb_segments = _capacity >> SEGMENT_BITS;
+				for (std::size_t i = 0; i < nb_segments; ++i)
+					va.deallocate(_values[i],SEGMENT_SIZE);
+				if (_values != nullptr)
+				{
+					Value_table_allocator ta;
+					ta.deallocate(_values,segment_table_capacity(nb_segments));
+				}
+				Statistics::dec_memory<STATISTICS_T>(sizeof(T)*_capacity + sizeof(T*)*segment_table_capacity(nb_segments));
+			} else {
+				va.deallocate(_values,_capacity);
+				Statistics::dec_memory<STATISTICS_T>(sizeof(T)*_capacity);
+			}
+			_values = nullptr;
+		}
+		_data = nullptr;
+		_capacity = 0;
+		_image = Image_t();
+	}
+
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::allocate_list(std::size_t capacity)
+	{
+		assert((_data == nullptr) && (_capacity == 0));
+		typename Node::Allocator na;
+		if constexpr (SEGMENTED)
+		{
+			using Table_allocator = typename std::allocator_traits< Allocator_t >::template rebind_alloc< Node* >;
+			Table_allocator ta;
+			const std::size_t nb_segments = capacity >> SEGMENT_BITS;
+			if (nb_segments > 0)
+			{
+				_data = ta.allocate(segment_table_capacity(nb_segments));
+				for (std::size_t i = 0; i < nb_segments; ++i)
+					_data[i] = na.allocate(SEGMENT_SIZE);
+			}
+			Statistics::inc_memory<STATISTICS_T>(sizeof(Node)*capacity + sizeof(Node*)*segment_table_capacity(nb_segments));
+		} else if (INLINE && (capacity > 0) && (capacity <= INLINE_CAPACITY)) {
+			// The nodes fit in the inline buffer
+			_data = inline_nodes();
+			capacity = INLINE_CAPACITY;
+		} else if (capacity > 0) {
+			_data = na.allocate(capacity);
+			Statistics::inc_memory<STATISTICS_T>(sizeof(Node)*capacity);
+		}
+		if constexpr (SOA)
+		{
+			Allocator_t va;
+			if constexpr (SEGMENTED)
+			{
+				using Value_table_allocator = typename std::allocator_traits< Allocator_t >::template rebind_alloc< T* >;
+				Value_table_allocator ta;
+				const std::size_t nb_segments = capacity >> SEGMENT_BITS;
+				if (nb_segments > 0)
+				{
+					_values = ta.allocate(segment_table_capacity(nb_segments));
+					for (std::size_t i = 0; i < nb_segments; ++i)
+						_values[i] = va.allocate(SEGMENT_SIZE);
+				}
+				Statistics::inc_memory<STATISTICS_T>(sizeof(T)*capacity + sizeof(T*)*segment_table_capacity(nb_segments));
+			} else if (capacity > 0) {
+				_values = va.allocate(capacity);
+				Statistics::inc_memory<STATISTICS_T>(sizeof(T)*capacity);
+			}
+		}
+		_capacity = capacity;
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t > Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::clone() const
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY > Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::clone() const
 	{
 		using _Alloc_traits = std::allocator_traits< typename Node::Allocator >;
 		typename Node::Allocator na;
@@ -54,79 +146,281 @@ namespace chr
 		bl._first_free = _first_free;
 		bl._first_rewind = _first_rewind;
 		bl._size = _size;
+		bl._nb_locks = _nb_locks;
 		bl._backtrack_depth = _backtrack_depth;
-		bl._capacity = _capacity;
-	
-		bl._data = na.allocate(_capacity);
-		assert( bl._data );
+		bl.allocate_list(_capacity);
+		assert( bl._data || (_capacity == 0) );
 		if (_data != nullptr)
 		{
 			assert(_capacity > 0);
-			Node* p = _data;
-			Node* p_last = _data + _first_unused_pid;
-			Node* p_dest = bl._data;
-			for (; p != p_last; ++p, (void)++p_dest)
+			for (PID_t i = 0; i != _first_unused_pid; ++i)
 			{
-				if (p->_status > BACKTRACK)
-					std::memcpy((char*)p_dest, (char*)p, sizeof(Node));
+				Node& n = node(i);
+				if (n._status > BACKTRACK)
+					std::memcpy((char*)&bl.node(i), (char*)&n, sizeof(Node));
 				else
-					_Alloc_traits::construct(na, p_dest, std::move(*p));
+				{
+					_Alloc_traits::construct(na, &bl.node(i), std::move(n));
+					if constexpr (SOA)
+					{
+						Allocator_t va;
+						std::allocator_traits< Allocator_t >::construct(va, &bl.value(i), std::move(value(i)));
+					}
+				}
 			}
 		}
 		return bl; // bl is implicity moved, no copy constructor exists
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	typename Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::iterator Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::begin()
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::reserve(std::size_t n)
 	{
-		return Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::iterator(*this);
+		const std::size_t capacity = _first_unused_pid + n + NB_SPECIAL_SLOTS;
+		if (capacity > _capacity)
+			reallocate_list(capacity);
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	typename Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::iterator Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::end()
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	bool Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::compact(std::vector< PID_t >& remap)
 	{
-		return Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::iterator(*this,END_LIST);
+		if (has_rollback_point()) return false;
+		// A locked node is referenced by an iterator which cannot be updated
+		if (has_locked_node()) return false;
+
+		// Without rollback point, there is no BACKTRACK, BACKTRACK_CLOSURE or SPECIAL node
+		// and all REMOVE nodes are free: only the ALIVE nodes are kept.
+		std::size_t capacity = _size;
+		if constexpr (SEGMENTED)
+			capacity = ((capacity + SEGMENT_SIZE - 1) >> SEGMENT_BITS) << SEGMENT_BITS;
+		Bt_list bl;
+		bl.allocate_list(capacity);
+		remap.assign(_first_unused_pid, END_LIST);
+		Allocator_t a;
+		PID_t n = 0;
+		for (PID_t p = _first; p != END_LIST; p = node(p)._next, ++n)
+		{
+			assert(node(p)._status == ALIVE);
+			remap[p] = n;
+			Node& d = bl.node(n);
+			d._status = ALIVE;
+			d._obs_count = 0;
+			d._prev = (n == 0) ? END_LIST : (n - 1);
+			d._next = n + 1;
+			std::allocator_traits< Allocator_t >::construct(a, &bl.value(n), std::move(value(p)) );
+		}
+		assert(n == _size);
+		if (n > 0)
+		{
+			bl.node(n - 1)._next = END_LIST;
+			bl._first = 0;
+			bl._last = n - 1;
+		}
+		bl._first_unused_pid = n;
+		bl._size = n;
+		bl._backtrack_depth = _backtrack_depth;
+
+		// The old nodes (with the moved elements) are destroyed with bl
+		std::swap(*this, bl);
+		if constexpr (SAFE_DELETE)
+			extra._nb_free = 0;
+		return true;
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::reallocate_list()
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	template< bool I >
+	std::enable_if_t<I && chr::Is_image_relocatable<T>::value, bool> Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::write_image(std::ostream& os, std::uint64_t tag) const
+	{
+		if (has_rollback_point() || has_locked_node()) return false;
+
+		std::array< char, IMAGE_NODES_OFFSET > buffer{};
+		Image_header h;
+		std::memset(&h, 0, sizeof(h));
+		std::memcpy(h._magic, "CHRPPBTL", sizeof(h._magic));
+		h._version = 1;
+		h._node_size = sizeof(Node);
+		h._type_hash = image_type_hash();
+		h._tag = tag;
+		h._first = _first;
+		h._last = _last;
+		h._first_unused_pid = _first_unused_pid;
+		h._first_free = _first_free;
+		h._size = _size;
+		if constexpr (SAFE_DELETE)
+			h._nb_free = extra._nb_free;
+		std::memcpy(buffer.data(), &h, sizeof(h));
+		os.write(buffer.data(), IMAGE_NODES_OFFSET);
+		if (_first_unused_pid > 0)
+			os.write(reinterpret_cast< const char* >(_data), sizeof(Node) * _first_unused_pid);
+		return static_cast< bool >(os);
+	}
+
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	template< bool I >
+	std::enable_if_t<I && chr::Is_image_relocatable<T>::value, bool> Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::map_image(char* data, std::size_t size, std::uint64_t& tag)
+	{
+		assert((_first_unused_pid == 0) && (_data == nullptr) && (_capacity == 0));
+		if ((data == nullptr) || (size < IMAGE_NODES_OFFSET) || ((reinterpret_cast< std::uintptr_t >(data) % alignof(Node)) != 0))
+			return false;
+		Image_header h;
+		std::memcpy(&h, data, sizeof(h));
+		if ((std::memcmp(h._magic, "CHRPPBTL", sizeof(h._magic)) != 0) || (h._version != 1)
+				|| (h._node_size != sizeof(Node)) || (h._type_hash != image_type_hash())
+				|| (size < (IMAGE_NODES_OFFSET + sizeof(Node) * std::size_t(h._first_unused_pid))))
+			return false;
+
+		tag = h._tag;
+		_first = h._first;
+		_last = h._last;
+		_first_unused_pid = h._first_unused_pid;
+		_first_free = h._first_free;
+		_first_rewind = END_LIST;
+		_size = h._size;
+		_backtrack_depth = Backtrack::depth();
+		if constexpr (SAFE_DELETE)
+			extra._nb_free = h._nb_free;
+		if (_first_unused_pid > 0)
+		{
+			// The list is full: the next insertion reallocates the nodes
+			_data = reinterpret_cast< Node* >(data + IMAGE_NODES_OFFSET);
+			_capacity = _first_unused_pid;
+			_image._mapped = true;
+		}
+		return true;
+	}
+
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	typename Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::iterator Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::begin()
+	{
+		return Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::iterator(*this);
+	}
+
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	typename Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::iterator Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::end()
+	{
+		return Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::iterator(*this,END_LIST);
+	}
+
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::reallocate_list(std::size_t min_capacity)
 	{
 		if constexpr (NB_SPECIAL_SLOTS == 1)
-			assert((_first_unused_pid == _capacity) || ((_first_unused_pid + 1) == _capacity));
+			assert((min_capacity > 0) || (_first_unused_pid == _capacity) || ((_first_unused_pid + 1) == _capacity));
 		else 
 			static_assert(true,"NB_SPECIAL_SLOTS > 1, if statement must be updated");
 
 		using _Alloc_traits = std::allocator_traits< typename Node::Allocator >;
 		typename Node::Allocator na;
-		// Capacity is not enough, reallocate
-		std::size_t max_capacity = _Alloc_traits::max_size(na);
-		const std::size_t foreseen_capacity = (_capacity == 0)?4:2 * _capacity; // We try to double size
-		const std::size_t new_capacity = (foreseen_capacity > max_capacity) ? max_capacity : foreseen_capacity;
-
-		Node *new_data = na.allocate(new_capacity);
-		assert( new_data );
-		if (_data != nullptr)
+		if constexpr (SEGMENTED)
 		{
-			assert(_capacity > 0);
-			Node* p = _data;
-			Node* p_last = _data + _first_unused_pid;
-			Node* p_dest = new_data;
-			for (; p != p_last; ++p, (void)++p_dest)
+			do {
+				// Add a new segment, the nodes of the other segments are not moved
+				using Table_allocator = typename std::allocator_traits< Allocator_t >::template rebind_alloc< Node* >;
+				const std::size_t nb_segments = _capacity >> SEGMENT_BITS;
+				assert((nb_segments + 1) <= ((std::size_t(END_LIST) + 1) >> SEGMENT_BITS));
+				const std::size_t table_capacity = segment_table_capacity(nb_segments);
+				if (table_capacity == nb_segments)
+				{
+					// The table of segments is full, only the pointers to segments are moved
+					Table_allocator ta;
+					const std::size_t new_table_capacity = segment_table_capacity(nb_segments + 1);
+					Node** new_table = ta.allocate(new_table_capacity);
+					assert( new_table );
+					if (_data != nullptr)
+					{
+						std::memcpy(new_table, _data, sizeof(Node*)*nb_segments);
+						ta.deallocate(_data,table_capacity);
+					}
+					Statistics::inc_memory<STATISTICS_T>(sizeof(Node*)*(new_table_capacity - table_capacity));
+					_data = new_table;
+				}
+				_data[nb_segments] = na.allocate(SEGMENT_SIZE);
+				assert( _data[nb_segments] );
+				Statistics::inc_memory<STATISTICS_T>(sizeof(Node)*SEGMENT_SIZE);
+				if constexpr (SOA)
+				{
+					// Same for the segments of elements
+					using Value_table_allocator = typename std::allocator_traits< Allocator_t >::template rebind_alloc< T* >;
+					Allocator_t va;
+					if (table_capacity == nb_segments)
+					{
+						Value_table_allocator ta;
+						const std::size_t new_table_capacity = segment_table_capacity(nb_segments + 1);
+						T** new_table = ta.allocate(new_table_capacity);
+						assert( new_table );
+						if (_values != nullptr)
+						{
+							std::memcpy(new_table, _values, sizeof(T*)*nb_segments);
+							ta.deallocate(_values,table_capacity);
+						}
+						Statistics::inc_memory<STATISTICS_T>(sizeof(T*)*(new_table_capacity - table_capacity));
+						_values = new_table;
+					}
+					_values[nb_segments] = va.allocate(SEGMENT_SIZE);
+					assert( _values[nb_segments] );
+					Statistics::inc_memory<STATISTICS_T>(sizeof(T)*SEGMENT_SIZE);
+				}
+				_capacity += SEGMENT_SIZE;
+			} while (_capacity < min_capacity);
+		} else {
+			if (INLINE && (_capacity == 0) && (min_capacity <= INLINE_CAPACITY))
 			{
-				if (p->_status > BACKTRACK)
-					std::memcpy((char*)p_dest, (char*)p, sizeof(Node));
-				else
-					_Alloc_traits::construct(na, p_dest, std::move(*p));
+				// First nodes of the list, they are stored in the inline buffer
+				_data = inline_nodes();
+				_capacity = INLINE_CAPACITY;
+				return;
 			}
-			na.deallocate(_data,_capacity);
+			// Capacity is not enough, reallocate (spill the inline or mapped nodes to the heap)
+			const bool owned = !is_inline() && !is_mapped();
+			std::size_t max_capacity = _Alloc_traits::max_size(na);
+			const std::size_t foreseen_capacity = std::max< std::size_t >((_capacity == 0)?4:2 * _capacity, min_capacity); // We try to double size
+			const std::size_t new_capacity = (foreseen_capacity > max_capacity) ? max_capacity : foreseen_capacity;
+
+			Node *new_data = na.allocate(new_capacity);
+			assert( new_data );
+			if (_data != nullptr)
+			{
+				assert(_capacity > 0);
+				Node* p = _data;
+				Node* p_last = _data + _first_unused_pid;
+				Node* p_dest = new_data;
+				for (; p != p_last; ++p, (void)++p_dest)
+				{
+					if (p->_status > BACKTRACK)
+						std::memcpy((char*)p_dest, (char*)p, sizeof(Node));
+					else
+						_Alloc_traits::construct(na, p_dest, std::move(*p));
+				}
+				if (owned)
+					na.deallocate(_data,_capacity);
+			}
+			Statistics::inc_memory<STATISTICS_T>(sizeof(Node)*(new_capacity - (owned ? _capacity : 0)));
+			if constexpr (SOA)
+			{
+				// Move the elements to the new array of elements
+				Allocator_t va;
+				T* new_values = va.allocate(new_capacity);
+				assert( new_values );
+				if (_values != nullptr)
+				{
+					for (PID_t i = 0; i != _first_unused_pid; ++i)
+						if (new_data[i]._status <= BACKTRACK)
+						{
+							std::allocator_traits< Allocator_t >::construct(va, new_values + i, std::move(_values[i]));
+							std::allocator_traits< Allocator_t >::destroy(va, _values + i);
+						}
+					va.deallocate(_values,_capacity);
+				}
+				Statistics::inc_memory<STATISTICS_T>(sizeof(T)*(new_capacity - _capacity));
+				_values = new_values;
+			}
+			_data = new_data;
+			_capacity = new_capacity;
+			_image = Image_t();
 		}
-		Statistics::inc_memory<STATISTICS_T>(sizeof(Node)*(new_capacity - _capacity));
-		_data = new_data;
-		_capacity = new_capacity;
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	typename Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::iterator Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::insert(T e)
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	typename Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::iterator Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::insert(T e)
 	{
 		// Test if we need to start a new rollback point
 		create_rollback_point();
@@ -141,7 +435,7 @@ namespace chr
 		if (_first_free != END_LIST)
 		{
 			p = _first_free;
-			_first_free = _data[_first_free]._prev;
+			_first_free = node(_first_free)._prev;
 			if constexpr (SAFE_DELETE)
 			{
 				// We manage number of free only if there is no previous backtrack state
@@ -153,32 +447,32 @@ namespace chr
 			++_first_unused_pid;
 		}
 		Allocator_t a;
-		std::allocator_traits< Allocator_t >::construct(a, &_data[p]._e, std::move(e) );
-		_data[p]._prev = END_LIST;
-		_data[p]._next = _first;
-		_data[p]._status = ALIVE;
-		_data[p]._obs_count = 0;
+		std::allocator_traits< Allocator_t >::construct(a, &value(p), std::move(e) );
+		node(p)._prev = END_LIST;
+		node(p)._next = _first;
+		node(p)._status = ALIVE;
+		node(p)._obs_count = 0;
 		if (_first != END_LIST)
-			_data[_first]._prev = p;
+			node(_first)._prev = p;
 		else
 			_last = p;
 		_first = p;
-		return Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::iterator(*this, _first);
+		return Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::iterator(*this, _first);
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::free(Bt_list::PID_t p)
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::free(Bt_list::PID_t p)
 	{
 		assert(p != END_LIST);
-		assert(_data[p]._status == REMOVE);
+		assert(node(p)._status == REMOVE);
 
-		if (_data[p]._obs_count == 0)
+		if (node(p)._obs_count == 0)
 		{
 			// Add node to list of free nodes
-			PID_t p_next = _data[p]._next;
+			PID_t p_next = node(p)._next;
 			#ifndef NDEBUG
 				// Normally useless only needed to make things cleaner
-				_data[p]._next = END_LIST;
+				node(p)._next = END_LIST;
 			#endif
 			if constexpr (SAFE_DELETE)
 			{
@@ -186,18 +480,18 @@ namespace chr
 				if (_first_rewind == END_LIST)
 					++extra._nb_free;
 			}
-			_data[p]._prev = _first_free;
+			node(p)._prev = _first_free;
 			_first_free = p;
 			p = p_next;
 			while (p != END_LIST)
 			{
-				if ((_data[p]._status != REMOVE) || (_data[p]._obs_count > 1))
+				if ((node(p)._status != REMOVE) || (node(p)._obs_count > 1))
 				{
 					// If status != REMOVE and obs_count is 0, don't decrement obs_count
-					if (_data[p]._obs_count > 0) --_data[ p ]._obs_count;
+					if (node(p)._obs_count > 0) --node(p)._obs_count;
 					break;
 				}
-				--_data[p]._obs_count;
+				--node(p)._obs_count;
 				if constexpr (SAFE_DELETE)
 				{
 					// We manage number of free only if there is no previous backtrack state
@@ -205,19 +499,19 @@ namespace chr
 						++extra._nb_free;
 				}
 				// Add node to list of free nodes
-				_data[p]._prev = _first_free;
+				node(p)._prev = _first_free;
 				_first_free = p;
-				p = _data[p]._next;
+				p = node(p)._next;
 				#ifndef NDEBUG
 					// Normally useless only needed to make things cleaner
-					_data[_first_free]._next = END_LIST;
+					node(_first_free)._next = END_LIST;
 				#endif
 			}
 		}
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	typename Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::iterator Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::remove(const Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::iterator& it)
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	typename Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::iterator Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::remove(const Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::iterator& it)
 	{
 		assert(it._current != END_LIST);
 		auto n_it = it;
@@ -226,8 +520,8 @@ namespace chr
 		return n_it;
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::remove(Bt_list::PID_t p)
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::remove(Bt_list::PID_t p)
 	{
 		assert(p != END_LIST);
 		assert(_first != END_LIST);
@@ -242,47 +536,47 @@ namespace chr
 		// Unlink node from current list
 		if (p == _first) // Unlink first node
 		{
-			if (_data[p]._next == END_LIST)
+			if (node(p)._next == END_LIST)
 			{
 				_first = END_LIST;
 				_last = END_LIST;
 			} else {
-				_first = (_data[_first])._next;
-				_data[_first]._prev = END_LIST;
+				_first = (node(_first))._next;
+				node(_first)._prev = END_LIST;
 				// Lock next node
-				do_inc_obs_count(_data[p]._next);
+				do_inc_obs_count(node(p)._next);
 			}
 		} else if (p == _last) // Unlink last node
 		{
-			assert(_data[p]._next == END_LIST);
-			_last = _data[p]._prev;
-			_data[ _last ]._next = END_LIST;
+			assert(node(p)._next == END_LIST);
+			_last = node(p)._prev;
+			node(_last)._next = END_LIST;
 		} else {
-			_data[ _data[p]._prev ]._next = _data[p]._next;
-			if (_data[p]._next != END_LIST)
+			node(node(p)._prev)._next = node(p)._next;
+			if (node(p)._next != END_LIST)
 			{
-				_data[ _data[p]._next ]._prev = _data[p]._prev;
+				node(node(p)._next)._prev = node(p)._prev;
 				// Lock next node
-				do_inc_obs_count(_data[p]._next);
+				do_inc_obs_count(node(p)._next);
 			}
 		}
 
 		if ((_first_rewind == END_LIST) || (p > _first_rewind))
 		{
-			_data[p]._status = REMOVE;
+			node(p)._status = REMOVE;
 			// Remove and free element, we won't need to backtrack this one at
 			// its PID is after the first rewind one.
 			// Call the destructor of _e
 			if constexpr (NEED_DESTROY)
-				std::destroy_at(std::addressof(_data[p]._e));
+				std::destroy_at(std::addressof(value(p)));
 			free(p);
 		} else {
 			// Link node to the list of rewind ones (we may backtrack this later)
 			assert(p < _first_rewind);
-			_data[p]._status = BACKTRACK;
+			node(p)._status = BACKTRACK;
 			// Update before_pid (_next field) if the _next is after the last backtrack point
             // and add a closure node to link the nodes
-			if ((_first_rewind != END_LIST) && (_data[p]._next > _first_rewind))
+			if ((_first_rewind != END_LIST) && (node(p)._next > _first_rewind))
 			{
                 if ((_first_unused_pid == _capacity) && (_first_free == END_LIST))
                     reallocate_list();
@@ -293,42 +587,42 @@ namespace chr
                 if (_first_free != END_LIST)
                 {
                     p_new = _first_free;
-                    _first_free = _data[_first_free]._prev;
+                    _first_free = node(_first_free)._prev;
                 } else {
                     // Set the next free pid usable
                     ++_first_unused_pid;
                 }
                 // Link node to the list of rewind ones (we may backtrack this later)
-                _data[p_new]._status = BACKTRACK_CLOSURE;
-                _data[p_new]._closure_prev = _data[p]._prev;
-                _data[p_new]._closure_next = p;
-                _data[p_new]._prev = _data[_first_rewind]._first_removed_to_restore;
-                _data[_first_rewind]._first_removed_to_restore = p_new;
+                node(p_new)._status = BACKTRACK_CLOSURE;
+                node(p_new)._closure_prev = node(p)._prev;
+                node(p_new)._closure_next = p;
+                node(p_new)._prev = node(_first_rewind)._first_removed_to_restore;
+                node(_first_rewind)._first_removed_to_restore = p_new;
 
                 // Update before_pid (_next field) if the _next is after the last backtrack point
-				Bt_list::PID_t p_next = _data[p]._next;
+				Bt_list::PID_t p_next = node(p)._next;
 				while ( (p_next != END_LIST) && (p_next > _first_rewind))
 				{
-					assert(_data[p_next]._status == ALIVE);
-					p_next = _data[p_next]._next;
+					assert(node(p_next)._status == ALIVE);
+					p_next = node(p_next)._next;
 				}
-				_data[p]._next = p_next;
+				node(p)._next = p_next;
             }
-            _data[p]._prev = _data[_first_rewind]._first_removed_to_restore;
-            _data[_first_rewind]._first_removed_to_restore = p;
+            node(p)._prev = node(_first_rewind)._first_removed_to_restore;
+            node(_first_rewind)._first_removed_to_restore = p;
 		}
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	typename Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::iterator Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::insert_before(const Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::iterator& before_it, T e)
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	typename Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::iterator Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::insert_before(const Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::iterator& before_it, T e)
 	{
 		assert(before_it._current != END_LIST);
 		insert_before(before_it._current, std::move(e));
-		return Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::iterator(*this, _data[before_it._current]._prev);
+		return Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::iterator(*this, node(before_it._current)._prev);
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::insert_before(Bt_list::PID_t before_pid, T e)
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::insert_before(Bt_list::PID_t before_pid, T e)
 	{
 		// Test if we need to start a new rollback point
 		create_rollback_point();
@@ -345,29 +639,29 @@ namespace chr
 			if (_first_free != END_LIST)
 			{
 				p = _first_free;
-				_first_free = _data[_first_free]._prev;
+				_first_free = node(_first_free)._prev;
 			} else {
 				// Set the next free pid usable
 				++_first_unused_pid;
 			}
 			// Link node to the list of rewind ones (we may backtrack this later)
-			_data[p]._status = BACKTRACK_CLOSURE;
-			_data[p]._closure_prev = _data[ before_pid ]._prev ;
-			_data[p]._closure_next = before_pid;
+			node(p)._status = BACKTRACK_CLOSURE;
+			node(p)._closure_prev = node(before_pid)._prev ;
+			node(p)._closure_next = before_pid;
 			// Update closure_next if the _closure_next is after the last backtrack point
-			if ((_first_rewind != END_LIST) && (_data[p]._closure_next > _first_rewind))
+			if ((_first_rewind != END_LIST) && (node(p)._closure_next > _first_rewind))
 			{
-				Bt_list::PID_t p_next = _data[p]._closure_next;
+				Bt_list::PID_t p_next = node(p)._closure_next;
 				while ( (p_next != END_LIST) && (p_next > _first_rewind))
 				{
-					assert(_data[p_next]._status == ALIVE);
-					p_next = _data[p_next]._next;
+					assert(node(p_next)._status == ALIVE);
+					p_next = node(p_next)._next;
 				}
-				_data[p]._closure_next = p_next;
+				node(p)._closure_next = p_next;
 			}
 
-			_data[p]._prev = _data[_first_rewind]._first_removed_to_restore;
-			_data[_first_rewind]._first_removed_to_restore = p;
+			node(p)._prev = node(_first_rewind)._first_removed_to_restore;
+			node(_first_rewind)._first_removed_to_restore = p;
 		}
 
 		// Add the new slot
@@ -381,7 +675,7 @@ namespace chr
 		if (_first_free != END_LIST)
 		{
 			p = _first_free;
-			_first_free = _data[_first_free]._prev;
+			_first_free = node(_first_free)._prev;
 			if constexpr (SAFE_DELETE)
 			{
 				// We manage number of free only if there is no previous backtrack state
@@ -393,36 +687,36 @@ namespace chr
 			++_first_unused_pid;
 		}
 		_Allocator_t a;
-		std::allocator_traits< _Allocator_t >::construct(a, &_data[p]._e, std::move(e) );
-		_data[p]._status = ALIVE;
-		_data[p]._obs_count = 0;
-		_data[p]._next = before_pid;
+		std::allocator_traits< _Allocator_t >::construct(a, &value(p), std::move(e) );
+		node(p)._status = ALIVE;
+		node(p)._obs_count = 0;
+		node(p)._next = before_pid;
 
 		if (before_pid == END_LIST)
 		{
 			if (_first == END_LIST) // Empty list
 			{
 				_first = p;
-				_data[p]._prev = END_LIST;
+				node(p)._prev = END_LIST;
 			} else {
-				_data[p]._prev = _last;
-				_data[_last]._next = p;
+				node(p)._prev = _last;
+				node(_last)._next = p;
 			}
 			_last = p;
 		} else if (before_pid == _first)
 		{
-			_data[p]._prev = END_LIST;
-			_data[_first]._prev = p;
+			node(p)._prev = END_LIST;
+			node(_first)._prev = p;
 			_first = p;
 		} else {
-			_data[p]._prev = _data[before_pid]._prev;
-			_data[before_pid]._prev = p;
-			_data[ _data[p]._prev ]._next = p;
+			node(p)._prev = node(before_pid)._prev;
+			node(before_pid)._prev = p;
+			node(node(p)._prev)._next = p;
 		}
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	typename Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::iterator Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::replace(const Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::iterator& it, T e)
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	typename Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::iterator Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::replace(const Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::iterator& it, T e)
 	{
 		assert(it._current != END_LIST);
 		auto n_it = it;
@@ -431,8 +725,8 @@ namespace chr
 		return n_it;
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::replace(Bt_list::PID_t p, T e)
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::replace(Bt_list::PID_t p, T e)
 	{
 		// If we have no backtrack (i.e. ENABLE_BACKTRACK is false or p is
 		// after the last rollback point), we replace directly by the new element
@@ -440,9 +734,9 @@ namespace chr
 		{
 			// Call the destructor of _e
 			if constexpr (NEED_DESTROY)
-				std::destroy_at(std::addressof(_data[p]._e));
+				std::destroy_at(std::addressof(value(p)));
 			_Allocator_t a;
-			std::allocator_traits< _Allocator_t >::construct(a, &_data[p]._e, std::move(e) );
+			std::allocator_traits< _Allocator_t >::construct(a, &value(p), std::move(e) );
 			return;
 		} else {
 			// Test if we need to start a new rollback point
@@ -452,9 +746,9 @@ namespace chr
 			{
 				// Call the destructor of _e
 				if constexpr (NEED_DESTROY)
-					std::destroy_at(std::addressof(_data[p]._e));
+					std::destroy_at(std::addressof(value(p)));
 				_Allocator_t a;
-				std::allocator_traits< _Allocator_t >::construct(a, &_data[p]._e, std::move(e) );
+				std::allocator_traits< _Allocator_t >::construct(a, &value(p), std::move(e) );
 				return;
 			}
 		}
@@ -462,8 +756,8 @@ namespace chr
 		remove(p);
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::create_rollback_point()
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	void Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::create_rollback_point()
 	{
 		if constexpr (ENABLE_BACKTRACK)
 		{
@@ -477,29 +771,29 @@ namespace chr
 
 			// Use slot at _first_unused_pid and link it
 			// to other element to rewind.
-			_data[_first_unused_pid]._status = SPECIAL;
-			_data[_first_unused_pid]._obs_count = 0;
-			_data[_first_unused_pid]._next_rewind = _first_rewind;
-			_data[_first_unused_pid]._first_removed_to_restore = END_LIST; // Start of removed elements to restore on rewind
-			_data[_first_unused_pid]._rem_backtrack_depth = _backtrack_depth;
+			node(_first_unused_pid)._status = SPECIAL;
+			node(_first_unused_pid)._obs_count = 0;
+			node(_first_unused_pid)._next_rewind = _first_rewind;
+			node(_first_unused_pid)._first_removed_to_restore = END_LIST; // Start of removed elements to restore on rewind
+			node(_first_unused_pid)._rem_backtrack_depth = _backtrack_depth;
 			_first_rewind = _first_unused_pid;
 			++_first_unused_pid;
 
 			// We use the slot close to previous one to store other data
-			_data[_first_unused_pid]._status = SPECIAL;
-			_data[_first_unused_pid]._obs_count = 0;
-			_data[_first_unused_pid]._rem_first_free = _first_free; // Backup first free of the list
-			_data[_first_unused_pid]._rem_first = _first;
-			_data[_first_unused_pid]._rem_size = _size;
+			node(_first_unused_pid)._status = SPECIAL;
+			node(_first_unused_pid)._obs_count = 0;
+			node(_first_unused_pid)._rem_first_free = _first_free; // Backup first free of the list
+			node(_first_unused_pid)._rem_first = _first;
+			node(_first_unused_pid)._rem_size = _size;
 			_first_free = END_LIST;
 			_backtrack_depth = Backtrack::depth();
 			++_first_unused_pid;
 		}
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
 	template< bool EB >
-	std::enable_if_t<EB, bool> Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::rewind(Depth_t, Depth_t new_depth)
+	std::enable_if_t<EB, bool> Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::rewind(Depth_t, Depth_t new_depth)
 	{
 		assert(ENABLE_BACKTRACK); // Can't occur because of SFINAE
 		if (_backtrack_depth <= new_depth) return true;
@@ -511,47 +805,47 @@ namespace chr
 			// Destroy element not relevant anymore
 			if constexpr (NEED_DESTROY)
 			{
-				for (Node* p = _data + _first_rewind + 2; p != (_data + _first_unused_pid); ++p)
+				for (PID_t i = _first_rewind + 2; i != _first_unused_pid; ++i)
 				{
-					if (p->_status < REMOVE)
-						std::destroy_at(std::addressof(p->_e)); // Call the destructor of _e
+					if (node(i)._status < REMOVE)
+						std::destroy_at(std::addressof(value(i))); // Call the destructor of _e
 				}
 			}
 
 			// Restore removed and closure elements
-			PID_t p = _data[ _first_rewind ]._first_removed_to_restore;
+			PID_t p = node(_first_rewind)._first_removed_to_restore;
 			while (p != END_LIST)
 			{
-				PID_t bak_p_next = _data[p]._prev;
-				assert((_data[p]._status == BACKTRACK) || (_data[p]._status == BACKTRACK_CLOSURE));
+				PID_t bak_p_next = node(p)._prev;
+				assert((node(p)._status == BACKTRACK) || (node(p)._status == BACKTRACK_CLOSURE));
 
-				if (_data[p]._status == BACKTRACK_CLOSURE)
+				if (node(p)._status == BACKTRACK_CLOSURE)
 				{
 					// A closure node has to be inserted after the backtrack point
 					assert(p > _first_rewind);
-					PID_t p_next = _data[p]._closure_next; // p_next is the next alive element of this closure (inserted after first_rewind)
-					PID_t p_prev = _data[p]._closure_prev; // p_prev is the previous alive element of this closure (inserted after first_rewind)
+					PID_t p_next = node(p)._closure_next; // p_next is the next alive element of this closure (inserted after first_rewind)
+					PID_t p_prev = node(p)._closure_prev; // p_prev is the previous alive element of this closure (inserted after first_rewind)
 					if (p_prev == END_LIST)
 						_first = p;
 					else
-						_data[ p_prev ]._next = p_next;
+						node(p_prev)._next = p_next;
 					if (p_next == END_LIST)
 						_last = p;
 					else	
-						_data[ p_next ]._prev = p_prev;
+						node(p_next)._prev = p_prev;
 					// The closure slot will be freed together with the other elements after the _first_rewind slot
 				} else {
 					// We restore a remove node
 					assert(p < _first_rewind);
-					_data[p]._status = ALIVE;
+					node(p)._status = ALIVE;
 
-					PID_t p_next = _data[p]._next; // p_next is the next alive element of this removed one
+					PID_t p_next = node(p)._next; // p_next is the next alive element of this removed one
 					if (p_next == END_LIST)
 					{
 						if (_first == END_LIST) // Empty list
 						{
-							_data[p]._prev = END_LIST;
-							_data[p]._next = END_LIST;
+							node(p)._prev = END_LIST;
+							node(p)._next = END_LIST;
 							_first = p;
 							_last = p;
 						} else {
@@ -561,56 +855,56 @@ namespace chr
                                 // If the p_prev element is after the first_rewind, we go further.
                                 while ( (p_prev != END_LIST) && (p_prev > _first_rewind))
                                 {
-                                    assert(_data[p_prev]._status == ALIVE);
-                                    p_prev = _data[p_prev]._prev;
+                                    assert(node(p_prev)._status == ALIVE);
+                                    p_prev = node(p_prev)._prev;
                                 }
                             }
                             if (p_prev == END_LIST)
                             {
-                                _data[p]._prev = END_LIST;
-                                _data[p]._next = END_LIST;
+                                node(p)._prev = END_LIST;
+                                node(p)._next = END_LIST;
                                 _first = p;
                                 _last = p;
                             } else {
-                                _data[p]._prev = p_prev;
-                                _data[p_prev]._next = p;
+                                node(p)._prev = p_prev;
+                                node(p_prev)._next = p;
                                 _last = p;
                             }
 						}
 					} else {
-						assert(_data[p_next]._status == ALIVE);
-						_data[p]._prev = _data[p_next]._prev;
-						_data[p_next]._prev = p;
-						if (_data[p]._prev == END_LIST)
+						assert(node(p_next)._status == ALIVE);
+						node(p)._prev = node(p_next)._prev;
+						node(p_next)._prev = p;
+						if (node(p)._prev == END_LIST)
 							_first = p;
 						else
-							_data[ _data[p]._prev ]._next = p;
+							node(node(p)._prev)._next = p;
 					}
 				}
 				p = bak_p_next;
 			}
 
 			// Restore list members
-			_first = _data[ _first_rewind + 1 ]._rem_first;
+			_first = node(_first_rewind + 1)._rem_first;
 			if (_first != END_LIST)
-				_data[_first]._prev = END_LIST;
+				node(_first)._prev = END_LIST;
 			else
 				_last = END_LIST; // If list not empty, then _last MUST be an ALIVE node (because we always insert in front)
 			if (_last != END_LIST)
-				_data[_last]._next = END_LIST;
-			_size = _data[ _first_rewind + 1 ]._rem_size;
-			_first_free = _data[ _first_rewind + 1 ]._rem_first_free;
-			_backtrack_depth = _data[ _first_rewind ]._rem_backtrack_depth;
+				node(_last)._next = END_LIST;
+			_size = node(_first_rewind + 1)._rem_size;
+			_first_free = node(_first_rewind + 1)._rem_first_free;
+			_backtrack_depth = node(_first_rewind)._rem_backtrack_depth;
 			_first_unused_pid = _first_rewind;
-			_first_rewind = _data[ _first_rewind ]._next_rewind;
+			_first_rewind = node(_first_rewind)._next_rewind;
 
 		} while ((_first_rewind != END_LIST) && (_backtrack_depth > new_depth));
 
 		return (_first_rewind != END_LIST);
 	}
 
-	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t >
-	std::string Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t >::to_string(unsigned int debug) const
+	template< typename T, bool ENABLE_BACKTRACK, bool SAFE_DELETE, unsigned int STATISTICS_T, typename Allocator_t, unsigned int SEGMENT_BITS, bool SOA, unsigned int INLINE_CAPACITY >
+	std::string Bt_list< T, ENABLE_BACKTRACK, SAFE_DELETE, STATISTICS_T, Allocator_t, SEGMENT_BITS, SOA, INLINE_CAPACITY >::to_string(unsigned int debug) const
 	{
 		std::string str;
 		if (debug > 0)
@@ -623,29 +917,29 @@ namespace chr
 			{
 				if (i > 0) str += ", ";
 				str += "[" + std::to_string(i) + "](";
-				if (_data[i]._status == ALIVE)
-					str += chr::TIW::to_string(_data[i]._e);
-				else if (_data[i]._status == BACKTRACK)
-					str += "_!" + chr::TIW::to_string(_data[i]._e) + "!_";
-				else if (_data[i]._status == BACKTRACK_CLOSURE)
+				if (node(i)._status == ALIVE)
+					str += chr::TIW::to_string(value(i));
+				else if (node(i)._status == BACKTRACK)
+					str += "_!" + chr::TIW::to_string(value(i)) + "!_";
+				else if (node(i)._status == BACKTRACK_CLOSURE)
 					str += "_!!_";
-				else if (_data[i]._status == REMOVE)
+				else if (node(i)._status == REMOVE)
 					str += "_--_";
 				else
 					str += "_##_";
-				if (_data[i]._status == SPECIAL)
+				if (node(i)._status == SPECIAL)
 				{
-					str += ",bd=" + std::to_string(_data[i]._rem_backtrack_depth) + ",nr=" + ((_data[i]._next_rewind == END_LIST)?"END":std::to_string(_data[i]._next_rewind)) + ",fr=" + ((_data[i]._first_removed_to_restore == END_LIST)?"END":std::to_string(_data[i]._first_removed_to_restore));
+					str += ",bd=" + std::to_string(node(i)._rem_backtrack_depth) + ",nr=" + ((node(i)._next_rewind == END_LIST)?"END":std::to_string(node(i)._next_rewind)) + ",fr=" + ((node(i)._first_removed_to_restore == END_LIST)?"END":std::to_string(node(i)._first_removed_to_restore));
 					++i;
-					str += ",ff=" + ((_data[i]._rem_first_free == END_LIST)?"END":std::to_string(_data[i]._rem_first_free)) + ",f=" + ((_data[i]._rem_first== END_LIST)?"END":std::to_string(_data[i]._rem_first)) + ",s=" + std::to_string(_data[i]._rem_size);
-				} else if (_data[i]._status == BACKTRACK)
+					str += ",ff=" + ((node(i)._rem_first_free == END_LIST)?"END":std::to_string(node(i)._rem_first_free)) + ",f=" + ((node(i)._rem_first== END_LIST)?"END":std::to_string(node(i)._rem_first)) + ",s=" + std::to_string(node(i)._rem_size);
+				} else if (node(i)._status == BACKTRACK)
 				{
-					str += ",obs=" + std::to_string(_data[i]._obs_count) + ",before=" + ((_data[i]._next == END_LIST)?"END":std::to_string(_data[i]._next)) + "," + "-->" + ((_data[i]._prev == END_LIST)?"END":std::to_string(_data[i]._prev));
-				} else if (_data[i]._status == BACKTRACK_CLOSURE)
+					str += ",obs=" + std::to_string(node(i)._obs_count) + ",before=" + ((node(i)._next == END_LIST)?"END":std::to_string(node(i)._next)) + "," + "-->" + ((node(i)._prev == END_LIST)?"END":std::to_string(node(i)._prev));
+				} else if (node(i)._status == BACKTRACK_CLOSURE)
 				{
-					str += ",obs=" + std::to_string(_data[i]._obs_count) + "," + ((_data[i]._closure_prev == END_LIST)?"END":std::to_string(_data[i]._closure_prev)) + "/-\\" + ((_data[i]._closure_next == END_LIST)?"END":std::to_string(_data[i]._closure_next)) + "," + "-->" + ((_data[i]._prev == END_LIST)?"END":std::to_string(_data[i]._prev));
+					str += ",obs=" + std::to_string(node(i)._obs_count) + "," + ((node(i)._closure_prev == END_LIST)?"END":std::to_string(node(i)._closure_prev)) + "/-\\" + ((node(i)._closure_next == END_LIST)?"END":std::to_string(node(i)._closure_next)) + "," + "-->" + ((node(i)._prev == END_LIST)?"END":std::to_string(node(i)._prev));
 				} else
-					str += ",obs=" + std::to_string(_data[i]._obs_count) + "," + ((_data[i]._prev == END_LIST)?"END":std::to_string(_data[i]._prev)) + "<--|-->" + ((_data[i]._next == END_LIST)?"END":std::to_string(_data[i]._next));
+					str += ",obs=" + std::to_string(node(i)._obs_count) + "," + ((node(i)._prev == END_LIST)?"END":std::to_string(node(i)._prev)) + "<--|-->" + ((node(i)._next == END_LIST)?"END":std::to_string(node(i)._next));
 				str += ")";
 			}
 			str += "}";
@@ -654,8 +948,8 @@ namespace chr
 			PID_t  p = _first;
 			while (p != END_LIST)
 			{
-				str += chr::TIW::to_string(_data[p]._e);
-				p = _data[p]._next;
+				str += chr::TIW::to_string(value(p));
+				p = node(p)._next;
 				if (p != END_LIST) str += ", ";
 			}
 			str += "}";
@@ -106,6 +106,10 @@ namespace chr {
 	// ES_CHR::FAILURE if the underlying function returns an ES_CHR::FAILURE.
 	#define CHECK_ES(X) { if (chr::EVAL< decltype(X) >::eval([&](){return X;}) == chr::ES_CHR::FAILURE) return chr::ES_CHR::FAILURE; }
 
+	// Same as CHECK_ES but jump to label L instead of returning ES_CHR::FAILURE
+	// (used by the behavior bodies generated inline).
+	#define CHECK_ES_GOTO(L, X) { if (chr::EVAL< decltype(X) >::eval([&](){return X;}) == chr::ES_CHR::FAILURE) goto L; }
+
 	/**
 	 * @brief Logical status of a variable
 	 */
@@ -649,6 +653,8 @@ namespace chr {
 		/// Check if we need to call destructor
 		static constexpr bool NEED_DESTROY = !std::is_scalar<T>::value && chr::Has_need_destroy<T>::value;
 		static constexpr bool LV_GROUND = true; ///< Say that this is a Logical_var_ground
+		/// Check if the variable can be used in place from a binary image
+		static constexpr bool IMAGE_RELOCATABLE = !NEED_DESTROY && chr::Is_image_relocatable<T>::value;
 
 		typedef T Value_t;							///< Type of encapsulated variable
 		typedef Grounded_key_t<T> Key_t;			///< Type of index if variable involved
@@ -1783,5 +1789,17 @@ namespace chr {
 #include <constraint_store_index.hh>
 #include <constraint_stores_iterator.hh>
 #include <history.hh>
+#include <minimax.hpp>
+#include <ordering.hpp>
+#include <best_first.hpp>
+#include <nogood.hpp>
+#include <restart.hpp>
+#include <limited_search.hpp>
+#include <mcts.hpp>
+#include <fiber.hpp>
+#include <solutions.hpp>
+#include <branch_and_bound.hpp>
+#include <symmetry.hpp>
+#include <fact_loader.hpp>
 
 #endif /* RUNTIME_CHRPP_HH_ */
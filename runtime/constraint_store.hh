@@ -22,11 +22,16 @@
 #ifndef RUNTIME_CONSTRAINT_STORE_HH_
 #define RUNTIME_CONSTRAINT_STORE_HH_
 
+#include <cstdint>
+#include <fstream>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <statistics.hh>
 #include <chrpp.hh>
 #include <bt_list.hh>
+#include <mapped_file.hpp>
 
 /**
  * \defgroup Constraints Constraints management
@@ -55,7 +60,8 @@ namespace chr {
 	public:
 		typedef T Constraint_t;
 		typedef class Constraint_store_simple_iterator< Constraint_store_simple< T, ENABLE_BACKTRACK > > iterator;
-		typedef typename Bt_list< T, ENABLE_BACKTRACK, false, chr::Statistics::CONSTRAINT_STORE >::PID_t PID_t;
+		typedef Bt_list< T, ENABLE_BACKTRACK, false, chr::Statistics::CONSTRAINT_STORE, std::allocator< T >, CHR_STORE_SEGMENT_BITS, (CHR_STORE_SOA != 0) > Store_list_t;
+		typedef typename Store_list_t::PID_t PID_t;
 
 		static constexpr bool _ENABLE_BACKTRACK = ENABLE_BACKTRACK;
 
@@ -129,8 +135,72 @@ namespace chr {
 		 */
 		iterator add(T e);
 
+		/**
+		 * Make room for \a n more constraints in the store.
+		 * @param n The number of constraints to make room for
+		 */
+		void reserve(std::size_t n) { _store.reserve(n); }
+
+		/**
+		 * Add all constraints of \a cs into the store (bulk insertion). The capacity
+		 * of the store is reserved once. The constraints are inserted in reverse order
+		 * so that browsing the store from the returned iterator visits them in the
+		 * order of \a cs (followed by the constraints stored before).
+		 * @param cs The constraints to add
+		 * @return An iterator on the first constraint of \a cs (end() if \a cs is empty)
+		 */
+		iterator load(std::vector< T > cs);
+
+		/**
+		 * Compact the store: the constraints are renumbered contiguously and
+		 * the free slots are given back (see Bt_list::compact()). It must be called
+		 * when there is no more rollback point on the store (for example when the
+		 * program is back to depth 0 between two runs). The store is unchanged if a
+		 * constraint is locked by an iterator (a constraint waiting for the
+		 * update of a logical variable).
+		 * @return True if the store has been compacted, false otherwise
+		 */
+		bool compact()
+		{
+			std::vector< PID_t > remap;
+			return _store.compact(remap);
+		}
+
+		/**
+		 * Write the binary image of the store to the file \a path (see Bt_list::write_image()).
+		 * It must be called when there is no more rollback point on the store and when
+		 * no constraint is locked by an iterator. Only the stores of relocatable
+		 * constraints (see chr::Is_image_relocatable) with a contiguous layout
+		 * (no CHR_STORE_SEGMENT_BITS, no CHR_STORE_SOA) have an image.
+		 * @param path The path of the image file
+		 * @param tag A value kept in the image (returned by load_image())
+		 * @return True if the image has been written, false otherwise
+		 */
+		bool save_image(const std::string& path, std::uint64_t tag = 0) const;
+
+		/**
+		 * Load the image of the file \a path (see save_image()) in this empty store.
+		 * The file is mapped in memory and the constraints are used in place (zero copy):
+		 * the pages of the file are loaded on demand and the mapping is private,
+		 * the pages written (by the locks of the iterators) are copied. The constraints
+		 * are copied to memory at the first reallocation of the store.
+		 * An exception is thrown if the file can't be mapped.
+		 * @param path The path of the image file
+		 * @param tag The value given to save_image()
+		 * @return True if the image has been loaded, false if the store is not empty or if it is not an image of this type of store
+		 */
+		bool load_image(const std::string& path, std::uint64_t& tag);
+
+		/**
+		 * Freeze the indexes of the store (see Constraint_store_index::freeze()).
+		 * A store without index has nothing to freeze.
+		 * @return False
+		 */
+		bool freeze() { return false; }
+
 	private:
-		Bt_list< T, ENABLE_BACKTRACK, false, chr::Statistics::CONSTRAINT_STORE > _store;	///< The store of constraints
+		std::unique_ptr< Mapped_file > _image;	///< Image file loaded by load_image() (the nodes of _store may be mapped from it)
+		Store_list_t _store;	///< The store of constraints
 		std::string _label; ///< Label of this constraint store (to print before each constraint)
 
 		/**
@@ -316,14 +386,14 @@ namespace chr {
 
 	private:
 		Constraint_store_t* _store;	///< Store of constraint
-		typename Bt_list< typename Constraint_store_t::Constraint_t, Constraint_store_t::_ENABLE_BACKTRACK, false, chr::Statistics::CONSTRAINT_STORE >::iterator _it;	///< The current iterator on the list of constraints
+		typename Constraint_store_t::Store_list_t::iterator _it;	///< The current iterator on the list of constraints
 
 		/**
 		 * Initialize.
 		 * @param store The constraint store to browse
 		 * @param it The initial pos of the iterator
 		 */
-		Constraint_store_simple_iterator(Constraint_store_t& store, const typename Bt_list< typename Constraint_store_t::Constraint_t, Constraint_store_t::_ENABLE_BACKTRACK, false, chr::Statistics::CONSTRAINT_STORE >::iterator it) : _store(&store), _it(it) { }
+		Constraint_store_simple_iterator(Constraint_store_t& store, const typename Constraint_store_t::Store_list_t::iterator it) : _store(&store), _it(it) { }
 	};
 
 }
@@ -54,6 +54,49 @@ namespace chr
 		}
 	}
 
+	template< typename T, bool ENABLE_BACKTRACK >
+	typename Constraint_store_simple< T, ENABLE_BACKTRACK >::iterator Constraint_store_simple< T, ENABLE_BACKTRACK >::load(std::vector< T > cs)
+	{
+		if (cs.empty()) return end();
+		_store.reserve(cs.size());
+		for (std::size_t i = cs.size() - 1; i > 0; --i)
+			(void) add( std::move(cs[i]) );
+		return add( std::move(cs[0]) );
+	}
+
+	template< typename T, bool ENABLE_BACKTRACK >
+	bool Constraint_store_simple< T, ENABLE_BACKTRACK >::save_image(const std::string& path, std::uint64_t tag) const
+	{
+		if constexpr (Store_list_t::IMAGE && chr::Is_image_relocatable< T >::value)
+		{
+			std::ofstream os(path, std::ios::binary | std::ios::trunc);
+			return os && _store.write_image(os, tag) && os.flush();
+		} else {
+			(void) path;
+			(void) tag;
+			return false;
+		}
+	}
+
+	template< typename T, bool ENABLE_BACKTRACK >
+	bool Constraint_store_simple< T, ENABLE_BACKTRACK >::load_image(const std::string& path, std::uint64_t& tag)
+	{
+		if constexpr (Store_list_t::IMAGE && chr::Is_image_relocatable< T >::value)
+		{
+			if (_store._first_unused_pid != 0) return false;
+			auto image = std::make_unique< Mapped_file >(path, true, false);
+			if (_store._capacity > 0) _store.deallocate_list();
+			if (!_store.map_image(image->data(), image->size(), tag))
+				return false;
+			_image = std::move(image);
+			return true;
+		} else {
+			(void) path;
+			(void) tag;
+			return false;
+		}
+	}
+
 	template< typename T, bool ENABLE_BACKTRACK >
 	void Constraint_store_simple< T, ENABLE_BACKTRACK >::remove(PID_t pid)
 	{
@@ -22,10 +22,15 @@
 #ifndef RUNTIME_CONSTRAINT_STORE_INDEX_HH_
 #define RUNTIME_CONSTRAINT_STORE_INDEX_HH_
 
+#include <algorithm>
 #include <map>
 #include <array>
+#include <cstdint>
+#include <fstream>
 #include <vector>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <tuple>
 
 // Following includes used for type_name function
@@ -39,8 +44,16 @@
 #include <chrpp.hh>
 
 #include <bt_list.hh>
+#include <dense_map.hpp>
+#include <frozen_index.hpp>
+#include <mapped_file.hpp>
 #include <third_party/robin_map.h>
 
+#ifndef CHR_INDEX_MAX_FREE_SUBLISTS
+/// Maximum number of empty sublists kept by a constraint store to be reused for new keys (see chr::Constraint_store_index)
+#define CHR_INDEX_MAX_FREE_SUBLISTS 1024
+#endif
+
 /**
  * \defgroup Constraints Constraints management
  * 
@@ -121,6 +134,80 @@ namespace chr {
 				}
 			};
 		};
+
+		/**
+		 * Range [MIN0,MAX0] of the values of a parameter of a Dense_index.
+		 */
+		template < long long MIN0, long long MAX0 >
+		struct Range {
+			static_assert(MIN0 <= MAX0, "empty range of a dense index");
+			static constexpr long long MIN = MIN0;
+			static constexpr long long MAX = MAX0;
+			static constexpr std::size_t SIZE = static_cast< std::size_t >(MAX0 - MIN0) + 1;
+		};
+
+		/**
+		 * Template structure used to declare a direct-mapped index. A
+		 * Dense_index< Index<1,3>, Range<0,9>, Range<1,5> > is the index
+		 * Index<1,3> where the values of parameter 1 are in [0,9] and the values
+		 * of parameter 3 are in [1,5]. The parameters must be ground integers.
+		 * The index is stored in a chr::Dense_map with one cell for each
+		 * possible key (50 cells here, only the span of the keys used so far is
+		 * allocated): the cell of a key is found with pointer arithmetic,
+		 * without hashing.
+		 */
+		template < typename Index_t, typename... Ranges >
+		struct Dense_index : Index_t {
+			static_assert(sizeof...(Ranges) == Index_t::size, "a dense index needs one range for each of its parameters");
+			static constexpr std::size_t SIZE = (Ranges::SIZE * ...);
+
+			/**
+			 * Position functor of the keys of the index (see chr::Dense_map).
+			 * The position of a key is computed in row-major order of its values.
+			 */
+			template < typename Key_t >
+			struct Position
+			{
+				static constexpr std::size_t SIZE = Dense_index::SIZE;
+
+				/**
+				 * Compute the position of \a k.
+				 * @param k The key
+				 * @return The position of \a k, SIZE if a value of \a k is out of its range
+				 */
+				std::uint32_t operator()(const Key_t& k) const
+				{
+					return position(k, std::make_index_sequence<sizeof...(Ranges)>());
+				}
+
+			private:
+				template < std::size_t... I >
+				static std::uint32_t position(const Key_t& k, std::index_sequence<I...>)
+				{
+					std::size_t p = 0;
+					bool in_range = ([&]{
+						using R = typename std::tuple_element<I,std::tuple<Ranges...>>::type;
+						using V = decltype(std::get<I>(k._k)._value);
+						static_assert(std::is_same_v< typename Key_t::template get<I>::type, chr::Grounded_key_t< V > > && std::is_integral_v< V >,
+								"the parameters of a dense index must be ground integers");
+						auto v = std::get<I>(k._k)._value;
+						if ((static_cast< long long >(v) < R::MIN) || (static_cast< long long >(v) > R::MAX))
+							return false;
+						p = p * R::SIZE + static_cast< std::size_t >(static_cast< long long >(v) - R::MIN);
+						return true;
+					}() && ...);
+					return static_cast< std::uint32_t >(in_range ? p : SIZE);
+				}
+			};
+		};
+
+		/**
+		 * Check if an index is a Dense_index.
+		 */
+		template < typename Index_t >
+		struct Is_dense_index : std::false_type { };
+		template < typename Index_t, typename... Ranges >
+		struct Is_dense_index< Dense_index< Index_t, Ranges... > > : std::true_type { };
 		
 		/**
 		 * Template structure used to manipulate the keys of an index.
@@ -354,12 +441,13 @@ namespace chr {
 	public:
 		// Shortcuts to common types and constants
 		using Constraint_t = T;
+		using Store_list_t = chr::Bt_list<T,ENABLE_BACKTRACK0,false,chr::Statistics::CONSTRAINT_STORE,std::allocator<T>,CHR_STORE_SEGMENT_BITS,(CHR_STORE_SOA != 0)>;
 		using PID_t = typename chr::Bt_list<T>::PID_t;
 		static constexpr PID_t END_LIST = chr::Bt_list<T>::END_LIST; // Shortcut to END_LIST
 		using TupleIndexes = TupleIndexes0;
 		static constexpr bool ENABLE_BACKTRACK = ENABLE_BACKTRACK0;
 		static constexpr unsigned int INDEX_COUNT = std::tuple_size_v<TupleIndexes>; ///< Shortcut to template value INDEX_COUNT
-		using Sublist_t = chr::Bt_list<PID_t,ENABLE_BACKTRACK,true,chr::Statistics::CONSTRAINT_STORE,std::allocator<PID_t>>;
+		using Sublist_t = chr::Bt_list<PID_t,ENABLE_BACKTRACK,true,chr::Statistics::CONSTRAINT_STORE,std::allocator<PID_t>,0,false,CHR_INDEX_INLINE_CAPACITY>;
 
 		/**
 		 * Data structure which represents a list of constraints. Each element is
@@ -422,27 +510,72 @@ namespace chr {
 		};
 
 		/**
-		 * Map and convert a list (tuple) of index types to a list (tuple) of
-		 * robin_map types. Each map instanced form this type part will contain
-		 * the index elements.
+		 * Map an index and its key type to the type of map which contains
+		 * the index elements: a robin_map, or a Dense_map for a Dense_index.
+		 */
+		template < typename Index_t, typename Key_t >
+		struct MapIndex {
+			using type = tsl::robin_map< Key_t, Index_element_t, typename Key_t::Hash >;
+		};
+		template < typename Index_t, typename... Ranges, typename Key_t >
+		struct MapIndex< LNS::Dense_index< Index_t, Ranges... >, Key_t > {
+			using type = chr::Dense_map< Key_t, Index_element_t, typename LNS::Dense_index< Index_t, Ranges... >::template Position< Key_t > >;
+		};
+
+		/**
+		 * Map and convert a list (tuple) of index types and the list (tuple)
+		 * of their key types to a list (tuple) of map types. Each map instanced
+		 * form this type part will contain the index elements.
 		 */
 		template < typename... Ts > struct TupleMapIndex;
+		template < typename... Is, typename... Ks >
+		struct TupleMapIndex< std::tuple< Is... >, std::tuple< Ks... > >{ 
+		    using type = std::tuple< typename MapIndex< Is, Ks >::type... >;
+		};
+
+		/**
+		 * Map and convert a list (tuple) of key types to a list (tuple) of
+		 * Frozen_index types (the indexes of a frozen store).
+		 */
+		template < typename... Ts > struct TupleFrozenIndex;
+		template < typename... Ts >
+		struct TupleFrozenIndex< std::tuple< Ts... > >{ 
+		    using type = std::tuple< chr::Frozen_index< Ts, typename Ts::Hash, PID_t, END_LIST >... >;
+		};
+
+		/**
+		 * Check if all the parameters involved in a list (tuple) of index
+		 * types are Logical_var_ground (the keys never change).
+		 */
+		template < typename... Ts > struct ground_indexes;
+		template < typename... Ts >
+		struct ground_indexes< std::tuple< Ts... > >{ 
+			template < typename... Us > static constexpr bool ground(std::tuple< Us... >*) { return (Us::LV_GROUND && ...); }
+			static constexpr bool value = (ground(static_cast< Ts* >(nullptr)) && ...);
+		};
+
+		/**
+		 * Check if a list (tuple) of index types has a Dense_index.
+		 */
+		template < typename... Ts > struct dense_indexes;
 		template < typename... Ts >
-		struct TupleMapIndex< std::tuple< Ts... > >{ 
-		    using type = std::tuple< 
-					tsl::robin_map<
-						typename ConvertArgsToKey<Ts>::type,
-						Index_element_t,
-						typename ConvertArgsToKey<Ts>::type::Hash
-					>
-			... >;
+		struct dense_indexes< std::tuple< Ts... > >{ 
+			static constexpr bool value = (LNS::Is_dense_index< Ts >::value || ...);
 		};
 
 	public:
 		// Types built with TupleIndexes (types, keys, maps)
 		using TupleIndexes_t = typename index_value_to_type<TupleIndexes>::type;
 		using TupleKey_t = typename TupleKey<TupleIndexes_t>::type;
-		using TupleMap_t = typename TupleMapIndex<TupleIndexes_t>::type;
+		using TupleMap_t = typename TupleMapIndex<TupleIndexes,TupleKey_t>::type;
+		using TupleFrozen_t = typename TupleFrozenIndex<TupleKey_t>::type;
+
+		/**
+		 * A store can be frozen (see freeze()) if it is not backtrackable (persistent
+		 * constraints) and if its keys never change (ground parameters). The lookups
+		 * of a Dense_index are already direct, a store with a Dense_index is not frozen.
+		 */
+		static constexpr bool FREEZABLE = !ENABLE_BACKTRACK && ground_indexes<TupleIndexes_t>::value && !dense_indexes<TupleIndexes>::value;
 
 		/**
 		 * Statistics about an instance of Constraint_store_index.
@@ -451,7 +584,11 @@ namespace chr {
 		struct Statistics
 		{
 			size_t size;																///< Number of elements in the store
-			size_t nb_pending;															///< Number of pending sublist waiting to be deleted
+			size_t nb_pending;															///< Number of pending sublist waiting to be safe
+			size_t nb_free;																///< Number of safe sublists kept to be reused
+			size_t nb_sublists;															///< Number of sublists of all indexes (one per key)
+			size_t nb_inline;															///< Number of sublists whose nodes are stored inline (see CHR_INDEX_INLINE_CAPACITY)
+			size_t sublist_memory;														///< Memory (in bytes) used by the sublists of all indexes, nodes included
 			std::vector< unsigned long int > constraints;								///< List of constraint id of the store
 			std::array< std::map< CHR_XXHASH_hash_t,  std::vector< unsigned long int > >,
 						INDEX_COUNT > indexes;											///< Indexes (Key = hash value, Values = constraints (id) that involve the hash
@@ -464,7 +601,11 @@ namespace chr {
 			:	Backtrack_observer(),
 				_backtrack_scheduled(false),
 				_backtrack_depth(Backtrack::depth()),
-				_label(label)
+				_label(label),
+				_nb_pending(0),
+				_frozen(false),
+				_thawed(false),
+				_frozen_memory(0)
 		{ }
 
 		/**
@@ -551,12 +692,34 @@ namespace chr {
 		iterator_hash begin(Args&& ... args);
 
 		/**
-		 * Add a constraint into the store.
+		 * Add a constraint into the store. An exception (std::out_of_range) is
+		 * thrown, and the store is unchanged, if a key of the constraint is out
+		 * of the range of a Dense_index.
 		 * @param e The constraint to add
 		 * @return An iterator on the new element
 		 */
 		iterator add(T e);
 
+		/**
+		 * Make room for \a n more constraints in the store.
+		 * @param n The number of constraints to make room for
+		 */
+		void reserve(std::size_t n) { _store.reserve(n); }
+
+		/**
+		 * Add all constraints of \a cs into the store (bulk insertion). The capacity
+		 * of the store is reserved once and the indexes are built in a batch: for each
+		 * index, the new constraints are sorted by the hash of their key, so that
+		 * a single map lookup and a single sublist are needed for all the constraints
+		 * which share a key. The constraints are inserted in reverse order so that
+		 * browsing the store from the returned iterator visits them in the order of
+		 * \a cs (followed by the constraints stored before). As for add(), the
+		 * store is unchanged if a key is out of the range of a Dense_index.
+		 * @param cs The constraints to add
+		 * @return An iterator on the first constraint of \a cs (end() if \a cs is empty)
+		 */
+		iterator load(std::vector< T > cs);
+
 		/**
 		 * Update the indexes of the store by moving elements from \a from_key
 		 * to the new index given by \a to_key.
@@ -572,13 +735,83 @@ namespace chr {
 		 */
 		Statistics index_statistics() const;
 
+		/**
+		 * Compact the store: the constraints are renumbered contiguously and
+		 * the free slots are given back (see Bt_list::compact()). The PIDs stored
+		 * in the index sublists are updated with the remap table of the store,
+		 * then the sublists are compacted too. The free sublists kept for reuse
+		 * and the pending sublists which are safe are deleted. It must be called when there is no more rollback
+		 * point on the store or its indexes (for example when the program is back
+		 * to depth 0 between two runs). The store is unchanged if a constraint is
+		 * locked by an iterator (a constraint waiting for the update of a logical variable).
+		 * @return True if the store has been compacted, false otherwise
+		 */
+		bool compact();
+
+		/**
+		 * Write the binary image of the store to the file \a path (see Bt_list::write_image()).
+		 * Only the main store is written, the indexes are rebuilt by load_image().
+		 * It must be called when there is no more rollback point on the store and when
+		 * no constraint is locked by an iterator. Only the stores of relocatable
+		 * constraints (see chr::Is_image_relocatable) with a contiguous layout
+		 * (no CHR_STORE_SEGMENT_BITS, no CHR_STORE_SOA) have an image.
+		 * @param path The path of the image file
+		 * @param tag A value kept in the image (returned by load_image())
+		 * @return True if the image has been written, false otherwise
+		 */
+		bool save_image(const std::string& path, std::uint64_t tag = 0) const;
+
+		/**
+		 * Load the image of the file \a path (see save_image()) in this empty store.
+		 * The file is mapped in memory and the constraints are used in place (zero copy):
+		 * the pages of the file are loaded on demand and the mapping is private,
+		 * the pages written (by the locks of the iterators) are copied. The constraints
+		 * are copied to memory at the first reallocation of the store. The indexes
+		 * are built from the constraints of the image (in a batch, as load()).
+		 * An exception is thrown if the file can't be mapped.
+		 * @param path The path of the image file
+		 * @param tag The value given to save_image()
+		 * @return True if the image has been loaded, false if the store is not empty or if it is not an image of this type of store
+		 */
+		bool load_image(const std::string& path, std::uint64_t& tag);
+
+		/**
+		 * Freeze the indexes of the store: each index is rebuilt as a static
+		 * index (see chr::Frozen_index) with a minimal perfect hash function and
+		 * contiguous PID arrays, and the robin_map index is given back. The lookups
+		 * (begin() with a key) then go through the static indexes, the constraints
+		 * of a key are visited in the same order. A removed constraint is only marked
+		 * as removed in the static indexes. The first constraint added after
+		 * a freeze thaws the store: the robin_map indexes are rebuilt and used
+		 * again (the static indexes are kept for the iterators which browse them,
+		 * until the next freeze or compaction). Only the stores of persistent
+		 * constraints whose indexed parameters are ground can be frozen
+		 * (see FREEZABLE). The store is unchanged if a constraint is
+		 * locked by an iterator.
+		 * @return True if the store is frozen, false otherwise
+		 */
+		bool freeze();
+
+		/**
+		 * Check if the store is frozen (see freeze()).
+		 * @return True if the store is frozen, false otherwise
+		 */
+		bool frozen() const { return _frozen; }
+
 	private:
 		bool _backtrack_scheduled;													///< Flag set to true if this constraint store registered for backtrack management
 		Depth_t _backtrack_depth;													///< The current backtrack depth for this snapshot
 		std::string _label;															///< Label of this constraint store (to print before each constraint)
-		Bt_list<T,ENABLE_BACKTRACK,false,chr::Statistics::CONSTRAINT_STORE> _store;	///< The store of constraints.
+		std::unique_ptr< Mapped_file > _image;										///< Image file loaded by load_image() (the nodes of _store may be mapped from it)
+		Store_list_t _store;														///< The store of constraints.
 		TupleMap_t _indexes;														///< The structure of indexes each member corresponds to a specific index.
-		std::vector< std::unique_ptr<Sublist_t> > _pending_sl;						///< Sublist waiting for being deleted. They will be deleted when they will be safe
+		std::vector< std::vector< std::unique_ptr<Sublist_t> > > _pending_sl;		///< Sublists waiting for being safe, bucketed by the depth where they have been emptied
+		std::size_t _nb_pending;													///< Number of sublists in _pending_sl
+		std::vector< std::unique_ptr<Sublist_t> > _free_sl;							///< Safe sublists kept to be reused for new keys (at most CHR_INDEX_MAX_FREE_SUBLISTS)
+		bool _frozen;																///< True if the lookups go through _frozen_indexes (see freeze())
+		bool _thawed;																///< True if _frozen_indexes are kept for the iterators started before a thaw
+		std::size_t _frozen_memory;													///< Memory used by _frozen_indexes
+		TupleFrozen_t _frozen_indexes;												///< The static indexes of a frozen store
 
 		/**
 		 * Remove a constraint from the store (and all indexes).
@@ -587,17 +820,81 @@ namespace chr {
 		void remove(PID_t pid);
 
 		/**
-		 * Add a new sublist \a sl to the list of pending sublist that are
-		 * waiting to be safe in order to be deleted.
+		 * Release the sublist \a sl of a key removed from an index. If it is safe,
+		 * it is kept to be reused for a new key. Otherwise (some of its nodes are
+		 * still locked by iterators), it is added to the pending sublists.
+		 * @param sl The sublist to release
+		 */
+		void release_sublist(std::unique_ptr<Sublist_t>&& sl);
+
+		/**
+		 * Keep the safe sublist \a sl to be reused for a new key. If there are
+		 * already CHR_INDEX_MAX_FREE_SUBLISTS free sublists, it is destroyed.
+		 * @param sl The sublist to keep
+		 */
+		void add_to_free_list(std::unique_ptr<Sublist_t>&& sl);
+
+		/**
+		 * Add a new sublist \a sl to the pending sublists that are
+		 * waiting to be safe in order to be reused. It goes to the bucket
+		 * of the current depth.
 		 * @param sl The sublist to add to pending list
 		 */
 		void add_to_pending_list(std::unique_ptr<Sublist_t>&& sl);
 
+		/**
+		 * Move the pending sublists which are safe to the free sublists. The buckets
+		 * deeper than the current depth are emptied: the iterators which locked their
+		 * sublists were released by the backtrack, the sublists which are still not
+		 * safe go to the bucket of the current depth. If \a scan_current is true,
+		 * every sublist of the bucket of the current depth is also checked and the
+		 * safe ones are swapped with the last one and removed.
+		 * @param scan_current True to check the sublists of the bucket of the current depth
+		 */
+		void reclaim_pending_sublists(bool scan_current);
+
+		/**
+		 * Return a sublist for a new key: a recycled one if any, a new one otherwise.
+		 * The bucket of the current depth of the pending sublists is only checked
+		 * when there is no free sublist left.
+		 * @return The empty sublist
+		 */
+		std::unique_ptr<Sublist_t> new_sublist();
+
 		/**
 		 * Check if a rollback point must be prepared and schedule backtrack observer if needed.
 		 */
 		void prepare_rollback_point();
 
+		/**
+		 * Thaw a frozen store: the robin_map indexes are rebuilt from the
+		 * constraints of the store (see freeze()).
+		 */
+		void thaw();
+
+		/**
+		 * Give back the static indexes of a frozen (or thawed) store.
+		 */
+		void release_frozen_indexes();
+
+		/**
+		 * Lock the constraint \a pid of the main store (for an iterator on a frozen index).
+		 * @param pid The pid of the constraint in the main store
+		 */
+		void lock_pid(PID_t pid) { _store.inc_obs_count(pid); }
+
+		/**
+		 * Unlock the constraint \a pid of the main store and free it if it has been
+		 * removed (for an iterator on a frozen index).
+		 * @param pid The pid of the constraint in the main store
+		 */
+		void unlock_pid(PID_t pid)
+		{
+			_store.dec_obs_count(pid);
+			if (_store.node(pid)._status == Store_list_t::REMOVE)
+				_store.free(pid);
+		}
+
 		/**
 		 * Rewind to the snapshot of the constraint store stored at \a depth.
 		 * All snapshots encountered along the path will be forgotten.
@@ -623,6 +920,35 @@ namespace chr {
 		 */
 		template< size_t... I > void loop_add(const T& e, PID_t pid, std::index_sequence<I...>);
 
+		/**
+		 * Template Meta Programming loop to use compil time optimization.
+		 * Check that the keys of \a e are in the ranges of the Dense_index
+		 * of the store, an exception is thrown otherwise.
+		 * @param e The constraint to add
+		 * @param I... The sequence of integer, one for each index
+		 */
+		template< size_t... I > void loop_check_range(const T& e, std::index_sequence<I...>) const;
+
+		/**
+		 * Constraint of a bulk loading with its key for an index (see loop_load()).
+		 * It is not a local class of loop_load(): the local classes of the
+		 * expansions of a fold expression are the same class for GCC.
+		 */
+		template < typename Key_t >
+		struct Load_entry
+		{
+			CHR_XXHASH_hash_t _hash;	///< Hash value of the key
+			PID_t _pid;					///< PID of the constraint
+			Key_t _k;					///< Key of the constraint for this index
+		};
+
+		/**
+		 * Template Meta Programming loop to use compil time optimization.
+		 * @param pids The pids (slots) of the constraints loaded in main store
+		 * @param I... The sequence of integer, one for each index
+		 */
+		template< size_t... I > void loop_load(const std::vector< PID_t >& pids, std::index_sequence<I...>);
+
 		/**
 		 * Template Meta Programming loop to use compil time optimization.
 		 * @param e The constraint to remove
@@ -645,6 +971,35 @@ namespace chr {
 		 */
 		template< size_t... I > void loop_statistics(Statistics& stats, std::index_sequence<I...>) const;
 
+		/**
+		 * Template Meta Programming loop to use compil time optimization.
+		 * @param I... The sequence of integer, one for each index
+		 * @return True if no sublist of any index has a rollback point, false otherwise
+		 */
+		template< size_t... I > bool loop_compactable(std::index_sequence<I...>) const;
+
+		/**
+		 * Template Meta Programming loop to use compil time optimization.
+		 * @param remap The table which maps the old PIDs of the main store to the new ones
+		 * @param I... The sequence of integer, one for each index
+		 */
+		template< size_t... I > void loop_compact(const std::vector< PID_t >& remap, std::index_sequence<I...>);
+
+		/**
+		 * Template Meta Programming loop to use compil time optimization.
+		 * @param I... The sequence of integer, one for each index
+		 * @return True if all static indexes have been built, false otherwise
+		 */
+		template< size_t... I > bool loop_freeze(std::index_sequence<I...>);
+
+		/**
+		 * Template Meta Programming loop to use compil time optimization.
+		 * @param e The constraint to remove
+		 * @param pid_e The pid (slot) of the constraint to remove in the main store
+		 * @param I... The sequence of integer, one for each index
+		 */
+		template< size_t... I > void loop_frozen_remove(const T& e, PID_t pid_e, std::index_sequence<I...>);
+
 		/**
 		 * Compute and return the statistics in a human readable form. Only for debug purposes.
 		 * @return A string which gather statistics
@@ -785,7 +1140,7 @@ namespace chr {
 		}
 	private:
 		Constraint_store_t& _store;	///< Store of constraint
-		typename Bt_list< typename Constraint_store_t::Constraint_t, Constraint_store_t::ENABLE_BACKTRACK, false, chr::Statistics::CONSTRAINT_STORE >::iterator _it;	///< The current iterator on the full list of constraints
+		typename Constraint_store_t::Store_list_t::iterator _it;	///< The current iterator on the full list of constraints
 
 		/**
 		 * Initialize iterator to the beginning of the store.
@@ -800,7 +1155,7 @@ namespace chr {
 		 * @param store The store of constraints
 		 * @param current The constraint to start with
 		 */
-		Constraint_store_index_iterator_full(Constraint_store_t& store, typename Bt_list< typename Constraint_store_t::Constraint_t, Constraint_store_t::ENABLE_BACKTRACK, false, chr::Statistics::CONSTRAINT_STORE >::iterator current)
+		Constraint_store_index_iterator_full(Constraint_store_t& store, typename Constraint_store_t::Store_list_t::iterator current)
 			: _store(store), _it(current)
 		{ }
 	};
@@ -822,6 +1177,8 @@ namespace chr {
 		 * @return A const reference to the element pointed
 		 */
 		const typename Constraint_store_t::Constraint_t& operator*() const {
+			if constexpr (Constraint_store_t::FREEZABLE)
+				if (_p != nullptr) return _store._store.get(_pid);
 			return _store._store.get(*_it);
 		}
 
@@ -830,7 +1187,7 @@ namespace chr {
 		 * @return The string
 		 */
 		std::string to_string() const {
-			return std::string(_store.label()) + chr::TIW::constraint_to_string(_store._store.get(*_it));
+			return std::string(_store.label()) + chr::TIW::constraint_to_string(**this);
 		}
 
 		/**
@@ -839,6 +1196,13 @@ namespace chr {
 		 */
 		Constraint_store_index_iterator_hash& operator++()
 		{
+			if constexpr (Constraint_store_t::FREEZABLE)
+				if (_p != nullptr)
+				{
+					++_p;
+					skip_removed();
+					return *this;
+				}
 			++_it;
 			return *this;
 		}
@@ -851,6 +1215,8 @@ namespace chr {
 		 */
 		bool at_end() const
 		{
+			if constexpr (Constraint_store_t::FREEZABLE)
+				if (_p != nullptr) return _p == _p_end;
 			return _it.at_end();
 		}
 
@@ -861,6 +1227,12 @@ namespace chr {
 		void lock()
 		{
 			_store.prepare_rollback_point();
+			if constexpr (Constraint_store_t::FREEZABLE)
+				if (_p != nullptr)
+				{
+					_store.lock_pid(_pid);
+					return;
+				}
 			_it.lock();
 		}
 
@@ -871,6 +1243,12 @@ namespace chr {
 		void unlock()
 		{
 			_store.prepare_rollback_point();
+			if constexpr (Constraint_store_t::FREEZABLE)
+				if (_p != nullptr)
+				{
+					_store.unlock_pid(_pid);
+					return;
+				}
 			_it.unlock();
 		}
 
@@ -883,6 +1261,15 @@ namespace chr {
 		void next_and_unlock()
 		{
 			_store.prepare_rollback_point();
+			if constexpr (Constraint_store_t::FREEZABLE)
+				if (_p != nullptr)
+				{
+					auto pid = _pid;
+					++_p;
+					skip_removed();
+					_store.unlock_pid(pid);
+					return;
+				}
 			_it.next_and_unlock();
 		}
 
@@ -892,6 +1279,8 @@ namespace chr {
 		 */
 		bool alive() const
 		{
+			if constexpr (Constraint_store_t::FREEZABLE)
+				if (_p != nullptr) return _store._store.alive(_pid);
 			return _it.valid();
 		}
 
@@ -901,6 +1290,12 @@ namespace chr {
 		 */
 		void kill()
 		{
+			if constexpr (Constraint_store_t::FREEZABLE)
+				if (_p != nullptr)
+				{
+					_store.remove(_pid);
+					return;
+				}
 			_store.remove(*_it);
 		}
 
@@ -910,6 +1305,8 @@ namespace chr {
 		 */
 		bool operator==(const Constraint_store_index_iterator_hash& o) const
 		{
+			if constexpr (Constraint_store_t::FREEZABLE)
+				if ((_p != nullptr) || (o._p != nullptr)) return _p == o._p;
 			return _it == o._it;
 		}
 
@@ -919,12 +1316,17 @@ namespace chr {
 		 */
 		bool operator!=(const Constraint_store_index_iterator_hash& o) const
 		{
-			return _it != o._it;
+			return !(*this == o);
 		}
 
 	private:
+		using PID_t = typename Constraint_store_t::PID_t;
+
 		Constraint_store_t& _store;								///< Store of constraint
 		typename Constraint_store_t::Sublist_t::iterator _it;	///< The current iterator on the sublist of indexed constraints
+		const PID_t* _p = nullptr;								///< The current PID of a frozen index (nullptr if the iterator browses a sublist)
+		const PID_t* _p_end = nullptr;							///< The end of the PIDs of a frozen index
+		PID_t _pid = Constraint_store_t::END_LIST;				///< The current constraint of a frozen index
 
 		/**
 		 * Initialize iterator to a given position of a sublist
@@ -934,6 +1336,29 @@ namespace chr {
 		Constraint_store_index_iterator_hash(Constraint_store_t& store, typename Constraint_store_t::Sublist_t::iterator it)
 			: _store(store), _it(it)
 		{ }
+
+		/**
+		 * Initialize iterator to the PIDs of a key of a frozen index.
+		 * @param store The store of constraints
+		 * @param it An iterator at the end of a sublist (unused)
+		 * @param first The first PID of the key
+		 * @param last The end of the PIDs of the key
+		 */
+		Constraint_store_index_iterator_hash(Constraint_store_t& store, typename Constraint_store_t::Sublist_t::iterator it, const PID_t* first, const PID_t* last)
+			: _store(store), _it(it), _p(first), _p_end(last)
+		{
+			skip_removed();
+		}
+
+		/**
+		 * Move a frozen index iterator to the first living constraint from the current PID.
+		 */
+		void skip_removed()
+		{
+			while ((_p != _p_end) && ((*_p == Constraint_store_t::END_LIST) || !_store._store.alive(*_p)))
+				++_p;
+			if (_p != _p_end) _pid = *_p;
+		}
 	};
 
 }
@@ -26,7 +26,7 @@ namespace chr
 	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
 	Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::~Constraint_store_index()
 	{
-		chr::Statistics::dec_memory< chr::Statistics::CONSTRAINT_STORE >(sizeof(Sublist_t*) * _pending_sl.size());
+		chr::Statistics::dec_memory< chr::Statistics::CONSTRAINT_STORE >(sizeof(Sublist_t*) * (_nb_pending + _free_sl.size()) + _frozen_memory);
 	}
 
 	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
@@ -52,6 +52,13 @@ namespace chr
 			return 0;
 
 		auto k = Key_t::build_from_vars(std::forward_as_tuple(args...));
+		if constexpr (FREEZABLE)
+			if (_frozen)
+			{
+				auto& f_index = std::get<N_INDEX>(_frozen_indexes);
+				auto s = f_index.find( k );
+				return (s == nullptr) ? 0 : f_index.size(*s);
+			}
 		auto it = std::get<N_INDEX>(_indexes).find( k );
 		if (it == std::get<N_INDEX>(_indexes).end())
 			return 0; // Iterator already at end
@@ -70,6 +77,16 @@ namespace chr
 			return Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::iterator_hash(*this, Sublist_t().end()); // Iterator already at end
 
 		auto k = Key_t::build_from_vars(std::forward_as_tuple(args...));
+		if constexpr (FREEZABLE)
+			if (_frozen)
+			{
+				auto& f_index = std::get<N_INDEX>(_frozen_indexes);
+				auto s = f_index.find( k );
+				if (s == nullptr)
+					return Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::iterator_hash(*this, Sublist_t().end()); // Iterator already at end
+				auto pids = f_index.pids(*s);
+				return Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::iterator_hash(*this, Sublist_t().end(), pids.first, pids.second);
+			}
 		auto it = std::get<N_INDEX>(_indexes).find( k );
 		if (it == std::get<N_INDEX>(_indexes).end())
 			return Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::iterator_hash(*this, Sublist_t().end()); // Iterator already at end
@@ -109,7 +126,7 @@ namespace chr
 			auto res = std::get<I>(_indexes).insert( { std::move( k ), std::move( ie ) } );
 			if (res.second)
 			{
-				auto sl = std::make_unique<Sublist_t>();
+				auto sl = new_sublist();
 				sl->insert( pid );
 				(res.first.value())._sublist = std::move( sl );
 			} else {
@@ -121,16 +138,109 @@ namespace chr
 		}(), ...);
 	}
 
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	template< size_t... I >
+	void Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::loop_check_range(const T& e, std::index_sequence<I...>) const
+	{
+		([&]{
+			using Index_t = typename std::tuple_element<I,TupleIndexes0>::type;
+			if constexpr (LNS::Is_dense_index< Index_t >::value)
+			{
+				using Key_t = typename std::tuple_element<I,TupleKey_t>::type;
+				using Map_t = typename std::tuple_element<I,TupleMap_t>::type;
+				if (typename Map_t::hasher()(Key_t::template build_from_constraint<T,Index_t>(e)) >= Map_t::SIZE)
+					throw std::out_of_range("key out of the range of a dense index");
+			}
+		}(), ...);
+	}
+
 	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
 	typename Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::iterator Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::add(T e)
 	{
+		if constexpr (dense_indexes<TupleIndexes>::value)
+			loop_check_range(e,std::make_index_sequence<INDEX_COUNT>());
 		prepare_rollback_point();
+		thaw();
 		auto it = _store.insert( std::move(e) );
 		// Build all indexes
 		loop_add(*it,it.pid(),std::make_index_sequence<INDEX_COUNT>());
 		return Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::iterator(*this,it);
 	}
 
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	template< size_t... I >
+	void Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::loop_load(const std::vector< PID_t >& pids, std::index_sequence<I...>)
+	{
+		([&]{
+			using Key_t = typename std::tuple_element<I,TupleKey_t>::type;
+			using Index_t = typename std::tuple_element<I,TupleIndexes0>::type;
+			using Hash_t = typename std::tuple_element<I,TupleMap_t>::type::hasher;
+			using Entry = Load_entry< Key_t >;
+			std::vector< Entry > entries;
+			entries.reserve(pids.size());
+			for (auto pid : pids)
+			{
+				Key_t k( Key_t::template build_from_constraint<T,Index_t>(_store.get(pid)) );
+				auto hash_value = Hash_t()(k);
+				entries.push_back( Entry{ hash_value, pid, std::move(k) } );
+			}
+			// Group the constraints by key (the order of insertion is kept for a same key)
+			std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a._hash < b._hash; });
+
+			auto& map = std::get<I>(_indexes);
+			std::size_t nb_keys = 0;
+			for (std::size_t i = 0; i < entries.size(); ++i)
+				if ((i == 0) || (entries[i]._hash != entries[i - 1]._hash)) ++nb_keys;
+			map.reserve(map.size() + nb_keys);
+
+			Sublist_t* sl = nullptr;
+			for (std::size_t i = 0; i < entries.size(); ++i)
+			{
+				if ((i == 0) || (entries[i]._hash != entries[i - 1]._hash) || !(entries[i]._k == entries[i - 1]._k))
+				{
+					Index_element_t ie(Backtrack::depth());
+					auto res = map.insert( { entries[i]._k, std::move( ie ) } );
+					if (res.second)
+					{
+						// Number of constraints with the same key in the sorted run
+						std::size_t n = 1;
+						while (((i + n) < entries.size()) && (entries[i + n]._hash == entries[i]._hash) && (entries[i + n]._k == entries[i]._k))
+							++n;
+						(res.first.value())._sublist = new_sublist();
+						(res.first.value())._sublist->reserve(n);
+					}
+					sl = (res.first.value())._sublist.get();
+				}
+				sl->insert( entries[i]._pid );
+				// Schedule index callback
+				schedule_index_callback<I>(_store.get(entries[i]._pid),std::make_index_sequence<Index_t::size>());
+			}
+		}(), ...);
+	}
+
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	typename Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::iterator Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::load(std::vector< T > cs)
+	{
+		if (cs.empty()) return end();
+		if constexpr (dense_indexes<TupleIndexes>::value)
+			for (const auto& e : cs)
+				loop_check_range(e,std::make_index_sequence<INDEX_COUNT>());
+		prepare_rollback_point();
+		thaw();
+		_store.reserve(cs.size());
+		std::vector< PID_t > pids;
+		pids.reserve(cs.size());
+		typename Store_list_t::iterator it = _store.end();
+		for (std::size_t i = cs.size(); i > 0; --i)
+		{
+			it = _store.insert( std::move(cs[i - 1]) );
+			pids.push_back( it.pid() );
+		}
+		// Build all indexes
+		loop_load(pids,std::make_index_sequence<INDEX_COUNT>());
+		return Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::iterator(*this,it);
+	}
+
 	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
 	template< size_t... I >
 	void Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::loop_remove(const T& e, PID_t pid_e, std::index_sequence<I...>)
@@ -139,7 +249,7 @@ namespace chr
 			// Retrieve element at key from_key
 			using Index_t = typename std::tuple_element<I,TupleIndexes>::type;
 			using Key_t = typename std::tuple_element<I,TupleKey_t>::type;
-			using Hash_t = typename std::tuple_element<I,TupleKey_t>::type::Hash;
+			using Hash_t = typename std::tuple_element<I,TupleMap_t>::type::hasher;
 			Key_t k = Key_t::template build_from_constraint<T,Index_t>(e);
 			auto hash_value = Hash_t()(k);
 			auto res = std::get<I>(_indexes).find( k, hash_value );
@@ -164,10 +274,7 @@ namespace chr
 			// Remove hash tag if list is empty and no need to backtrack this removal
 			if (!p_sl->has_rollback_point() && p_sl->empty())
 			{
-				if (p_sl->safe_delete())
-					p_sl.reset(nullptr);
-				else
-					add_to_pending_list( std::move(p_sl) );
+				release_sublist( std::move(p_sl) );
 				std::get<I>(_indexes).erase( std::move( k ), hash_value );
 			}
 		}(), ...);
@@ -181,7 +288,11 @@ namespace chr
 
 		const T& e = _store.get(pid);
 		// Remove all index elements that involve this constraint
-		loop_remove(e,pid,std::make_index_sequence<INDEX_COUNT>());
+		if constexpr (FREEZABLE)
+			if (_frozen || _thawed)
+				loop_frozen_remove(e,pid,std::make_index_sequence<INDEX_COUNT>());
+		if (!_frozen)
+			loop_remove(e,pid,std::make_index_sequence<INDEX_COUNT>());
 		// Remove the constraint from the main store
 		_store.remove(pid);
 	}
@@ -191,11 +302,10 @@ namespace chr
 	void Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::update_index(typename std::tuple_element<N_INDEX,TupleKey_t>::type from_key, typename std::tuple_element<N_INDEX,TupleKey_t>::type to_key)
 	{
 		static_assert(N_INDEX < INDEX_COUNT, "The index number exceeds the maximum number of indexes");
-		using Key_t = typename std::tuple_element<N_INDEX,TupleKey_t>::type;
 		auto& index_map = std::get<N_INDEX>(_indexes);
 
 		 // Retrieve element at key from_key
-		 auto from_hash_value = typename Key_t::Hash()(from_key);
+		 auto from_hash_value = index_map.hash_function()(from_key);
 		 auto from_it = index_map.find(from_key, from_hash_value);
 		 if (from_it == index_map.end())
 			 // We don't find the key, because the constraint has been previously moved because
@@ -211,7 +321,7 @@ namespace chr
 		Sublist_t* to_sublist = nullptr;
 		if (to_pair_it.second)
 		{
-			(to_pair_it.first.value())._sublist = std::make_unique<Sublist_t>();
+			(to_pair_it.first.value())._sublist = new_sublist();
 			to_sublist = (to_pair_it.first.value())._sublist.get();
 			// Keep index update callback
 			from_it = index_map.find(from_key); // refresh from_it because of new insert
@@ -232,34 +342,87 @@ namespace chr
 		// Remove hash tag if list is empty and no need to backtrack this removal
 		if (!from_sublist->has_rollback_point() && from_sublist->empty())
 		{
-			if (from_sublist->safe_delete())
-				from_sublist.reset(nullptr);
-			else
-				add_to_pending_list( std::move(from_sublist) );
+			release_sublist( std::move(from_sublist) );
 			index_map.erase( std::move( from_key ), from_hash_value );
 		}
 	}
 
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	void Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::release_sublist(std::unique_ptr<Constraint_store_index::Sublist_t>&& sl)
+	{
+		if (sl->safe_delete())
+			add_to_free_list( std::move(sl) );
+		else
+			add_to_pending_list( std::move(sl) );
+	}
+
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	void Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::add_to_free_list(std::unique_ptr<Constraint_store_index::Sublist_t>&& sl)
+	{
+		if (_free_sl.size() >= CHR_INDEX_MAX_FREE_SUBLISTS) return; // sl is destroyed
+		_free_sl.push_back(std::move(sl));
+		chr::Statistics::inc_memory< chr::Statistics::CONSTRAINT_STORE >(sizeof(Sublist_t*));
+	}
+
 	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
 	void Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::add_to_pending_list(std::unique_ptr<Constraint_store_index::Sublist_t>&& sl)
 	{
-		auto it = _pending_sl.begin();
-		auto it_end = _pending_sl.end();
-		while (it != it_end)
+		reclaim_pending_sublists(false);
+		Depth_t d = Backtrack::depth();
+		if (_pending_sl.size() <= d)
+			_pending_sl.resize(d + 1);
+		_pending_sl[d].push_back(std::move(sl));
+		++_nb_pending;
+		chr::Statistics::inc_memory< chr::Statistics::CONSTRAINT_STORE >(sizeof(Sublist_t*));
+	}
+
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	void Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::reclaim_pending_sublists(bool scan_current)
+	{
+		if (_nb_pending == 0) return;
+		Depth_t d = Backtrack::depth();
+		// The buckets deeper than the current depth have been left by a backtrack
+		while (_pending_sl.size() > std::size_t(d) + 1)
 		{
-			if ((*it)->safe_delete())
-			{
-				// If we found a new safe delete list, we delete it
-				// and put sl instead
-				sl.swap(*it);
-				sl.reset(nullptr);
-				return;
-			}
-			++it;
+			for (auto& sl : _pending_sl.back())
+				if (sl->safe_delete())
+				{
+					--_nb_pending;
+					chr::Statistics::dec_memory< chr::Statistics::CONSTRAINT_STORE >(sizeof(Sublist_t*));
+					add_to_free_list( std::move(sl) );
+				} else
+					_pending_sl[d].push_back(std::move(sl)); // Still locked by an iterator of a lower depth
+			_pending_sl.pop_back();
+		}
+		// Any sublist of the current depth may have been unlocked: a sublist
+		// kept locked by a long-lived iterator must not hold back the others
+		if (scan_current && (d < _pending_sl.size()))
+		{
+			auto& bucket = _pending_sl[d];
+			for (std::size_t i = 0; i < bucket.size(); )
+				if (bucket[i]->safe_delete())
+				{
+					--_nb_pending;
+					chr::Statistics::dec_memory< chr::Statistics::CONSTRAINT_STORE >(sizeof(Sublist_t*));
+					add_to_free_list( std::move(bucket[i]) );
+					bucket[i] = std::move(bucket.back());
+					bucket.pop_back();
+				} else
+					++i;
 		}
-		// No safe delete list found in the pending list, add sl to the end
-		_pending_sl.push_back(std::move(sl));
-		chr::Statistics::inc_memory< chr::Statistics::CONSTRAINT_STORE >(sizeof(Sublist_t*));
+	}
+
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	std::unique_ptr< typename Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::Sublist_t > Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::new_sublist()
+	{
+		reclaim_pending_sublists(_free_sl.empty());
+		if (_free_sl.empty())
+			return std::make_unique<Sublist_t>();
+		auto sl = std::move(_free_sl.back());
+		_free_sl.pop_back();
+		chr::Statistics::dec_memory< chr::Statistics::CONSTRAINT_STORE >(sizeof(Sublist_t*));
+		sl->recycle();
+		return sl;
 	}
 
 	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
@@ -282,6 +445,108 @@ namespace chr
 		}
 	}
 
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	void Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::thaw()
+	{
+		if (!_frozen) return;
+		_frozen = false;
+		_thawed = true;
+		// Build the indexes, the constraints are given from the last one so that
+		// the sublists keep the order of the store
+		std::vector< PID_t > pids;
+		pids.reserve(_store.size());
+		for (PID_t p = _store._last; p != Store_list_t::END_LIST; p = _store.node(p)._prev)
+			if (_store.alive(p)) pids.push_back(p);
+		loop_load(pids,std::make_index_sequence<INDEX_COUNT>());
+	}
+
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	void Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::release_frozen_indexes()
+	{
+		std::apply([](auto&... f_index) { (f_index.clear(), ...); }, _frozen_indexes);
+		chr::Statistics::dec_memory< chr::Statistics::CONSTRAINT_STORE >(_frozen_memory);
+		_frozen_memory = 0;
+		_frozen = false;
+		_thawed = false;
+	}
+
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	template< size_t... I >
+	bool Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::loop_freeze(std::index_sequence<I...>)
+	{
+		return ([&]{
+			using Key_t = typename std::tuple_element<I,TupleKey_t>::type;
+			auto& map = std::get<I>(_indexes);
+			std::vector< Key_t > keys;
+			std::vector< std::size_t > offsets;
+			std::vector< PID_t > pids;
+			keys.reserve(map.size());
+			offsets.reserve(map.size() + 1);
+			pids.reserve(_store.size());
+			offsets.push_back(0);
+			for (auto it = map.begin(); it != map.end(); ++it)
+			{
+				keys.push_back( (*it).first );
+				for (auto it_sl = (*it).second._sublist->begin(); !it_sl.at_end(); ++it_sl)
+					pids.push_back( *it_sl );
+				offsets.push_back( pids.size() );
+			}
+			auto& f_index = std::get<I>(_frozen_indexes);
+			if (!f_index.build(std::move(keys), offsets, pids))
+				return false;
+			_frozen_memory += f_index.memory();
+			chr::Statistics::inc_memory< chr::Statistics::CONSTRAINT_STORE >(f_index.memory());
+			return true;
+		}() && ...);
+	}
+
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	template< size_t... I >
+	void Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::loop_frozen_remove(const T& e, PID_t pid_e, std::index_sequence<I...>)
+	{
+		([&]{
+			using Index_t = typename std::tuple_element<I,TupleIndexes>::type;
+			using Key_t = typename std::tuple_element<I,TupleKey_t>::type;
+			std::get<I>(_frozen_indexes).remove( Key_t::template build_from_constraint<T,Index_t>(e), pid_e );
+		}(), ...);
+	}
+
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	bool Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::freeze()
+	{
+		if constexpr (!FREEZABLE)
+			return false;
+		else
+		{
+			if (_frozen) return true;
+			// A locked constraint may be referenced by an iterator on the current indexes
+			if (_store.has_locked_node())
+				return false;
+			if (!std::apply([](auto&... map) {
+					return ([&]{
+						for (auto& e : map)
+							if (e.second._sublist->has_locked_node()) return false;
+						return true;
+					}() && ...);
+				}, _indexes))
+				return false;
+
+			release_frozen_indexes();
+			if (!loop_freeze(std::make_index_sequence<INDEX_COUNT>()))
+			{
+				release_frozen_indexes();
+				return false;
+			}
+			_frozen = true;
+
+			// Give back the robin_map indexes and the free sublists
+			std::apply([](auto&... map) { ((map = std::decay_t< decltype(map) >()), ...); }, _indexes);
+			chr::Statistics::dec_memory< chr::Statistics::CONSTRAINT_STORE >(sizeof(Sublist_t*) * _free_sl.size());
+			_free_sl.clear();
+			return true;
+		}
+	}
+
 	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
 	template< size_t... I >
 	void Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::loop_rewind(Depth_t new_depth, std::index_sequence<I...>)
@@ -336,9 +601,36 @@ namespace chr
 	void Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::loop_statistics(Statistics& stats, std::index_sequence<I...>) const
 	{
 		([&]{
+			using Hash_t = typename std::tuple_element<I,TupleKey_t>::type::Hash;
+			if constexpr (FREEZABLE)
+				if (_frozen)
+				{
+					auto& f_index = std::get<I>(_frozen_indexes);
+					for (auto* slots : { &f_index.slots(), &f_index.overflow() })
+						for (auto& s : *slots)
+						{
+							std::vector< unsigned long int > c_ids;
+							auto pids = f_index.pids(s);
+							for (auto p = pids.first; p != pids.second; ++p)
+								if ((*p != END_LIST) && _store.alive(*p))
+									c_ids.push_back(std::get<0>(_store.get(*p)));
+							auto& ids = stats.indexes[I][Hash_t()(s._key)];
+							ids.insert(ids.end(), c_ids.begin(), c_ids.end());
+						}
+					return;
+				}
 			 auto& map = std::get<I>(_indexes);
 			 for(auto it = map.begin(); it != map.end(); ++it)
 			 {
+				const Sublist_t& sl = *(*it).second._sublist;
+				++stats.nb_sublists;
+				if (sl.is_inline())
+				{
+					++stats.nb_inline;
+					stats.sublist_memory += sizeof(Sublist_t);
+				} else
+					stats.sublist_memory += sizeof(Sublist_t) + sizeof(typename Sublist_t::Node) * sl._capacity;
+
 				std::vector< unsigned long int > c_ids;
 				auto it_sl = (*it).second._sublist->begin();
 				while (!it_sl.at_end())
@@ -346,7 +638,6 @@ namespace chr
 					c_ids.push_back(std::get<0>(_store.get(*it_sl)));
 					++it_sl;
 				}
-				using Hash_t = typename std::tuple_element<I,TupleKey_t>::type::Hash;
 				auto hash_value = Hash_t()((*it).first);
 				auto res = stats.indexes[I].insert( { hash_value, c_ids } );
 				if (!res.second)
@@ -363,8 +654,12 @@ namespace chr
 	{
 		Statistics stats;
 		stats.size = _store.size();
-		stats.nb_pending = _pending_sl.size();
-		auto it = const_cast< Bt_list<T,ENABLE_BACKTRACK,false,chr::Statistics::CONSTRAINT_STORE>* >(&_store)->begin();
+		stats.nb_pending = _nb_pending;
+		stats.nb_free = _free_sl.size();
+		stats.nb_sublists = 0;
+		stats.nb_inline = 0;
+		stats.sublist_memory = 0;
+		auto it = const_cast< Store_list_t* >(&_store)->begin();
 		while (!it.at_end())
 		{
 			stats.constraints.push_back(std::get<0>(*it));
@@ -375,6 +670,108 @@ namespace chr
 		return stats;
 	}
 
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	template< size_t... I >
+	bool Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::loop_compactable(std::index_sequence<I...>) const
+	{
+		return ([&]{
+			for (auto& e : std::get<I>(_indexes))
+				if (e.second._sublist->has_rollback_point())
+					return false;
+			return true;
+		}() && ...);
+	}
+
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	template< size_t... I >
+	void Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::loop_compact(const std::vector< PID_t >& remap, std::index_sequence<I...>)
+	{
+		([&]{
+			std::vector< PID_t > sl_remap;
+			for (auto it = std::get<I>(_indexes).begin(); it != std::get<I>(_indexes).end(); ++it)
+			{
+				Sublist_t& sl = *(it.value()._sublist);
+				for (auto it_sl = sl.begin(); !it_sl.at_end(); ++it_sl)
+				{
+					assert(remap[*it_sl] != END_LIST);
+					sl.value(it_sl.pid()) = remap[*it_sl];
+				}
+				// May fail if a node of the sublist is locked, the PIDs are updated anyway
+				(void) sl.compact(sl_remap);
+			}
+		}(), ...);
+	}
+
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	bool Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::compact()
+	{
+		if (_store.has_rollback_point() || !loop_compactable(std::make_index_sequence<INDEX_COUNT>()))
+			return false;
+		std::vector< PID_t > remap;
+		if (!_store.compact(remap))
+			return false;
+		loop_compact(remap, std::make_index_sequence<INDEX_COUNT>());
+		// The static indexes of a frozen store are renumbered, the ones kept after a thaw are given back
+		if (_frozen)
+			std::apply([&](auto&... f_index) { (f_index.remap(remap), ...); }, _frozen_indexes);
+		else if (_thawed)
+			release_frozen_indexes();
+
+		// Delete the free sublists and the pending sublists which are now safe
+		std::size_t nb_released = _nb_pending + _free_sl.size();
+		_free_sl.clear();
+		_nb_pending = 0;
+		for (auto& bucket : _pending_sl)
+		{
+			bucket.erase(std::remove_if(bucket.begin(), bucket.end(), [](const auto& sl) { return sl->safe_delete(); }), bucket.end());
+			_nb_pending += bucket.size();
+		}
+		chr::Statistics::dec_memory< chr::Statistics::CONSTRAINT_STORE >(sizeof(Sublist_t*) * (nb_released - _nb_pending));
+		return true;
+	}
+
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	bool Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::save_image(const std::string& path, std::uint64_t tag) const
+	{
+		if constexpr (Store_list_t::IMAGE && chr::Is_image_relocatable< T >::value)
+		{
+			std::ofstream os(path, std::ios::binary | std::ios::trunc);
+			return os && _store.write_image(os, tag) && os.flush();
+		} else {
+			(void) path;
+			(void) tag;
+			return false;
+		}
+	}
+
+	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
+	bool Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::load_image(const std::string& path, std::uint64_t& tag)
+	{
+		if constexpr (Store_list_t::IMAGE && chr::Is_image_relocatable< T >::value)
+		{
+			if (_store._first_unused_pid != 0) return false;
+			thaw();
+			auto image = std::make_unique< Mapped_file >(path, true, false);
+			if (_store._capacity > 0) _store.deallocate_list();
+			if (!_store.map_image(image->data(), image->size(), tag))
+				return false;
+			_image = std::move(image);
+
+			// Build the indexes, the constraints are given from the last one so that
+			// the sublists keep the order of the store
+			std::vector< PID_t > pids;
+			pids.reserve(_store.size());
+			for (PID_t p = _store._last; p != Store_list_t::END_LIST; p = _store.node(p)._prev)
+				if (_store.alive(p)) pids.push_back(p);
+			loop_load(pids,std::make_index_sequence<INDEX_COUNT>());
+			return true;
+		} else {
+			(void) path;
+			(void) tag;
+			return false;
+		}
+	}
+
 	template< typename T, typename TupleIndexes0, bool ENABLE_BACKTRACK0 >
 	std::string Constraint_store_index< T, TupleIndexes0, ENABLE_BACKTRACK0 >::str_index_statistics() const
 	{
@@ -393,7 +790,8 @@ namespace chr
 		}
 		res += "\n";
 
-		res += "Indexes (pending=" + std::to_string(stats.nb_pending) + "):\n";
+		res += "Indexes (pending=" + std::to_string(stats.nb_pending) + ", free=" + std::to_string(stats.nb_free) + ", sublists=" + std::to_string(stats.nb_sublists)
+			+ ", inline=" + std::to_string(stats.nb_inline) + ", memory=" + std::to_string(stats.sublist_memory) + "):\n";
 		unsigned int n_idx = 0;
 		for (auto idx_m : stats.indexes)
 		{
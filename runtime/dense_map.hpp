@@ -0,0 +1,311 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_DENSE_MAP_HH_
+#define RUNTIME_DENSE_MAP_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace chr
+{
+	/**
+	 * @brief Direct-mapped index of a constraint store
+	 *
+	 * A Dense_map maps the keys of a known finite range to values. Each key has
+	 * its own cell, its position in [0, Position_t::SIZE[ is computed by
+	 * Position_t (no hashing, no probing). Only the cells of the span of the
+	 * positions inserted so far are allocated: the array of cells is doubled
+	 * (at least) when a key out of the span is inserted. It is used in place of a robin_map for the indexes whose keys
+	 * are small integers (see LNS::Dense_index) and it offers the part of the
+	 * robin_map interface used by the constraint stores: the position of a key
+	 * is given as its "hash value" (hasher), the cells are visited in the order
+	 * of the positions.
+	 * @tparam Key_t The type of the keys
+	 * @tparam Value_t The type of the values
+	 * @tparam Position_t The functor which returns the position of a key (SIZE if it is out of range)
+	 */
+	template < typename Key_t, typename Value_t, typename Position_t >
+	class Dense_map
+	{
+	public:
+		using key_type = Key_t;
+		using mapped_type = Value_t;
+		using value_type = std::pair< Key_t, Value_t >;
+		using hasher = Position_t;
+		static constexpr std::size_t SIZE = Position_t::SIZE;	///< Number of cells
+
+		static_assert(SIZE < std::numeric_limits< std::uint32_t >::max(), "the range of a dense index is too large");
+
+		/**
+		 * @brief Iterator on the used cells of a Dense_map
+		 */
+		template < bool IS_CONST >
+		class Iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using difference_type = std::ptrdiff_t;
+			using value_type = std::conditional_t< IS_CONST, const typename Dense_map::value_type, typename Dense_map::value_type >;
+			using pointer = value_type*;
+			using reference = value_type&;
+			using Cell_t = std::conditional_t< IS_CONST, const std::optional< typename Dense_map::value_type >, std::optional< typename Dense_map::value_type > >;
+
+			Iterator(Cell_t* p, Cell_t* p_end) : _p(p), _p_end(p_end) { skip_unused(); }
+			Iterator(const Iterator< false >& o) : _p(o._p), _p_end(o._p_end) { }
+
+			reference operator*() const { return **_p; }
+			pointer operator->() const { return &**_p; }
+			const Key_t& key() const { return (*_p)->first; }
+			std::conditional_t< IS_CONST, const Value_t&, Value_t& > value() const { return (*_p)->second; }
+
+			Iterator& operator++() { ++_p; skip_unused(); return *this; }
+			Iterator operator++(int) { Iterator tmp(*this); ++(*this); return tmp; }
+			bool operator==(const Iterator& o) const { return _p == o._p; }
+			bool operator!=(const Iterator& o) const { return _p != o._p; }
+
+		private:
+			friend class Dense_map;
+			friend class Iterator< true >;
+			Cell_t* _p;		///< Current cell
+			Cell_t* _p_end;	///< Cell after the last used one
+
+			/**
+			 * Move the iterator to the next used cell (if the current one is not).
+			 */
+			void skip_unused() { while ((_p != _p_end) && !_p->has_value()) ++_p; }
+		};
+		using iterator = Iterator< false >;
+		using const_iterator = Iterator< true >;
+
+		/**
+		 * Initialize an empty map (the cells are not allocated).
+		 */
+		Dense_map() = default;
+
+		/**
+		 * Copy constructor (deleted).
+		 */
+		Dense_map(const Dense_map&) =delete;
+
+		/**
+		 * Move constructor.
+		 */
+		Dense_map(Dense_map&&) =default;
+
+		/**
+		 * Assignment operator (deleted).
+		 */
+		Dense_map& operator=(const Dense_map&) =delete;
+
+		/**
+		 * Move assignment operator.
+		 */
+		Dense_map& operator=(Dense_map&&) =default;
+
+		iterator begin() { return iterator(cell(_lo), cell(_hi)); }
+		iterator end() { return iterator(cell(_hi), cell(_hi)); }
+		const_iterator begin() const { return const_iterator(cell(_lo), cell(_hi)); }
+		const_iterator end() const { return const_iterator(cell(_hi), cell(_hi)); }
+
+		/**
+		 * Return the number of keys of the map.
+		 * @return The number of keys
+		 */
+		std::size_t size() const { return _size; }
+
+		/**
+		 * Check if the map is empty.
+		 * @return True if the map is empty, false otherwise
+		 */
+		bool empty() const { return _size == 0; }
+
+		/**
+		 * Nothing to do, all the keys have their cell (for compatibility with robin_map).
+		 */
+		void reserve(std::size_t) { }
+
+		/**
+		 * Return the functor which computes the position of a key.
+		 * @return The position functor
+		 */
+		hasher hash_function() const { return hasher(); }
+
+		/**
+		 * Find the key \a k in the map.
+		 * @param k The key
+		 * @param pos The position of \a k (see hasher)
+		 * @return An iterator on the key, end() if the key is not in the map
+		 */
+		iterator find(const Key_t& k, std::size_t pos)
+		{
+			(void) k;
+			assert(pos == hasher()(k));
+			if ((pos < _lo) || (pos >= _hi) || !cell(pos)->has_value()) return end();
+			return iterator(cell(pos), cell(_hi));
+		}
+
+		/**
+		 * Find the key \a k in the map.
+		 * @param k The key
+		 * @return An iterator on the key, end() if the key is not in the map
+		 */
+		iterator find(const Key_t& k) { return find(k, hasher()(k)); }
+
+		/**
+		 * Find the key \a k in the map.
+		 * @param k The key
+		 * @return An iterator on the key, end() if the key is not in the map
+		 */
+		const_iterator find(const Key_t& k) const { return const_cast< Dense_map* >(this)->find(k); }
+
+		/**
+		 * Insert the key and value \a v if the key is not in the map. An exception
+		 * is thrown if the key is out of the range of the map.
+		 * @param v The key and its value
+		 * @return An iterator on the key and true if it has been inserted, false if it was in the map
+		 */
+		std::pair< iterator, bool > insert(value_type&& v)
+		{
+			std::size_t pos = hasher()(v.first);
+			if (pos >= SIZE) throw std::out_of_range("key out of the range of a dense index");
+			if ((pos < _base) || (pos >= _base + _capacity))
+				grow(pos);
+			if (_size == 0)
+			{
+				_lo = pos;
+				_hi = pos + 1;
+			} else {
+				_lo = std::min(_lo, pos);
+				_hi = std::max(_hi, pos + 1);
+			}
+			auto* p = cell(pos);
+			if (p->has_value())
+				return { iterator(p, cell(_hi)), false };
+			p->emplace( std::move(v) );
+			++_size;
+			return { iterator(p, cell(_hi)), true };
+		}
+
+		/**
+		 * Remove the key pointed by \a it from the map.
+		 * @param it The iterator on the key
+		 * @return An iterator on the next key
+		 */
+		iterator erase(const_iterator it)
+		{
+			auto* p = _cells.get() + (it._p - _cells.get());
+			assert(p->has_value());
+			p->reset();
+			--_size;
+			return iterator(p, cell(_hi));
+		}
+
+		/**
+		 * Remove the key \a k from the map.
+		 * @param k The key
+		 * @param pos The position of \a k (see hasher)
+		 * @return The number of keys removed (0 or 1)
+		 */
+		std::size_t erase(const Key_t& k, std::size_t pos)
+		{
+			auto it = find(k, pos);
+			if (it == end()) return 0;
+			erase(it);
+			return 1;
+		}
+
+		/**
+		 * Remove the key \a k from the map.
+		 * @param k The key
+		 * @return The number of keys removed (0 or 1)
+		 */
+		std::size_t erase(const Key_t& k) { return erase(k, hasher()(k)); }
+
+		/**
+		 * Remove all the keys and give back the cells.
+		 */
+		void clear()
+		{
+			_cells.reset();
+			_base = 0;
+			_capacity = 0;
+			_size = 0;
+			_lo = 0;
+			_hi = 0;
+		}
+
+	private:
+		static constexpr std::size_t MIN_CELLS = 16;	///< Number of cells of the first allocation (if the range is large enough)
+
+		std::unique_ptr< std::optional< value_type >[] > _cells;	///< The cells of the positions [_base, _base + _capacity[
+		std::size_t _base = 0;										///< Position of the first cell
+		std::size_t _capacity = 0;									///< Number of cells
+		std::size_t _size = 0;										///< Number of keys
+		std::size_t _lo = 0;										///< Position of the first cell which may be used
+		std::size_t _hi = 0;										///< Position after the last cell which may be used
+
+		/**
+		 * Return the cell of position \a pos.
+		 * @param pos The position, in [_base, _base + _capacity]
+		 * @return A pointer to the cell
+		 */
+		std::optional< value_type >* cell(std::size_t pos) const { return _cells.get() + (pos - _base); }
+
+		/**
+		 * Reallocate the cells so that they hold position \a pos and the used
+		 * cells. The number of cells is at least doubled, the used cells are
+		 * moved to the new array.
+		 * @param pos The position to add, in [0, SIZE[
+		 */
+		void grow(std::size_t pos)
+		{
+			std::size_t lo = (_size == 0) ? pos : std::min(_lo, pos);
+			std::size_t hi = (_size == 0) ? (pos + 1) : std::max(_hi, pos + 1);
+			std::size_t capacity = std::min(SIZE, std::max({ hi - lo, 2 * _capacity, MIN_CELLS }));
+			// The new cells are added on the side of the new position
+			std::size_t base;
+			if ((_size > 0) && (pos < _lo))
+				base = (hi >= capacity) ? (hi - capacity) : 0;
+			else
+				base = std::min(lo, SIZE - capacity);
+			std::unique_ptr< std::optional< value_type >[] > cells(new std::optional< value_type >[capacity]);
+			if (_size > 0)
+				for (std::size_t p = _lo; p < _hi; ++p)
+					if (cell(p)->has_value())
+						cells[p - base].emplace( std::move(**cell(p)) );
+			_cells = std::move(cells);
+			_base = base;
+			_capacity = capacity;
+		}
+	};
+}
+
+#endif /* RUNTIME_DENSE_MAP_HH_ */
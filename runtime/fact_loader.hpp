@@ -0,0 +1,291 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_FACT_LOADER_HH_
+#define RUNTIME_FACT_LOADER_HH_
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mapped_file.hpp>
+
+/**
+ * \defgroup Fact_loader Loading of ground facts from text files
+ *
+ * A text file of ground facts has one fact per line and the fields of a
+ * line are separated by a single character (',' for CSV, '\\t' for TSV).
+ * Empty lines and lines starting with '#' are skipped. A field may be
+ * enclosed in double quotes, a double quote is then written twice ("")
+ * and the field may contain the separator (but not a new line).
+ *
+ * chr::read_facts() maps the file in memory, splits it into chunks at line
+ * boundaries and parses the chunks in parallel into tuples of the argument
+ * types. For each constraint, chrppc generates a load_<c>_file() member
+ * function template which reads the facts of a file and gives them to the
+ * bulk loading of the constraint (load_<c>()). It is instantiated only for
+ * the constraints which are loaded from a file.
+ */
+
+namespace chr
+{
+	namespace internal
+	{
+		/**
+		 * Parse the field \a s into \a v. Integers, floating point numbers,
+		 * booleans (true, false, 1, 0) and strings are parsed directly, the
+		 * other types with their operator>> if any.
+		 * @param s The text of the field (without quotes)
+		 * @param v The value parsed
+		 * @return True if the field has been parsed, false otherwise
+		 */
+		template < typename T >
+		bool parse_field(std::string_view s, T& v)
+		{
+			if constexpr (std::is_same_v< T, bool >)
+			{
+				if ((s == "1") || (s == "true")) v = true;
+				else if ((s == "0") || (s == "false")) v = false;
+				else return false;
+				return true;
+			}
+			else if constexpr (std::is_same_v< T, char >)
+			{
+				if (s.size() != 1) return false;
+				v = s[0];
+				return true;
+			}
+			else if constexpr (std::is_arithmetic_v< T >)
+			{
+				if (!s.empty() && (s[0] == '+')) s.remove_prefix(1);
+				auto res = std::from_chars(s.data(), s.data() + s.size(), v);
+				return (res.ec == std::errc()) && (res.ptr == s.data() + s.size());
+			}
+			else if constexpr (std::is_constructible_v< T, std::string_view >)
+			{
+				v = T(s);
+				return true;
+			}
+			else if constexpr (requires (std::istream& is, T& x) { is >> x; })
+			{
+				std::istringstream is{ std::string(s) };
+				return static_cast< bool >(is >> v) && (is >> std::ws).eof();
+			}
+			else
+				return false;
+		}
+
+		/**
+		 * Return the next field of \a line, starting at \a pos, and move
+		 * \a pos after its separator. The quotes of a quoted field are
+		 * removed in \a buffer.
+		 * @param line The line
+		 * @param pos The position of the field in \a line, updated to the next field (past the end of \a line after the last field, npos on a syntax error)
+		 * @param sep The separator of the fields
+		 * @param buffer The buffer of a quoted field
+		 * @return The text of the field
+		 */
+		inline std::string_view next_field(std::string_view line, std::size_t& pos, char sep, std::string& buffer)
+		{
+			if ((pos < line.size()) && (line[pos] == '"'))
+			{
+				buffer.clear();
+				std::size_t i = pos + 1;
+				while (i < line.size())
+				{
+					if (line[i] == '"')
+					{
+						if (((i + 1) < line.size()) && (line[i + 1] == '"'))
+						{
+							buffer.push_back('"');
+							i += 2;
+							continue;
+						}
+						break;
+					}
+					buffer.push_back(line[i++]);
+				}
+				if (i >= line.size()) pos = std::string_view::npos; // No closing quote
+				else if ((i + 1) >= line.size()) pos = line.size() + 1;
+				else if (line[i + 1] == sep) pos = i + 2;
+				else pos = std::string_view::npos; // Garbage after the closing quote
+				return buffer;
+			}
+			std::size_t e = line.find(sep, pos);
+			std::string_view f = line.substr(pos, (e == std::string_view::npos) ? std::string_view::npos : e - pos);
+			pos = (e == std::string_view::npos) ? line.size() + 1 : e + 1;
+			return f;
+		}
+
+		/**
+		 * @brief Result of the parsing of a chunk of facts
+		 */
+		template < typename Tuple >
+		struct Fact_chunk
+		{
+			std::vector< Tuple > facts;			///< Facts parsed
+			std::size_t nb_lines = 0;			///< Number of lines read
+			std::size_t error_line = 0;			///< Line (in the chunk, from 1) of the first error, 0 if none
+			std::size_t error_field = 0;		///< Field (from 1) of the first error
+		};
+
+		/**
+		 * Parse the facts of the lines of \a text.
+		 * @param text The text of the chunk (whole lines)
+		 * @param sep The separator of the fields
+		 * @param chunk The result of the parsing
+		 */
+		template < typename... Ts >
+		void parse_chunk(std::string_view text, char sep, Fact_chunk< std::tuple< Ts... > >& chunk)
+		{
+			std::string buffer;
+			std::size_t b = 0;
+			chunk.facts.reserve(std::count(text.begin(), text.end(), '\n') + 1);
+			while (b < text.size())
+			{
+				std::size_t e = text.find('\n', b);
+				if (e == std::string_view::npos) e = text.size();
+				std::string_view line = text.substr(b, e - b);
+				b = e + 1;
+				++chunk.nb_lines;
+				if (!line.empty() && (line.back() == '\r')) line.remove_suffix(1);
+				if (line.empty() || (line[0] == '#')) continue;
+
+				std::tuple< Ts... > t;
+				std::size_t pos = 0;
+				std::size_t n_field = 0;
+				bool ok = std::apply([&](auto&... v) {
+					return ([&] {
+						++n_field;
+						if (pos > line.size()) return false;
+						return parse_field(next_field(line, pos, sep, buffer), v) && (pos != std::string_view::npos);
+					}() && ...);
+				}, t);
+				if (ok && (pos <= line.size()))
+				{
+					// Too many fields
+					ok = false;
+					++n_field;
+				}
+				if (!ok)
+				{
+					chunk.error_line = chunk.nb_lines;
+					chunk.error_field = n_field;
+					return;
+				}
+				chunk.facts.push_back( std::move(t) );
+			}
+		}
+	}
+
+	/**
+	 * Parse the facts of \a text, each fact is a tuple of values of types Ts.
+	 * The text is split into chunks at line boundaries which are parsed
+	 * concurrently. The order of the facts is the one of the text.
+	 * An exception is thrown at the first line which can't be parsed.
+	 * @param text The text of the facts
+	 * @param sep The separator of the fields
+	 * @param nb_threads The number of threads (0 for the number of hardware threads)
+	 * @param name The name of the text used in the error messages
+	 * @return The vector of facts
+	 * \ingroup Fact_loader
+	 */
+	template < typename... Ts >
+	std::vector< std::tuple< Ts... > > parse_facts(std::string_view text, char sep = ',', unsigned int nb_threads = 0, const std::string& name = "facts")
+	{
+		using Chunk = internal::Fact_chunk< std::tuple< Ts... > >;
+		constexpr std::size_t MIN_CHUNK_SIZE = 1 << 20;	// A thread is not worth less than 1MB of text
+		if (nb_threads == 0) nb_threads = std::max(1u, std::thread::hardware_concurrency());
+		std::size_t nb_chunks = std::max< std::size_t >(1, std::min< std::size_t >(nb_threads, text.size() / MIN_CHUNK_SIZE));
+
+		// Split the text at line boundaries
+		std::vector< std::string_view > parts;
+		std::size_t b = 0;
+		for (std::size_t i = 1; i <= nb_chunks; ++i)
+		{
+			std::size_t e = (i == nb_chunks) ? text.size() : (text.size() / nb_chunks) * i;
+			if (e < b) e = b;
+			if (e < text.size())
+			{
+				e = text.find('\n', e);
+				e = (e == std::string_view::npos) ? text.size() : e + 1;
+			}
+			parts.push_back( text.substr(b, e - b) );
+			b = e;
+		}
+
+		std::vector< Chunk > chunks(parts.size());
+		if (parts.size() == 1)
+			internal::parse_chunk(parts[0], sep, chunks[0]);
+		else
+		{
+			std::vector< std::thread > threads;
+			threads.reserve(parts.size());
+			for (std::size_t i = 0; i < parts.size(); ++i)
+				threads.emplace_back([&, i]() { internal::parse_chunk(parts[i], sep, chunks[i]); });
+			for (auto& t : threads)
+				t.join();
+		}
+
+		std::size_t nb_lines = 0;
+		std::size_t nb_facts = 0;
+		for (auto& c : chunks)
+		{
+			if (c.error_line > 0)
+				throw std::runtime_error( name + ":" + std::to_string(nb_lines + c.error_line) + ": unable to parse field " + std::to_string(c.error_field) );
+			nb_lines += c.nb_lines;
+			nb_facts += c.facts.size();
+		}
+		if (chunks.size() == 1) return std::move(chunks[0].facts);
+		std::vector< std::tuple< Ts... > > facts;
+		facts.reserve(nb_facts);
+		for (auto& c : chunks)
+			std::move(c.facts.begin(), c.facts.end(), std::back_inserter(facts));
+		return facts;
+	}
+
+	/**
+	 * Read the facts of the file \a path (see parse_facts()).
+	 * @param path The path of the file
+	 * @param sep The separator of the fields
+	 * @param nb_threads The number of threads (0 for the number of hardware threads)
+	 * @return The vector of facts
+	 * \ingroup Fact_loader
+	 */
+	template < typename... Ts >
+	std::vector< std::tuple< Ts... > > read_facts(const std::string& path, char sep = ',', unsigned int nb_threads = 0)
+	{
+		Mapped_file f(path);
+		return parse_facts< Ts... >(f.view(), sep, nb_threads, path);
+	}
+}
+
+#endif /* RUNTIME_FACT_LOADER_HH_ */
@@ -0,0 +1,443 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_FIBER_HH_
+#define RUNTIME_FIBER_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// The ucontext API of macOS is only declared when _XOPEN_SOURCE is defined
+// (before any system header), otherwise <ucontext.h> stops the compilation
+#if defined(__APPLE__) && !defined(_XOPEN_SOURCE)
+#elif __has_include(<ucontext.h>)
+#include <ucontext.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define CHR_ENABLE_FIBER
+#endif
+
+#include <statistics.hh>
+#include <backtrack.hh>
+
+/**
+ * \defgroup Fiber Suspendable CHR runs
+ *
+ * A chr::Fiber runs a CHR program on its own call stack, on the thread of
+ * the caller. The run can be suspended (chr::Fiber::suspend()) from any
+ * depth of the generated code and resumed later: the choice points which
+ * are open stay on the stack of the fiber and the backtrack state of the
+ * thread (depth, observers, failure status, limits, ...) is exchanged with
+ * the one of the fiber at each switch. Several CHR programs can thus be
+ * interleaved on a single thread, each one in its own fiber, without OS threads.
+ *
+ * When the CHR program is compiled with the --enable-suspend_points option
+ * of chrppc, the generated code calls chr::Fiber::choice_point() at each
+ * choice point (disjunction alternative and behavior iteration). A fiber
+ * with a quantum is then suspended every \e quantum choice points, which is
+ * used by chr::Fiber_scheduler to share the thread between many searches.
+ *
+ * The CHR program must be created inside the function of the fiber, as for
+ * chr::run_async(), so that its stores register to the backtrack state of
+ * the fiber. Fibers rely on the ucontext API. When it is not available, a
+ * fiber runs its function up to the end at its first resume. On macOS, the
+ * ucontext API is only used when _XOPEN_SOURCE is defined before the first
+ * include, so that including chrpp.hh never requires it.
+ */
+
+namespace chr
+{
+	/**
+	 * @brief Stackful coroutine which runs a CHR program
+	 *
+	 * A fiber starts its function at its first resume() and returns to the
+	 * caller of resume() each time the function calls suspend() or ends.
+	 * Destroying a fiber which has not ended cancels its run (through the
+	 * cancellation flag of the fiber, see chr::Cancellation) and resumes it
+	 * until it unwinds, so that the objects of its stack are destroyed.
+	 * \ingroup Fiber
+	 */
+	class Fiber
+	{
+	public:
+		static constexpr std::size_t DEFAULT_STACK_SIZE = 8 * 1024 * 1024;	///< Default size of the call stack of a fiber
+
+		/**
+		 * Initialize.
+		 * @param f The function to run (it creates and calls the CHR program)
+		 * @param stack_size The size of the call stack of the fiber
+		 */
+		explicit Fiber(std::function< void () > f, std::size_t stack_size = DEFAULT_STACK_SIZE)
+			: _f(std::move(f)), _stack_size(stack_size)
+		{
+			_cancellation.flag = &_cancelled;
+		}
+
+		/**
+		 * Copy constructor (deleted).
+		 */
+		Fiber(const Fiber&) =delete;
+
+		/**
+		 * Assignment operator (deleted).
+		 */
+		Fiber& operator=(const Fiber&) =delete;
+
+		/**
+		 * Cancel the run if it has not ended and destroy the fiber.
+		 */
+		~Fiber()
+		{
+			if (_started && !_done)
+			{
+				cancel();
+				while (!_done)
+					switch_in();
+			}
+		}
+
+		/**
+		 * Run the fiber until it suspends or ends. An exception raised by
+		 * the function of the fiber is propagated to the caller.
+		 * @return True if the fiber has not ended, false otherwise
+		 */
+		bool resume()
+		{
+			if (_done) return false;
+			switch_in();
+			if (_exception)
+			{
+				std::exception_ptr e = std::move(_exception);
+				_exception = nullptr;
+				std::rethrow_exception(e);
+			}
+			return !_done;
+		}
+
+		/**
+		 * Check if the function of the fiber has ended.
+		 * @return True if the fiber has ended, false otherwise
+		 */
+		bool done() const { return _done; }
+
+		/**
+		 * Request the cancellation of the run of the fiber. It stops at its next choice point.
+		 */
+		void cancel() { _cancelled.store(true, std::memory_order_relaxed); }
+
+		/**
+		 * Set the number of choice points between two automatic suspensions
+		 * of the fiber (0 to never suspend at choice points).
+		 * @param quantum The number of choice points
+		 */
+		void set_quantum(unsigned long quantum) { _quantum = quantum; }
+
+		/**
+		 * Return the number of choice points reached by the fiber.
+		 * @return The number of choice points
+		 */
+		unsigned long choice_points() const { return _choice_points; }
+
+		/**
+		 * Return the fiber which runs on the current thread.
+		 * @return The current fiber (nullptr if none)
+		 */
+		static Fiber* current() { return current_ref(); }
+
+		/**
+		 * Suspend the current fiber and go back to the caller of resume().
+		 * It does nothing outside of a fiber or when the run of the fiber
+		 * has been cancelled (the run must unwind).
+		 */
+		static void suspend()
+		{
+			Fiber* f = current_ref();
+			if ((f != nullptr) && !f->_cancelled.load(std::memory_order_relaxed))
+				f->switch_out();
+		}
+
+		/**
+		 * Count a choice point of the current fiber and suspend it when its
+		 * quantum is reached. Called by the generated code (--enable-suspend_points).
+		 */
+		static void choice_point()
+		{
+			Fiber* f = current_ref();
+			if (f == nullptr) return;
+			++f->_choice_points;
+			if ((f->_quantum > 0) && (++f->_count >= f->_quantum))
+			{
+				f->_count = 0;
+				suspend();
+			}
+		}
+
+	private:
+		/**
+		 * Return a reference to the fiber which runs on the current thread.
+		 * @return The reference to the current fiber
+		 */
+		static Fiber*& current_ref()
+		{
+			static thread_local Fiber* f = nullptr;
+			return f;
+		}
+
+		/**
+		 * Exchange the backtrack state of the thread with the one of the fiber.
+		 */
+		void swap_states()
+		{
+			chr::Backtrack::swap_state(_backtrack);
+			chr::Cancellation::swap_state(_cancellation);
+			chr::Search_limit::swap_state(_limits);
+			chr::Backjump::swap_state(_backjump);
+			chr::Bound::swap_state(_bound);
+			std::swap(chr::Statistics::top_of_call_stack, _top_of_call_stack);
+		}
+
+		/**
+		 * Switch from the caller of resume() to the fiber.
+		 */
+		void switch_in()
+		{
+			_previous = current_ref();
+			current_ref() = this;
+			swap_states();
+#ifdef CHR_ENABLE_FIBER
+			if (!_started)
+			{
+				_started = true;
+				_stack = std::make_unique< Stack >(_stack_size);
+				chr::Statistics::top_of_call_stack = reinterpret_cast< std::uint8_t* >(_stack->bottom() + _stack->size());
+				getcontext(&_context);
+				_context.uc_stack.ss_sp = _stack->bottom();
+				_context.uc_stack.ss_size = _stack->size();
+				_context.uc_link = nullptr;
+				std::uintptr_t p = reinterpret_cast< std::uintptr_t >(this);
+				makecontext(&_context, reinterpret_cast< void (*)() >(&Fiber::entry), 2,
+						static_cast< unsigned int >((p >> 16) >> 16), static_cast< unsigned int >(p & 0xFFFFFFFF));
+			}
+			swapcontext(&_caller, &_context);
+#else
+			_started = true;
+			run();
+#endif
+			swap_states();
+			current_ref() = _previous;
+		}
+
+		/**
+		 * Switch from the fiber to the caller of resume().
+		 */
+		void switch_out()
+		{
+#ifdef CHR_ENABLE_FIBER
+			swapcontext(&_context, &_caller);
+#endif
+		}
+
+		/**
+		 * Run the function of the fiber and keep its exception if any.
+		 */
+		void run()
+		{
+			try {
+				_f();
+			} catch (...) {
+				_exception = std::current_exception();
+			}
+			_done = true;
+		}
+
+#ifdef CHR_ENABLE_FIBER
+		/**
+		 * @brief Call stack of a fiber
+		 *
+		 * The stack is mapped with mmap: it is not filled and its pages are
+		 * only committed when the fiber uses them, so that many fibers can be
+		 * interleaved with the default size. The page below the stack is a guard
+		 * page (PROT_NONE): an overflow of the stack faults instead of corrupting
+		 * the memory of the program.
+		 */
+		class Stack
+		{
+		public:
+			/**
+			 * Map a stack of at least \a size bytes (rounded up to a
+			 * number of pages) and its guard page.
+			 * @param size The size of the stack
+			 */
+			explicit Stack(std::size_t size)
+			{
+				std::size_t page = static_cast< std::size_t >( sysconf(_SC_PAGESIZE) );
+				_size = ((size + page - 1) / page) * page;
+				_mapped = _size + page;
+				void* p = mmap(nullptr, _mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				if (p == MAP_FAILED) throw std::bad_alloc();
+				if (mprotect(p, page, PROT_NONE) != 0)
+				{
+					munmap(p, _mapped);
+					throw std::bad_alloc();
+				}
+				_base = static_cast< char* >(p);
+				_bottom = _base + page;
+			}
+
+			/**
+			 * Copy constructor (deleted).
+			 */
+			Stack(const Stack&) =delete;
+
+			/**
+			 * Assignment operator (deleted).
+			 */
+			Stack& operator=(const Stack&) =delete;
+
+			/**
+			 * Unmap the stack and its guard page.
+			 */
+			~Stack() { munmap(_base, _mapped); }
+
+			/**
+			 * Return the lowest address of the stack (above the guard page).
+			 * @return The bottom of the stack
+			 */
+			char* bottom() const { return _bottom; }
+
+			/**
+			 * Return the usable size of the stack.
+			 * @return The size of the stack
+			 */
+			std::size_t size() const { return _size; }
+
+		private:
+			char* _base;			///< Start of the mapping (guard page)
+			char* _bottom;			///< Lowest address of the stack
+			std::size_t _size;		///< Usable size of the stack
+			std::size_t _mapped;	///< Size of the mapping
+		};
+
+		/**
+		 * Entry point of the call stack of a fiber.
+		 * @param hi The high part of the address of the fiber
+		 * @param lo The low part of the address of the fiber
+		 */
+		static void entry(unsigned int hi, unsigned int lo)
+		{
+			Fiber* f = reinterpret_cast< Fiber* >(((static_cast< std::uintptr_t >(hi) << 16) << 16) | static_cast< std::uintptr_t >(lo));
+			f->run();
+			f->switch_out();
+		}
+
+		ucontext_t _context;								///< Context of the fiber
+		ucontext_t _caller;									///< Context of the caller of resume()
+		std::unique_ptr< Stack > _stack;					///< Call stack of the fiber
+#endif
+		std::function< void () > _f;						///< Function run by the fiber
+		std::size_t _stack_size;							///< Size of the call stack
+		std::exception_ptr _exception;						///< Exception raised by the function
+		std::atomic< bool > _cancelled = false;				///< Cancellation flag of the run of the fiber
+		bool _started = false;								///< True if the function has been started
+		bool _done = false;									///< True if the function has ended
+		unsigned long _quantum = 0;							///< Number of choice points between two suspensions
+		unsigned long _count = 0;							///< Number of choice points since the last suspension
+		unsigned long _choice_points = 0;					///< Number of choice points reached by the fiber
+		Fiber* _previous = nullptr;							///< Fiber of the caller of resume()
+		chr::Backtrack::Thread_state _backtrack;			///< Backtrack state of the fiber (of the caller when it runs)
+		chr::Cancellation::Thread_state _cancellation;		///< Cancellation state of the fiber (of the caller when it runs)
+		chr::Search_limit::Limits _limits;					///< Search limits of the fiber (of the caller when it runs)
+		chr::Backjump::Thread_state _backjump;				///< Backjumping state of the fiber (of the caller when it runs)
+		chr::Bound::Hook _bound;							///< Bound hook of the fiber (of the caller when it runs)
+		std::uint8_t* _top_of_call_stack = nullptr;			///< Top of the call stack of the fiber (of the caller when it runs)
+	};
+
+	/**
+	 * @brief Round-robin scheduler of fibers
+	 *
+	 * Interleave many CHR runs on the current thread: each run is a fiber
+	 * which is suspended every \e quantum choice points and the fibers are
+	 * resumed in turn until they all end.
+	 * \ingroup Fiber
+	 */
+	class Fiber_scheduler
+	{
+	public:
+		/**
+		 * Initialize.
+		 * @param quantum The number of choice points a fiber runs before the next one is resumed
+		 */
+		explicit Fiber_scheduler(unsigned long quantum = 64) : _quantum(quantum) { }
+
+		/**
+		 * Add a new run to the scheduler. It starts at the next step().
+		 * @param f The function to run (it creates and calls the CHR program)
+		 * @param stack_size The size of the call stack of the fiber
+		 * @return The fiber of the run
+		 */
+		Fiber& spawn(std::function< void () > f, std::size_t stack_size = Fiber::DEFAULT_STACK_SIZE)
+		{
+			_fibers.push_back( std::make_unique< Fiber >(std::move(f), stack_size) );
+			_fibers.back()->set_quantum(_quantum);
+			return *_fibers.back();
+		}
+
+		/**
+		 * Resume each fiber once, the ended fibers are removed.
+		 * @return The number of fibers which have not ended
+		 */
+		std::size_t step()
+		{
+			for (auto& f : _fibers)
+				f->resume();
+			_fibers.erase(std::remove_if(_fibers.begin(), _fibers.end(), [](const auto& f) { return f->done(); }), _fibers.end());
+			return _fibers.size();
+		}
+
+		/**
+		 * Run all fibers until they end.
+		 */
+		void run()
+		{
+			while (step() > 0) { }
+		}
+
+		/**
+		 * Return the number of fibers which have not ended.
+		 * @return The number of fibers
+		 */
+		std::size_t size() const { return _fibers.size(); }
+
+	private:
+		unsigned long _quantum;							///< Number of choice points between two switches
+		std::vector< std::unique_ptr< Fiber > > _fibers;	///< Fibers which have not ended
+	};
+}
+
+#endif /* RUNTIME_FIBER_HH_ */
@@ -0,0 +1,392 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_FROZEN_INDEX_HH_
+#define RUNTIME_FROZEN_INDEX_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace chr
+{
+	/**
+	 * @brief Static index of a frozen constraint store
+	 *
+	 * A Frozen_index maps a fixed set of keys to the PIDs of their constraints.
+	 * It is built once, from the keys and the sublists of an index of a
+	 * constraint store, and only the removal of a PID updates it afterwards.
+	 *
+	 * The keys are placed with a minimal perfect hash function (hash and
+	 * displace): the keys are spread in buckets of about BUCKET_SIZE keys and
+	 * the buckets are placed from the largest one, each one with the first
+	 * displacement which sends all its keys to free positions of a table with
+	 * one percent more positions than keys. The keys placed after the last slot
+	 * are then moved to the free slots, there are as many slots as keys. A
+	 * lookup reads the displacement of the bucket of the key, then compares the
+	 * key of a single slot (no probing). The PIDs of all the
+	 * keys are stored contiguously, ordered by slot. The PID of a key which has
+	 * a single constraint is stored in its slot, such a lookup reads only one slot.
+	 * The (unlikely) keys which share the hash value of a previous key can't be
+	 * told apart by the hash function, they are kept in a small overflow list
+	 * sorted by hash value.
+	 * @tparam Key_t The type of the keys
+	 * @tparam Hash_t The hash function of the keys
+	 * @tparam PID_t The type of the PIDs
+	 * @tparam NO_PID The PID value of a removed constraint
+	 */
+	template < typename Key_t, typename Hash_t, typename PID_t, PID_t NO_PID >
+	class Frozen_index
+	{
+	public:
+		/**
+		 * @brief Slot of a key
+		 */
+		struct Slot
+		{
+			Key_t _key;		///< The key
+			PID_t _first;	///< The PID of the constraint if _count is 1, the position of the first PID in _pids otherwise
+			PID_t _count;	///< Number of PIDs of the key (removed ones included)
+		};
+
+		/**
+		 * Build the index. The PIDs of key keys[i] are the ones of
+		 * pids[offsets[i]] to pids[offsets[i+1]-1], in this order.
+		 * @param keys The keys (all different)
+		 * @param offsets The positions of the PIDs of each key in \a pids (keys.size() + 1 values)
+		 * @param pids The PIDs of all keys
+		 * @return True if the index has been built, false if no perfect hash function has been found (the index is empty)
+		 */
+		bool build(std::vector< Key_t >&& keys, const std::vector< std::size_t >& offsets, const std::vector< PID_t >& pids)
+		{
+			assert(offsets.size() == keys.size() + 1);
+			clear();
+			std::size_t n = keys.size();
+			if (n == 0) return true;
+
+			// Spread the keys in buckets (counting sort)
+			std::vector< std::uint64_t > h(n);
+			for (std::size_t i = 0; i < n; ++i)
+				h[i] = mix(Hash_t()(keys[i]));
+			std::size_t nb_buckets = (n + BUCKET_SIZE - 1) / BUCKET_SIZE;
+			std::vector< std::size_t > bucket_first(nb_buckets + 1, 0);
+			for (std::size_t i = 0; i < n; ++i)
+				++bucket_first[bucket(h[i], nb_buckets) + 1];
+			std::partial_sum(bucket_first.begin(), bucket_first.end(), bucket_first.begin());
+			std::vector< std::size_t > bucket_keys(n);
+			{
+				std::vector< std::size_t > next(bucket_first.begin(), bucket_first.end() - 1);
+				for (std::size_t i = 0; i < n; ++i)
+					bucket_keys[next[bucket(h[i], nb_buckets)]++] = i;
+			}
+
+			// The keys whose hash value is the one of a previous key of their
+			// bucket go to the overflow list, the buckets are then sorted by
+			// decreasing size (counting sort)
+			std::vector< std::size_t > overflow_ids;
+			std::vector< std::size_t > bucket_last(nb_buckets);
+			std::vector< std::size_t > nb_by_size(1, 0);
+			for (std::size_t b = 0; b < nb_buckets; ++b)
+			{
+				std::size_t l = bucket_first[b];
+				for (std::size_t j = bucket_first[b]; j < bucket_first[b + 1]; ++j)
+				{
+					std::size_t i = bucket_keys[j];
+					if (std::find_if(bucket_keys.begin() + bucket_first[b], bucket_keys.begin() + l, [&](std::size_t o) { return h[o] == h[i]; }) != bucket_keys.begin() + l)
+						overflow_ids.push_back(i);
+					else
+						bucket_keys[l++] = i;
+				}
+				bucket_last[b] = l;
+				std::size_t size = l - bucket_first[b];
+				if (size >= nb_by_size.size()) nb_by_size.resize(size + 1, 0);
+				++nb_by_size[size];
+			}
+			std::sort(overflow_ids.begin(), overflow_ids.end(), [&](std::size_t i, std::size_t j) { return (h[i] < h[j]) || ((h[i] == h[j]) && (i < j)); });
+			std::vector< std::size_t > buckets(nb_buckets);
+			{
+				std::vector< std::size_t > next(nb_by_size.size(), 0);
+				for (std::size_t size = nb_by_size.size() - 1; size > 0; --size)
+					next[size - 1] = next[size] + nb_by_size[size];
+				for (std::size_t b = 0; b < nb_buckets; ++b)
+					buckets[next[bucket_last[b] - bucket_first[b]]++] = b;
+			}
+
+			// Place the buckets, from the largest one, in a table a bit larger than
+			// the number of keys (the last keys are placed much faster). The taken
+			// positions are kept in a bit vector, small enough to stay in cache.
+			std::size_t m = n - overflow_ids.size();
+			std::size_t table_size = m + m / EXTRA_POSITIONS + 1;
+			_disp.assign(nb_buckets, 0);
+			std::vector< bool > taken(table_size, false);
+			std::vector< std::size_t > key_of_position(table_size, n);
+			std::vector< std::size_t > pos;
+			for (auto b : buckets)
+			{
+				std::size_t b_first = bucket_first[b];
+				std::size_t b_last = bucket_last[b];
+				if (b_first == b_last) break;
+				for (std::uint32_t d = 0; ; ++d)
+				{
+					if (d == std::numeric_limits< std::uint32_t >::max())
+					{
+						clear();
+						return false;
+					}
+					pos.clear();
+					for (std::size_t j = b_first; j < b_last; ++j)
+					{
+						std::size_t p = position(h[bucket_keys[j]], d, table_size);
+						if (taken[p] || (std::find(pos.begin(), pos.end(), p) != pos.end()))
+							break;
+						pos.push_back(p);
+					}
+					if (pos.size() == (b_last - b_first))
+					{
+						for (std::size_t j = b_first; j < b_last; ++j)
+						{
+							taken[pos[j - b_first]] = true;
+							key_of_position[pos[j - b_first]] = bucket_keys[j];
+						}
+						_disp[b] = d;
+						break;
+					}
+				}
+			}
+
+			// Make the function minimal: the keys placed after the m first positions
+			// are moved to the free ones
+			std::vector< std::size_t > key_of_slot(key_of_position.begin(), key_of_position.begin() + m);
+			_remap.assign(table_size - m, 0);
+			std::size_t free_slot = 0;
+			for (std::size_t p = m; p < table_size; ++p)
+				if (taken[p])
+				{
+					while (taken[free_slot]) ++free_slot;
+					taken[free_slot] = true;
+					key_of_slot[free_slot] = key_of_position[p];
+					_remap[p - m] = static_cast< std::uint32_t >(free_slot);
+				}
+
+			// Store the keys and their PIDs, slot by slot
+			_slots.reserve(m);
+			_overflow.reserve(overflow_ids.size());
+			_overflow_hash.reserve(overflow_ids.size());
+			_pids.reserve(pids.size());
+			auto add_slot = [&](std::vector< Slot >& slots, std::size_t i) {
+				std::size_t count = offsets[i + 1] - offsets[i];
+				PID_t first = (count == 1) ? pids[offsets[i]] : static_cast< PID_t >(_pids.size());
+				if (count > 1)
+					_pids.insert(_pids.end(), pids.begin() + offsets[i], pids.begin() + offsets[i + 1]);
+				slots.push_back( Slot{ std::move(keys[i]), first, static_cast< PID_t >(count) } );
+			};
+			for (auto i : key_of_slot)
+				add_slot(_slots, i);
+			for (auto i : overflow_ids)
+			{
+				add_slot(_overflow, i);
+				_overflow_hash.push_back(h[i]);
+			}
+			_pids.shrink_to_fit();
+			return true;
+		}
+
+		/**
+		 * Empty the index and give back its memory.
+		 */
+		void clear()
+		{
+			_disp = std::vector< std::uint32_t >();
+			_remap = std::vector< std::uint32_t >();
+			_slots = std::vector< Slot >();
+			_overflow = std::vector< Slot >();
+			_overflow_hash = std::vector< std::uint64_t >();
+			_pids = std::vector< PID_t >();
+		}
+
+		/**
+		 * Return the slot of key \a k.
+		 * @param k The key to search for
+		 * @return A pointer to the slot of \a k, nullptr if \a k is not a key of the index
+		 */
+		const Slot* find(const Key_t& k) const
+		{
+			return const_cast< Frozen_index* >(this)->lookup(k);
+		}
+
+		/**
+		 * Return the PIDs of slot \a s, the removed ones are set to NO_PID.
+		 * @param s The slot
+		 * @return The pair of pointers on the first PID and past the last one
+		 */
+		std::pair< const PID_t*, const PID_t* > pids(const Slot& s) const
+		{
+			const PID_t* first = (s._count == 1) ? &s._first : (_pids.data() + s._first);
+			return { first, first + s._count };
+		}
+
+		/**
+		 * Return the number of PIDs of slot \a s which have not been removed.
+		 * @param s The slot
+		 * @return The number of PIDs
+		 */
+		std::size_t size(const Slot& s) const
+		{
+			auto r = pids(s);
+			return std::count_if(r.first, r.second, [](PID_t p) { return p != NO_PID; });
+		}
+
+		/**
+		 * Remove the PID \a pid of key \a k (it is set to NO_PID).
+		 * @param k The key of the constraint
+		 * @param pid The PID of the constraint
+		 */
+		void remove(const Key_t& k, PID_t pid)
+		{
+			Slot* s = lookup(k);
+			if (s == nullptr) return;
+			PID_t* first = (s->_count == 1) ? &s->_first : (_pids.data() + s->_first);
+			std::replace(first, first + s->_count, pid, NO_PID);
+		}
+
+		/**
+		 * Renumber the PIDs of the index with the table \a remap.
+		 * @param remap The table which maps the old PIDs to the new ones
+		 */
+		void remap(const std::vector< PID_t >& remap)
+		{
+			auto f = [&](PID_t& p) { if (p != NO_PID) p = remap[p]; };
+			for (auto& s : _slots)
+				if (s._count == 1) f(s._first);
+			for (auto& s : _overflow)
+				if (s._count == 1) f(s._first);
+			std::for_each(_pids.begin(), _pids.end(), f);
+		}
+
+		/**
+		 * Return the slots of the index, the overflow list excluded.
+		 * @return A const reference to the slots
+		 */
+		const std::vector< Slot >& slots() const { return _slots; }
+
+		/**
+		 * Return the overflow list of the index.
+		 * @return A const reference to the slots of the overflow list
+		 */
+		const std::vector< Slot >& overflow() const { return _overflow; }
+
+		/**
+		 * Return the memory used by the index.
+		 * @return The size in bytes
+		 */
+		std::size_t memory() const
+		{
+			return sizeof(std::uint32_t) * (_disp.capacity() + _remap.capacity()) + sizeof(Slot) * (_slots.capacity() + _overflow.capacity()) + sizeof(std::uint64_t) * _overflow_hash.capacity() + sizeof(PID_t) * _pids.capacity();
+		}
+
+	private:
+		static constexpr std::size_t BUCKET_SIZE = 2;		///< Average number of keys by bucket
+		static constexpr std::size_t EXTRA_POSITIONS = 100;	///< The table has one extra position for EXTRA_POSITIONS keys
+
+		std::vector< std::uint32_t > _disp;	///< Displacement of each bucket
+		std::vector< std::uint32_t > _remap;	///< Slot of the keys placed after the last slot of the table
+		std::vector< Slot > _slots;			///< Slots of the keys (one by key)
+		std::vector< Slot > _overflow;		///< Slots of the keys whose hash value is the one of another key, sorted by hash value
+		std::vector< std::uint64_t > _overflow_hash;	///< Mixed hash value of each slot of the overflow list
+		std::vector< PID_t > _pids;			///< PIDs of the keys which have more than one PID, ordered by slot
+
+		/**
+		 * Mix the bits of \a x (finalizer of splitmix64).
+		 * @param x The value to mix
+		 * @return The mixed value
+		 */
+		static std::uint64_t mix(std::uint64_t x)
+		{
+			x ^= x >> 30;
+			x *= 0xbf58476d1ce4e5b9ULL;
+			x ^= x >> 27;
+			x *= 0x94d049bb133111ebULL;
+			x ^= x >> 31;
+			return x;
+		}
+
+		/**
+		 * Return the bucket of a key. The buckets are skewed: 60% of the keys
+		 * go to the first 30% of the buckets (the large buckets are placed
+		 * first, when most of the positions are free).
+		 * @param h The mixed hash value of the key
+		 * @param nb_buckets The number of buckets
+		 * @return The bucket
+		 */
+		static std::size_t bucket(std::uint64_t h, std::size_t nb_buckets)
+		{
+			constexpr std::uint64_t DENSE_KEYS = (std::uint64_t(6) << 32) / 10;
+			std::uint64_t x = h >> 32;
+			std::uint64_t nb_dense = (nb_buckets * 3) / 10;
+			if (nb_dense == 0)
+				return static_cast< std::size_t >((x * nb_buckets) >> 32);
+			if (x < DENSE_KEYS)
+				return static_cast< std::size_t >((x * nb_dense) / DENSE_KEYS);
+			return static_cast< std::size_t >(nb_dense + ((x - DENSE_KEYS) * (nb_buckets - nb_dense)) / ((std::uint64_t(1) << 32) - DENSE_KEYS));
+		}
+
+		/**
+		 * Return the position of a key in the table for displacement \a d.
+		 * @param h The mixed hash value of the key
+		 * @param d The displacement of the bucket of the key
+		 * @param table_size The number of positions of the table
+		 * @return The position
+		 */
+		static std::size_t position(std::uint64_t h, std::uint32_t d, std::size_t table_size)
+		{
+			return static_cast< std::size_t >(((mix(h ^ (d * 0x9e3779b97f4a7c15ULL)) >> 32) * table_size) >> 32);
+		}
+
+		/**
+		 * Return the slot of key \a k.
+		 * @param k The key to search for
+		 * @return A pointer to the slot of \a k, nullptr if \a k is not a key of the index
+		 */
+		Slot* lookup(const Key_t& k)
+		{
+			if (_slots.empty()) return nullptr;
+			std::uint64_t h = mix(Hash_t()(k));
+			std::size_t p = position(h, _disp[bucket(h, _disp.size())], _slots.size() + _remap.size());
+			if (p >= _slots.size()) p = _remap[p - _slots.size()];
+			Slot& s = _slots[p];
+			if (s._key == k) return &s;
+			auto r = std::equal_range(_overflow_hash.begin(), _overflow_hash.end(), h);
+			for (auto it = r.first; it != r.second; ++it)
+			{
+				Slot& o = _overflow[it - _overflow_hash.begin()];
+				if (o._key == k) return &o;
+			}
+			return nullptr;
+		}
+	};
+}
+
+#endif /* RUNTIME_FROZEN_INDEX_HH_ */
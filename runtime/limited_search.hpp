@@ -0,0 +1,169 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_LIMITED_SEARCH_HH_
+#define RUNTIME_LIMITED_SEARCH_HH_
+
+#include <vector>
+
+#include <backtrack.hh>
+
+/**
+ * \defgroup Limited_search Limited discrepancy and beam search
+ *
+ * The disjunctions may be explored in an incomplete way with the limits
+ * of chr::Search_limit. The limits apply to all the disjunctions executed
+ * while they are set:
+ * - for a whole program, by calling chr::Search_limit::set() before
+ *   running the CHR program and chr::Search_limit::restore() after,
+ * - for a part of a rule body, by giving an Lds_policy or a Beam_policy to
+ *   a restart statement which wraps it: restart(lds, (body)). The body is then
+ *   run with increasing limits until it succeeds or until a run has explored
+ *   the whole search space (no alternative has been refused).
+ */
+
+namespace chr
+{
+	/**
+	 * @brief Iterative limited discrepancy search policy
+	 *
+	 * Policy of a restart statement which runs its body with a discrepancy
+	 * limit of 0, then 1, 2, ... up to the maximum number of discrepancies.
+	 * \ingroup Limited_search
+	 */
+	class Lds_policy
+	{
+	public:
+		/**
+		 * Initialize.
+		 * @param max_discrepancies The discrepancy limit of the last run
+		 * @param start The discrepancy limit of the first run
+		 */
+		explicit Lds_policy(unsigned long max_discrepancies = chr::Search_limit::UNLIMITED, unsigned long start = 0)
+			: _max(max_discrepancies), _limit(start < max_discrepancies ? start : max_discrepancies)
+		{ }
+
+		/**
+		 * Copy constructor (deleted).
+		 */
+		Lds_policy(const Lds_policy&) =delete;
+
+		/**
+		 * Return the discrepancy limit of the current (or next) run.
+		 * @return The discrepancy limit
+		 */
+		unsigned long discrepancies() const { return _limit; }
+
+		/**
+		 * Start a new run: set the discrepancy limit of the current thread.
+		 * Used by the restart statement.
+		 */
+		void start_run()
+		{
+			_previous.push_back( chr::Search_limit::set(_limit) );
+		}
+
+		/**
+		 * End the current run and restore the previous limits.
+		 * Used by the restart statement.
+		 * @param succeeded True if the run has succeeded
+		 * @return True if the statement is done, false if a new run must be started
+		 */
+		bool end_run(bool succeeded)
+		{
+			bool pruned = chr::Search_limit::pruned();
+			chr::Search_limit::restore( _previous.back() );
+			_previous.pop_back();
+			if (succeeded || !pruned || chr::Cancellation::requested() || (_limit >= _max)) return true;
+			++_limit;
+			return false;
+		}
+
+	private:
+		unsigned long _max;										///< Discrepancy limit of the last run
+		unsigned long _limit;									///< Discrepancy limit of the current run
+		std::vector< chr::Search_limit::Limits > _previous;		///< Limits saved by the current runs (nested ones included)
+	};
+
+	/**
+	 * @brief Beam search policy
+	 *
+	 * Policy of a restart statement which runs its body by trying only the
+	 * \e width first alternatives of each disjunction. If the run fails,
+	 * the width is increased by one up to the maximum width (iterative broadening).
+	 * \ingroup Limited_search
+	 */
+	class Beam_policy
+	{
+	public:
+		/**
+		 * Initialize.
+		 * @param width The width of the first run (at least 1)
+		 * @param max_width The width of the last run (\a width if lower)
+		 */
+		explicit Beam_policy(unsigned long width, unsigned long max_width = 0)
+			: _width(width > 0 ? width : 1), _max(max_width > _width ? max_width : _width)
+		{ }
+
+		/**
+		 * Copy constructor (deleted).
+		 */
+		Beam_policy(const Beam_policy&) =delete;
+
+		/**
+		 * Return the width of the current (or next) run.
+		 * @return The width
+		 */
+		unsigned long width() const { return _width; }
+
+		/**
+		 * Start a new run: set the width limit of the current thread.
+		 * Used by the restart statement.
+		 */
+		void start_run()
+		{
+			_previous.push_back( chr::Search_limit::set(chr::Search_limit::UNLIMITED, _width) );
+		}
+
+		/**
+		 * End the current run and restore the previous limits.
+		 * Used by the restart statement.
+		 * @param succeeded True if the run has succeeded
+		 * @return True if the statement is done, false if a new run must be started
+		 */
+		bool end_run(bool succeeded)
+		{
+			bool pruned = chr::Search_limit::pruned();
+			chr::Search_limit::restore( _previous.back() );
+			_previous.pop_back();
+			if (succeeded || !pruned || chr::Cancellation::requested() || (_width >= _max)) return true;
+			++_width;
+			return false;
+		}
+
+	private:
+		unsigned long _width;									///< Width of the current run
+		unsigned long _max;										///< Width of the last run
+		std::vector< chr::Search_limit::Limits > _previous;		///< Limits saved by the current runs (nested ones included)
+	};
+}
+
+#endif /* RUNTIME_LIMITED_SEARCH_HH_ */
@@ -0,0 +1,144 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_MAPPED_FILE_HH_
+#define RUNTIME_MAPPED_FILE_HH_
+
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if __has_include(<sys/mman.h>) && __has_include(<fcntl.h>) && __has_include(<unistd.h>)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define CHR_ENABLE_MMAP
+#endif
+
+namespace chr
+{
+	/**
+	 * @brief View of the content of a file
+	 *
+	 * The file is mapped in memory when the mmap API is available, it is
+	 * read in a buffer otherwise. The pages of the file are loaded on demand,
+	 * when they are first accessed. A private mapping may be written: the
+	 * written pages are copied (the file is never modified).
+	 */
+	class Mapped_file
+	{
+	public:
+		/**
+		 * Map the file \a path. An exception is thrown if it can't be opened.
+		 * @param path The path of the file
+		 * @param writable True for a private mapping which can be written (copy on write), false for a read-only one
+		 * @param sequential True if the file will be read sequentially (read ahead)
+		 */
+		explicit Mapped_file(const std::string& path, bool writable = false, bool sequential = true)
+		{
+#ifdef CHR_ENABLE_MMAP
+			int fd = ::open(path.c_str(), O_RDONLY);
+			if (fd < 0) throw std::runtime_error( "unable to open " + path );
+			struct stat st;
+			if (::fstat(fd, &st) != 0)
+			{
+				::close(fd);
+				throw std::runtime_error( "unable to read " + path );
+			}
+			_size = static_cast< std::size_t >(st.st_size);
+			if (_size > 0)
+			{
+				void* p = ::mmap(nullptr, _size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_PRIVATE, fd, 0);
+				if (p == MAP_FAILED)
+				{
+					::close(fd);
+					throw std::runtime_error( "unable to map " + path );
+				}
+				::madvise(p, _size, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+				_data = static_cast< char* >(p);
+			}
+			::close(fd);
+#else
+			(void) writable;
+			(void) sequential;
+			std::ifstream is(path, std::ios::binary | std::ios::ate);
+			if (!is) throw std::runtime_error( "unable to open " + path );
+			_size = static_cast< std::size_t >(is.tellg());
+			_buffer = std::make_unique< char[] >(_size);
+			is.seekg(0);
+			if (!is.read(_buffer.get(), _size)) throw std::runtime_error( "unable to read " + path );
+			_data = _buffer.get();
+#endif
+		}
+
+		/**
+		 * Copy constructor (deleted).
+		 */
+		Mapped_file(const Mapped_file&) =delete;
+
+		/**
+		 * Assignment operator (deleted).
+		 */
+		Mapped_file& operator=(const Mapped_file&) =delete;
+
+		/**
+		 * Unmap the file.
+		 */
+		~Mapped_file()
+		{
+#ifdef CHR_ENABLE_MMAP
+			if (_data != nullptr) ::munmap(_data, _size);
+#endif
+		}
+
+		/**
+		 * Return the content of the file.
+		 * @return The view of the content
+		 */
+		std::string_view view() const { return std::string_view(_data, _size); }
+
+		/**
+		 * Return the first byte of the content of the file. It may be written
+		 * only if the file has been mapped writable.
+		 * @return The pointer to the content (nullptr if the file is empty)
+		 */
+		char* data() const { return _data; }
+
+		/**
+		 * Return the size of the file.
+		 * @return The size in bytes
+		 */
+		std::size_t size() const { return _size; }
+
+	private:
+		char* _data = nullptr;					///< Content of the file
+		std::size_t _size = 0;					///< Size of the file
+#ifndef CHR_ENABLE_MMAP
+		std::unique_ptr< char[] > _buffer;		///< Buffer of the content of the file
+#endif
+	};
+}
+
+#endif /* RUNTIME_MAPPED_FILE_HH_ */
@@ -0,0 +1,322 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_MCTS_HH_
+#define RUNTIME_MCTS_HH_
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <statistics.hh>
+#include <backtrack.hh>
+
+namespace chr
+{
+	/**
+	 * @brief Monte Carlo tree search over CHR choice points
+	 *
+	 * Each playout starts from the root state: it goes down the tree of
+	 * the already visited states by choosing the moves with the UCT formula,
+	 * adds a new state to the tree, then plays random moves until a terminal
+	 * state is reached. The reward of the terminal state is propagated back
+	 * to the states of the tree path. Between two playouts, the CHR space
+	 * is restored with chr::Backtrack::back_to(), so a state of the tree is
+	 * never copied: it is a node of a compact table (decision, parent,
+	 * children, visits and wins) and it is materialized by applying the
+	 * decisions of its path from the root.
+	 *
+	 * In a two-player game (the default), the reward is the one of the player
+	 * who moves at the root and the players alternate at each move: the wins
+	 * of a node are counted for the player who has made its decision.
+	 *
+	 * It is the engine of the mcts CHR statement, which leaves the CHR store
+	 * in the state reached by the best move of the root (the most visited one).
+	 * The number of playouts and their throughput are reported in chr::Statistics.
+	 * @tparam Decision The type of a decision (default constructible and copyable)
+	 */
+	template < typename Decision >
+	class Mcts
+	{
+	public:
+		using Decision_t = Decision;	///< Type of a decision
+
+		/**
+		 * Initialize.
+		 * @param playouts The number of playouts of a search
+		 * @param exploration The exploration constant of the UCT formula
+		 * @param seed The seed of the random moves of the playouts
+		 * @param two_players True if the players alternate at each move, false for a single player
+		 */
+		explicit Mcts(unsigned long playouts = 1000, double exploration = 1.41421356237, std::uint_fast64_t seed = 0, bool two_players = true)
+			: _max_playouts(playouts), _exploration(exploration), _two_players(two_players), _rng(seed)
+		{ }
+
+		/**
+		 * Run a Monte Carlo tree search from the current state of the CHR program.
+		 * @param apply Function applying a decision to the current state (it returns ES_CHR::FAILURE if the decision is not valid)
+		 * @param moves Function returning the range of decisions of the current state
+		 * @param reward Function returning the reward of a terminal state (between 0 and 1) for the player of the root
+		 * @param terminal Function returning true if the current state is terminal
+		 * @return True if a move of the root has been chosen, false otherwise
+		 */
+		template < typename Apply, typename Moves, typename Reward, typename Terminal >
+		bool mcts(Apply apply, Moves moves, Reward reward, Terminal terminal)
+		{
+			auto start = std::chrono::steady_clock::now();
+			_nodes.clear();
+			_playouts = 0;
+			Depth_t root = chr::Backtrack::depth();
+			_nodes.push_back( Node{Decision{}, _npos, 0, 0, 0, 0.0f, false, false} );
+
+			while (_playouts < _max_playouts)
+			{
+				if (chr::Cancellation::requested()) break;
+				if (_playouts > 0)
+				{
+					chr::Backtrack::back_to(root);
+					chr::reset();
+				}
+				++_playouts;
+
+				// Selection and expansion
+				std::uint32_t k = 0;
+				unsigned int depth = 0;
+				while (true)
+				{
+					if (!_nodes[k].expanded)
+					{
+						if (terminal()) break;
+						expand(k, moves);
+					}
+					std::uint32_t c = select(k);
+					if (c == _npos) break;
+					Depth_t d = chr::Backtrack::depth();
+					if (!play(apply, _nodes[c].decision))
+					{
+						// Invalid move, it is never selected again
+						_nodes[c].dead = true;
+						chr::Backtrack::back_to(d);
+						chr::reset();
+						continue;
+					}
+					k = c;
+					++depth;
+					if (_nodes[k].visits == 0) break;
+				}
+
+				// Random playout
+				unsigned long length = 0;
+				while (((_max_length == 0) || (length < _max_length)) && !terminal())
+				{
+					_buffer.clear();
+					for (auto&& m : moves())
+						_buffer.push_back(m);
+					bool moved = false;
+					while (!moved && !_buffer.empty())
+					{
+						std::size_t i = std::uniform_int_distribution< std::size_t >(0, _buffer.size() - 1)(_rng);
+						Depth_t d = chr::Backtrack::depth();
+						moved = play(apply, _buffer[i]);
+						if (!moved)
+						{
+							chr::Backtrack::back_to(d);
+							chr::reset();
+							_buffer[i] = _buffer.back();
+							_buffer.pop_back();
+						}
+					}
+					if (!moved) break;
+					++length;
+				}
+
+				// Back-propagation
+				float r = static_cast< float >(reward());
+				for (std::uint32_t x = k; x != _npos; x = _nodes[x].parent, --depth)
+				{
+					++_nodes[x].visits;
+					_nodes[x].wins += (_two_players && ((depth % 2) == 0)) ? (1.0f - r) : r;
+				}
+			}
+
+			chr::Backtrack::back_to(root);
+			chr::reset();
+			chr::Statistics::inc_nb_playouts(_playouts, std::chrono::duration_cast< std::chrono::microseconds >(std::chrono::steady_clock::now() - start));
+
+			// Play the most visited move of the root
+			_best = _npos;
+			const Node& r = _nodes[0];
+			for (std::uint32_t c = r.first_child; c < r.first_child + r.nb_children; ++c)
+				if (!_nodes[c].dead && (_nodes[c].visits > 0)
+						&& ((_best == _npos) || (_nodes[c].visits > _nodes[_best].visits)
+							|| ((_nodes[c].visits == _nodes[_best].visits) && (_nodes[c].wins > _nodes[_best].wins))))
+					_best = c;
+			if (_best == _npos) return false;
+			if (!play(apply, _nodes[_best].decision))
+			{
+				chr::Backtrack::back_to(root);
+				chr::reset();
+				_best = _npos;
+				return false;
+			}
+			return true;
+		}
+
+		/**
+		 * Return the move of the root chosen by the last search.
+		 * @return The best decision (default value if no move has been chosen)
+		 */
+		Decision best_decision() const { return (_best == _npos) ? Decision{} : _nodes[_best].decision; }
+
+		/**
+		 * Return the mean reward of the move chosen by the last search
+		 * for the player of the root.
+		 * @return The win ratio of the best decision
+		 */
+		double best_value() const
+		{
+			if ((_best == _npos) || (_nodes[_best].visits == 0)) return 0.0;
+			return static_cast< double >(_nodes[_best].wins) / _nodes[_best].visits;
+		}
+
+		/**
+		 * Return the number of visits of the move chosen by the last search.
+		 * @return The number of visits of the best decision
+		 */
+		unsigned long best_visits() const { return (_best == _npos) ? 0 : _nodes[_best].visits; }
+
+		/**
+		 * Return the number of playouts of the last search.
+		 * @return The number of playouts
+		 */
+		unsigned long playouts() const { return _playouts; }
+
+		/**
+		 * Return the number of states kept in the tree by the last search.
+		 * @return The size of the node table
+		 */
+		std::size_t nodes() const { return _nodes.size(); }
+
+		/**
+		 * Set the number of playouts of the next searches.
+		 * @param playouts The number of playouts
+		 */
+		void set_playouts(unsigned long playouts) { _max_playouts = playouts; }
+
+		/**
+		 * Set the maximum number of random moves of a playout.
+		 * @param length The maximum length of a playout (0 for no limit)
+		 */
+		void set_max_playout_length(unsigned long length) { _max_length = length; }
+
+	private:
+		static constexpr std::uint32_t _npos = std::numeric_limits< std::uint32_t >::max();	///< Parent of the root node
+
+		/**
+		 * @brief Node of the search tree
+		 *
+		 * The children of a node are contiguous in the node table.
+		 */
+		struct Node
+		{
+			Decision decision;			///< Decision which leads from the parent to this node
+			std::uint32_t parent;		///< Index of the parent node
+			std::uint32_t first_child;	///< Index of the first child
+			std::uint32_t nb_children;	///< Number of children
+			std::uint32_t visits;		///< Number of playouts through this node
+			float wins;					///< Sum of the rewards of the player who has made the decision
+			bool expanded;				///< True if the children have been added
+			bool dead;					///< True if the decision is not valid
+		};
+
+		/**
+		 * Apply the decision \a d on top of the current state.
+		 * @param apply Function applying a decision to the current state
+		 * @param d The decision
+		 * @return True if the decision has been applied, false otherwise
+		 */
+		template < typename Apply >
+		bool play(Apply& apply, const Decision& d)
+		{
+			chr::reset();
+			chr::Backtrack::inc_backtrack_depth();
+			return (apply(d) == chr::ES_CHR::SUCCESS) && !chr::failed();
+		}
+
+		/**
+		 * Add the children of node \a k (the current state).
+		 * @param k The node to expand
+		 * @param moves Function returning the range of decisions of the current state
+		 */
+		template < typename Moves >
+		void expand(std::uint32_t k, Moves& moves)
+		{
+			std::uint32_t first = static_cast< std::uint32_t >(_nodes.size());
+			for (auto&& m : moves())
+				_nodes.push_back( Node{m, k, 0, 0, 0, 0.0f, false, false} );
+			_nodes[k].first_child = first;
+			_nodes[k].nb_children = static_cast< std::uint32_t >(_nodes.size()) - first;
+			_nodes[k].expanded = true;
+		}
+
+		/**
+		 * Select the child of node \a k with the UCT formula. The unvisited
+		 * children are selected first.
+		 * @param k The node
+		 * @return The index of the child, _npos if \a k has no valid child
+		 */
+		std::uint32_t select(std::uint32_t k) const
+		{
+			const Node& n = _nodes[k];
+			double log_visits = std::log(static_cast< double >(n.visits > 0 ? n.visits : 1));
+			std::uint32_t best = _npos;
+			double best_score = 0.0;
+			for (std::uint32_t c = n.first_child; c < n.first_child + n.nb_children; ++c)
+			{
+				const Node& child = _nodes[c];
+				if (child.dead) continue;
+				if (child.visits == 0) return c;
+				double score = static_cast< double >(child.wins) / child.visits + _exploration * std::sqrt(log_visits / child.visits);
+				if ((best == _npos) || (score > best_score))
+				{
+					best = c;
+					best_score = score;
+				}
+			}
+			return best;
+		}
+
+		unsigned long _max_playouts;				///< Number of playouts of a search
+		unsigned long _max_length = 0;				///< Maximum number of random moves of a playout (0 for no limit)
+		double _exploration;						///< Exploration constant of the UCT formula
+		bool _two_players;							///< True if the players alternate at each move
+		std::mt19937_64 _rng;						///< Random generator of the playouts
+		unsigned long _playouts = 0;				///< Number of playouts of the last search
+		std::uint32_t _best = _npos;				///< Move of the root chosen by the last search
+		std::vector< Node > _nodes;					///< Node table (the root is the first node)
+		std::vector< Decision > _buffer;			///< Moves of the current state of a random playout
+	};
+}
+
+#endif /* RUNTIME_MCTS_HH_ */
@@ -0,0 +1,358 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_MINIMAX_HH_
+#define RUNTIME_MINIMAX_HH_
+
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <statistics.hh>
+#include <backtrack.hh>
+
+namespace chr
+{
+	/**
+	 * @brief Kind of node of a game tree
+	 */
+	enum class Minimax_kind {
+		MAX,	//!< The node keeps the maximum value of its children
+		MIN,	//!< The node keeps the minimum value of its children
+		NEGA,	//!< The node keeps the maximum of the opposite values of its children (negamax)
+		CHANCE	//!< The node keeps the mean value of its children, weighted by their probabilities (expectation)
+	};
+
+	/**
+	 * @brief Node of a minimax / alpha-beta / negamax search
+	 *
+	 * The node stores the current best value and the (alpha, beta) window
+	 * as plain values. It is not a backtrackable object: the values are
+	 * updated after each child and must survive the backtrack to the node.
+	 * It is the bookkeeping used by the alphabeta_max, alphabeta_min, negamax and
+	 * expectation CHR statements and by the minimax(), alphabeta(), negamax() and
+	 * expectiminimax() functions.
+	 * For a NEGA node, T must be signed and the window symmetric (do not use the
+	 * lowest value of T as alpha).
+	 * A CHANCE node is never cut off. Its children must be given the full window
+	 * (child_alpha() and child_beta()) as their exact values are needed to compute
+	 * the mean. The mean is converted to T (truncated for an integral type).
+	 */
+	template < typename T >
+	class Minimax_node
+	{
+	public:
+		/**
+		 * Initialize.
+		 * @param kind The kind of node
+		 * @param alpha The lower bound of the window
+		 * @param beta The upper bound of the window
+		 */
+		Minimax_node(Minimax_kind kind, T alpha, T beta)
+			: _kind(kind), _alpha(alpha), _beta(beta),
+			_value( (kind == Minimax_kind::MIN)?std::numeric_limits< T >::max():((kind == Minimax_kind::MAX)?std::numeric_limits< T >::lowest():((kind == Minimax_kind::NEGA)?-std::numeric_limits< T >::max():T())) )
+		{ }
+
+		/**
+		 * Return the current best value of the node.
+		 * @return The best value
+		 */
+		T value() const { return _value; }
+
+		/**
+		 * Return the lower bound of the window of the node.
+		 * @return The alpha value
+		 */
+		T alpha() const { return _alpha; }
+
+		/**
+		 * Return the upper bound of the window of the node.
+		 * @return The beta value
+		 */
+		T beta() const { return _beta; }
+
+		/**
+		 * Return the lower bound of the window to give to the next child.
+		 * @return alpha for MAX or MIN node, -beta for NEGA node, the lowest value for CHANCE node
+		 */
+		T child_alpha() const
+		{
+			if (_kind == Minimax_kind::CHANCE)
+			{
+				// Symmetric window for the NEGA nodes below
+				if constexpr (std::is_signed_v< T >)
+					return -std::numeric_limits< T >::max();
+				else
+					return std::numeric_limits< T >::lowest();
+			}
+			return (_kind == Minimax_kind::NEGA)?-_beta:_alpha;
+		}
+
+		/**
+		 * Return the upper bound of the window to give to the next child.
+		 * @return beta for MAX or MIN node, -alpha for NEGA node, the greatest value for CHANCE node
+		 */
+		T child_beta() const
+		{
+			if (_kind == Minimax_kind::CHANCE)
+				return std::numeric_limits< T >::max();
+			return (_kind == Minimax_kind::NEGA)?-_alpha:_beta;
+		}
+
+		/**
+		 * Check if the remaining children can be pruned.
+		 * @return True if alpha >= beta (and the node is not a CHANCE node), false otherwise
+		 */
+		bool cutoff() const { return (_kind != Minimax_kind::CHANCE) && !(_alpha < _beta); }
+
+		/**
+		 * Update the best value and the window with the value of a child.
+		 * @param v The value of the child
+		 * @param p The probability (or any positive weight) of the child, only used by a CHANCE node
+		 */
+		void update(T v, double p = 1.0)
+		{
+			switch (_kind)
+			{
+				case Minimax_kind::NEGA:
+					v = -v;
+					[[fallthrough]];
+				case Minimax_kind::MAX:
+					if (_value < v) _value = v;
+					if (_alpha < _value) _alpha = _value;
+					break;
+				case Minimax_kind::MIN:
+					if (v < _value) _value = v;
+					if (_value < _beta) _beta = _value;
+					break;
+				case Minimax_kind::CHANCE:
+					_sum += p * static_cast< double >(v);
+					_weight += p;
+					_value = static_cast< T >(_sum / _weight);
+					break;
+			}
+		}
+
+	private:
+		Minimax_kind _kind;	///< Kind of node
+		T _alpha;			///< Lower bound of the window
+		T _beta;			///< Upper bound of the window
+		T _value;			///< Best value found so far
+		double _sum = 0.0;		///< Weighted sum of the values of the children (CHANCE node)
+		double _weight = 0.0;	///< Sum of the weights of the children (CHANCE node)
+	};
+
+	/**
+	 * Build a MAX node with the window (\a alpha, \a beta).
+	 * @param alpha The lower bound of the window
+	 * @param beta The upper bound of the window
+	 * @return The new node
+	 */
+	template < typename T1, typename T2 >
+	Minimax_node< std::common_type_t<T1,T2> > alphabeta_max_node(T1 alpha, T2 beta)
+	{
+		return Minimax_node< std::common_type_t<T1,T2> >(Minimax_kind::MAX, alpha, beta);
+	}
+
+	/**
+	 * Build a MIN node with the window (\a alpha, \a beta).
+	 * @param alpha The lower bound of the window
+	 * @param beta The upper bound of the window
+	 * @return The new node
+	 */
+	template < typename T1, typename T2 >
+	Minimax_node< std::common_type_t<T1,T2> > alphabeta_min_node(T1 alpha, T2 beta)
+	{
+		return Minimax_node< std::common_type_t<T1,T2> >(Minimax_kind::MIN, alpha, beta);
+	}
+
+	/**
+	 * Build a NEGA node with the window (\a alpha, \a beta).
+	 * @param alpha The lower bound of the window
+	 * @param beta The upper bound of the window
+	 * @return The new node
+	 */
+	template < typename T1, typename T2 >
+	Minimax_node< std::common_type_t<T1,T2> > negamax_node(T1 alpha, T2 beta)
+	{
+		return Minimax_node< std::common_type_t<T1,T2> >(Minimax_kind::NEGA, alpha, beta);
+	}
+
+	/**
+	 * Build a CHANCE node. The window (\a alpha, \a beta) is kept for the
+	 * uniformity of the statements, it is not used to prune the children.
+	 * @param alpha The lower bound of the window
+	 * @param beta The upper bound of the window
+	 * @return The new node
+	 */
+	template < typename T1, typename T2 >
+	Minimax_node< std::common_type_t<T1,T2> > expectation_node(T1 alpha, T2 beta)
+	{
+		return Minimax_node< std::common_type_t<T1,T2> >(Minimax_kind::CHANCE, alpha, beta);
+	}
+
+	namespace internal
+	{
+		/**
+		 * Explore the game tree rooted at the current state of the CHR program.
+		 * Each move is played at a new backtrack depth and undone with a back_to
+		 * call, the values stay on the C++ call stack.
+		 * @param kind The kind of the current node (MAX, MIN or NEGA) if it is not a chance node
+		 * @param prune True to prune the moves out of the window (alpha-beta), false to explore them all (minimax)
+		 * @param depth The remaining depth to explore
+		 * @param alpha The lower bound of the window
+		 * @param beta The upper bound of the window
+		 * @param moves Function returning the range of moves of the current state
+		 * @param play Function playing a move (the move is not valid if it returns ES_CHR::FAILURE or raises a failure)
+		 * @param eval Function evaluating the current state
+		 * @param chance Function returning true if the current state is a chance node (its moves are equally likely)
+		 * @return The value of the current node, the value of the current state if no move was valid, no value if the search has been cancelled
+		 */
+		template < typename T, typename Moves, typename Play, typename Eval, typename Chance >
+		std::optional< T > minimax_search(Minimax_kind kind, bool prune, unsigned int depth, T alpha, T beta, Moves& moves, Play& play, Eval& eval, Chance& chance)
+		{
+			if (depth == 0) return eval();
+			auto ms = moves();
+			if (std::begin(ms) == std::end(ms)) return eval();
+
+			// The player to move does not change through a chance node
+			bool chance_node = chance();
+			Minimax_node< T > node(chance_node?Minimax_kind::CHANCE:kind, alpha, beta);
+			Minimax_kind child_kind = (chance_node || (kind == Minimax_kind::NEGA))?kind:((kind == Minimax_kind::MAX)?Minimax_kind::MIN:Minimax_kind::MAX);
+			Depth_t d = chr::Backtrack::depth();
+			bool evaluated = false;
+			bool cancelled = false;
+			chr::Statistics::open_choice();
+			for (auto&& m : ms)
+			{
+				if (prune && node.cutoff()) break;
+				if (chr::Cancellation::requested())
+				{
+					cancelled = true;
+					break;
+				}
+				chr::reset();
+				chr::Backtrack::inc_backtrack_depth();
+				// A move may return SUCCESS while a failure has been raised during its propagation
+				if ((play(m) == chr::ES_CHR::SUCCESS) && !chr::failed())
+				{
+					auto v = prune?minimax_search(child_kind, true, depth - 1, node.child_alpha(), node.child_beta(), moves, play, eval, chance)
+							:minimax_search(child_kind, false, depth - 1, alpha, beta, moves, play, eval, chance);
+					if (v)
+					{
+						node.update(*v);
+						evaluated = true;
+					} else
+						cancelled = true;
+				}
+				chr::Backtrack::back_to(d);
+				if (cancelled) break;
+			}
+			chr::Statistics::close_choice();
+			chr::reset();
+			// The failures of the moves must not explain a later failure (see chr::Backjump)
+			chr::Backjump::unexplained();
+			// The remaining moves have not been explored: the best value so far is not the value of the node
+			if (cancelled) return std::nullopt;
+			// No valid move: the node is a leaf
+			if (!evaluated) return eval();
+			return node.value();
+		}
+	}
+
+	/**
+	 * Compute the minimax value of the current state of a CHR program.
+	 * The whole tree is explored up to \a depth.
+	 * @param depth The depth of the search
+	 * @param maximize True if the player to move maximizes, false otherwise
+	 * @param moves Function returning the range of moves of the current state
+	 * @param play Function playing a move (the move is not valid if it returns ES_CHR::FAILURE or raises a failure)
+	 * @param eval Function evaluating the current state from the point of view of the maximizer
+	 * @return The minimax value, no value if the search has been cancelled (see chr::Cancellation)
+	 */
+	template < typename T, typename Moves, typename Play, typename Eval >
+	std::optional< T > minimax(unsigned int depth, bool maximize, Moves moves, Play play, Eval eval)
+	{
+		auto no_chance = []() { return false; };
+		return internal::minimax_search< T >(maximize?Minimax_kind::MAX:Minimax_kind::MIN, false, depth,
+				std::numeric_limits< T >::lowest(), std::numeric_limits< T >::max(), moves, play, eval, no_chance);
+	}
+
+	/**
+	 * Compute the minimax value of the current state of a CHR program with alpha-beta pruning.
+	 * @param depth The depth of the search
+	 * @param alpha The lower bound of the window
+	 * @param beta The upper bound of the window
+	 * @param maximize True if the player to move maximizes, false otherwise
+	 * @param moves Function returning the range of moves of the current state
+	 * @param play Function playing a move (the move is not valid if it returns ES_CHR::FAILURE or raises a failure)
+	 * @param eval Function evaluating the current state from the point of view of the maximizer
+	 * @return The minimax value (fail-soft), no value if the search has been cancelled (see chr::Cancellation)
+	 */
+	template < typename T, typename Moves, typename Play, typename Eval >
+	std::optional< T > alphabeta(unsigned int depth, T alpha, T beta, bool maximize, Moves moves, Play play, Eval eval)
+	{
+		auto no_chance = []() { return false; };
+		return internal::minimax_search< T >(maximize?Minimax_kind::MAX:Minimax_kind::MIN, true, depth, alpha, beta, moves, play, eval, no_chance);
+	}
+
+	/**
+	 * Compute the negamax value of the current state of a CHR program with alpha-beta pruning.
+	 * @param depth The depth of the search
+	 * @param alpha The lower bound of the window
+	 * @param beta The upper bound of the window
+	 * @param moves Function returning the range of moves of the current state
+	 * @param play Function playing a move (the move is not valid if it returns ES_CHR::FAILURE or raises a failure)
+	 * @param eval Function evaluating the current state from the point of view of the player to move
+	 * @return The negamax value (fail-soft), no value if the search has been cancelled (see chr::Cancellation)
+	 */
+	template < typename T, typename Moves, typename Play, typename Eval >
+	std::optional< T > negamax(unsigned int depth, T alpha, T beta, Moves moves, Play play, Eval eval)
+	{
+		auto no_chance = []() { return false; };
+		return internal::minimax_search< T >(Minimax_kind::NEGA, true, depth, alpha, beta, moves, play, eval, no_chance);
+	}
+	/**
+	 * Compute the expectiminimax value of the current state of a CHR program.
+	 * The players alternate as in minimax(), a chance node (for example a dice roll)
+	 * may be inserted between two moves: its moves are the outcomes, they are
+	 * equally likely (repeat an outcome in the range of moves to give it more weight).
+	 * The MAX and MIN nodes are pruned by alpha-beta, the window is reset at each
+	 * chance node.
+	 * @param depth The depth of the search (a chance node counts as a ply)
+	 * @param maximize True if the player to move maximizes, false otherwise
+	 * @param moves Function returning the range of moves (or outcomes) of the current state
+	 * @param play Function playing a move (the move is not valid if it returns ES_CHR::FAILURE or raises a failure)
+	 * @param eval Function evaluating the current state from the point of view of the maximizer
+	 * @param chance Function returning true if the current state is a chance node
+	 * @return The expectiminimax value, no value if the search has been cancelled (see chr::Cancellation)
+	 */
+	template < typename T, typename Moves, typename Play, typename Eval, typename Chance >
+	std::optional< T > expectiminimax(unsigned int depth, bool maximize, Moves moves, Play play, Eval eval, Chance chance)
+	{
+		return internal::minimax_search< T >(maximize?Minimax_kind::MAX:Minimax_kind::MIN, true, depth,
+				std::numeric_limits< T >::lowest(), std::numeric_limits< T >::max(), moves, play, eval, chance);
+	}
+}
+
+#endif /* RUNTIME_MINIMAX_HH_ */
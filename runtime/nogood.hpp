@@ -0,0 +1,224 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_NOGOOD_HH_
+#define RUNTIME_NOGOOD_HH_
+
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <utility>
+
+#include <third_party/robin_set.h>
+#include <statistics.hh>
+#include <backtrack.hh>
+#include <utils.hpp>
+
+/**
+ * \defgroup Nogood Nogood learning
+ *
+ * The nogood(store, key, (body)) statement records the key of a body which
+ * failed. The next time a body is started with the same key, it fails at
+ * once without being explored. The key must capture everything the outcome of
+ * the body depends on: a tuple of ground constraint arguments, a sorted vector
+ * of the decisions taken on the path, etc.
+ * A body interrupted by a cancellation or pruned by a search limit (see
+ * chr::Search_limit) is not recorded: it may succeed when it is fully explored.
+ */
+
+namespace chr
+{
+	/**
+	 * @brief Bounded store of nogoods
+	 *
+	 * Keep the keys of the failed subtrees. The store is bounded: when it is
+	 * full, the least recently used key (added or hit) is evicted. Each key is
+	 * stored once, in the LRU list, the index only holds positions in the list.
+	 * The keys are hashed with a local XXHash state (see chr::XXHash_local_state).
+	 * The Key type must have a chr::XXHash specialization and an equality operator.
+	 * Each hit is reported in chr::Statistics.
+	 * @tparam Key The type of a nogood key
+	 * \ingroup Nogood
+	 */
+	template < typename Key >
+	class Nogood_store
+	{
+	public:
+		using Key_t = Key;	///< Type of a nogood key
+
+		using Position_t = typename std::list< Key >::iterator;	///< Type of the position of a key in the LRU list
+
+		/*
+		 * Computes hash for Key, or for the Key at a position of the LRU list
+		 */
+		struct Hash
+		{
+			using is_transparent = void;
+
+			chr::CHR_XXHASH_hash_t operator()(const Key& k) const
+			{
+				chr::XXHash_local_state state;
+				chr::XXHash< Key >::update(k);
+				return state.digest();
+			}
+
+			chr::CHR_XXHASH_hash_t operator()(const Position_t& p) const
+			{
+				return (*this)(*p);
+			}
+		};
+
+		/*
+		 * Compares Keys, or Keys at positions of the LRU list
+		 */
+		struct Equal
+		{
+			using is_transparent = void;
+
+			bool operator()(const Position_t& p1, const Position_t& p2) const { return *p1 == *p2; }
+			bool operator()(const Position_t& p, const Key& k) const { return *p == k; }
+			bool operator()(const Key& k, const Position_t& p) const { return k == *p; }
+		};
+
+		/**
+		 * Initialize.
+		 * @param capacity The maximum number of nogoods kept (at least 1)
+		 */
+		explicit Nogood_store(std::size_t capacity = 1 << 16) : _capacity(capacity > 0 ? capacity : 1) { }
+
+		/**
+		 * Copy constructor (deleted).
+		 */
+		Nogood_store(const Nogood_store&) =delete;
+
+		/**
+		 * Check if \a k is a nogood. A hit makes \a k the most recently used key.
+		 * @param k The key to check
+		 * @return True if \a k is a nogood, false otherwise
+		 */
+		bool contains(const Key& k)
+		{
+			auto it = _index.find(k);
+			if (it == _index.end()) return false;
+			_lru.splice(_lru.begin(), _lru, *it);
+			++_hits;
+			chr::Statistics::inc_nb_nogood_hits();
+			return true;
+		}
+
+		/**
+		 * Record the key \a k of a failed subtree. The least recently used
+		 * nogood is evicted if the store is full.
+		 * @param k The key to record
+		 */
+		void add(const Key& k)
+		{
+			auto it = _index.find(k);
+			if (it != _index.end())
+			{
+				_lru.splice(_lru.begin(), _lru, *it);
+				return;
+			}
+			if (_lru.size() >= _capacity)
+			{
+				_index.erase(std::prev(_lru.end()));
+				_lru.pop_back();
+				++_evictions;
+			}
+			_lru.push_front(k);
+			_index.insert(_lru.begin());
+		}
+
+		/**
+		 * Remove all nogoods.
+		 */
+		void clear()
+		{
+			_index.clear();
+			_lru.clear();
+		}
+
+		/**
+		 * Return the number of nogoods kept.
+		 * @return The size of the store
+		 */
+		std::size_t size() const { return _lru.size(); }
+
+		/**
+		 * Return the maximum number of nogoods kept.
+		 * @return The capacity of the store
+		 */
+		std::size_t capacity() const { return _capacity; }
+
+		/**
+		 * Return the number of subtrees cut by this store.
+		 * @return The number of hits
+		 */
+		unsigned long hits() const { return _hits; }
+
+		/**
+		 * Return the number of nogoods evicted because the store was full.
+		 * @return The number of evictions
+		 */
+		unsigned long evictions() const { return _evictions; }
+
+	private:
+		std::size_t _capacity;								///< Maximum number of nogoods
+		unsigned long _hits = 0;							///< Number of hits
+		unsigned long _evictions = 0;						///< Number of evicted nogoods
+		std::list< Key > _lru;								///< Nogoods, most recently used first
+		tsl::robin_set< Position_t, Hash, Equal > _index;	///< Position of each nogood in _lru
+	};
+
+	/**
+	 * Check the key \a k of a subtree before exploring it.
+	 * Used by the nogood statement.
+	 * @param store The nogood store
+	 * @param k The key of the subtree
+	 * @return ES_CHR::FAILURE if \a k is a nogood, ES_CHR::SUCCESS otherwise
+	 * \ingroup Nogood
+	 */
+	template < typename S, typename K >
+	chr::ES_CHR nogood_check(S& store, const K& k)
+	{
+		return store.contains(k) ? chr::failure() : chr::success();
+	}
+
+	/**
+	 * Record the key \a k of a subtree which has failed and raise the failure again.
+	 * The key is not recorded if an alternative of the subtree has been refused
+	 * by the search limits. Used by the nogood statement.
+	 * @param store The nogood store
+	 * @param k The key of the subtree
+	 * @param refusals The number of refused alternatives when the subtree was entered (see chr::Search_limit::refusals())
+	 * @return ES_CHR::FAILURE
+	 * \ingroup Nogood
+	 */
+	template < typename S, typename K >
+	chr::ES_CHR nogood_record(S& store, const K& k, unsigned long refusals)
+	{
+		if (!chr::Cancellation::requested() && (chr::Search_limit::refusals() == refusals))
+			store.add(k);
+		return chr::failure();
+	}
+}
+
+#endif /* RUNTIME_NOGOOD_HH_ */
@@ -0,0 +1,276 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_ORDERING_HH_
+#define RUNTIME_ORDERING_HH_
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <backtrack.hh>
+
+/**
+ * \defgroup Ordering Ordering of alternatives
+ *
+ * The exists, forall, exists_it, forall_it, alphabeta_max, alphabeta_min,
+ * negamax and expectation statements accept an optional order_by(f) clause, just before their
+ * body. The alternatives are then visited by decreasing score given by \e f. The scoring function \e f is either a callable f(v) or
+ * f(v, ply), where ply is the backtrack depth of the statement. If \e f
+ * has a member function reward(v, ply), it is called with the alternative which
+ * ended the loop (the first success of an exists, the first failure of a forall,
+ * the child which produced a cutoff).
+ * It is how the History_heuristic and Killer_moves tables learn.
+ */
+
+namespace chr
+{
+	/**
+	 * Compute the score of the value \a v with the scoring function \a f.
+	 * @param f The scoring function
+	 * @param v The value to score
+	 * @param ply The backtrack depth of the statement
+	 * @return The score of \a v
+	 * \ingroup Ordering
+	 */
+	template < typename F, typename T >
+	auto order_score(F& f, const T& v, Depth_t ply)
+	{
+		if constexpr (std::is_invocable_v< F&, const T&, Depth_t >)
+			return f(v, ply);
+		else
+			return f(v);
+	}
+
+	/**
+	 * Notify the scoring function \a f that the value \a v ended the loop.
+	 * It does nothing if \a f has no reward(v, ply) member function.
+	 * @param f The scoring function
+	 * @param v The value which ended the loop
+	 * @param ply The backtrack depth of the statement
+	 * \ingroup Ordering
+	 */
+	template < typename F, typename T >
+	void order_reward(F&& f, const T& v, Depth_t ply)
+	{
+		if constexpr (requires { f.reward(v, ply); })
+			f.reward(v, ply);
+	}
+
+	/**
+	 * Notify the scoring function \a f that the value \a v ended the loop
+	 * if \a cond is true (for example, when \a v produced a cutoff).
+	 * @param cond The condition to check
+	 * @param f The scoring function
+	 * @param v The value which ended the loop
+	 * @param ply The backtrack depth of the statement
+	 * \ingroup Ordering
+	 */
+	template < typename F, typename T >
+	void order_reward_if(bool cond, F&& f, const T& v, Depth_t ply)
+	{
+		if (cond) order_reward(f, v, ply);
+	}
+
+	/**
+	 * Sort the \a values by decreasing score. The order of values with
+	 * equal scores is kept.
+	 * @param values The values to sort
+	 * @param f The scoring function
+	 * @param ply The backtrack depth of the statement
+	 * \ingroup Ordering
+	 */
+	template < typename T, typename F >
+	void order_sort(std::vector< T >& values, F& f, Depth_t ply)
+	{
+		using Score_t = decltype(order_score(f, values.front(), ply));
+		std::vector< std::pair< Score_t, std::size_t > > scores;
+		scores.reserve(values.size());
+		for (std::size_t i = 0; i < values.size(); ++i)
+			scores.emplace_back(order_score(f, values[i], ply), i);
+		std::stable_sort(scores.begin(), scores.end(), [](const auto& a, const auto& b) { return b.first < a.first; });
+		std::vector< T > sorted;
+		sorted.reserve(values.size());
+		for (auto& s : scores)
+			sorted.push_back( std::move(values[s.second]) );
+		values.swap(sorted);
+	}
+
+	/**
+	 * Return the values of [\a lb, \a ub].
+	 * @param lb The lower bound
+	 * @param ub The upper bound
+	 * @return The vector of values
+	 * \ingroup Ordering
+	 */
+	template < typename T1, typename T2 >
+	auto range_values(const T1& lb, const T2& ub)
+	{
+		// The bounds may be logical variables, so the type of values is the one of lb + ub
+		using T = std::decay_t< decltype(lb + ub) >;
+		std::vector< T > values;
+		for (T v = lb; !(ub < v); ++v)
+		{
+			values.push_back(v);
+			if (!(v < ub)) break;
+		}
+		return values;
+	}
+
+	/**
+	 * Return the values of [\a lb, \a ub] sorted by decreasing score.
+	 * @param lb The lower bound
+	 * @param ub The upper bound
+	 * @param f The scoring function
+	 * @param ply The backtrack depth of the statement
+	 * @return The vector of sorted values
+	 * \ingroup Ordering
+	 */
+	template < typename T1, typename T2, typename F >
+	auto order_values(const T1& lb, const T2& ub, F&& f, Depth_t ply)
+	{
+		auto values = range_values(lb, ub);
+		order_sort(values, f, ply);
+		return values;
+	}
+
+	/**
+	 * Return the elements of container \a c sorted by decreasing score.
+	 * @param c The container
+	 * @param f The scoring function
+	 * @param ply The backtrack depth of the statement
+	 * @return The vector of sorted elements
+	 * \ingroup Ordering
+	 */
+	template < typename C, typename F >
+	auto order_container(const C& c, F&& f, Depth_t ply)
+	{
+		std::vector< std::decay_t< decltype(*std::begin(c)) > > values(std::begin(c), std::end(c));
+		order_sort(values, f, ply);
+		return values;
+	}
+
+	/**
+	 * @brief History heuristic
+	 *
+	 * Scoring table which gives to each value the number of times it ended
+	 * a loop, weighted by the depth of the loop (deeper loops weight less).
+	 * It is not backtracked: the knowledge is kept for the whole search.
+	 * \ingroup Ordering
+	 */
+	template < typename T >
+	class History_heuristic
+	{
+	public:
+		/**
+		 * Return the score of value \a v.
+		 * @param v The value
+		 * @return The score of \a v
+		 */
+		unsigned long operator()(const T& v) const
+		{
+			auto it = _scores.find(v);
+			return (it == _scores.end())?0:it->second;
+		}
+
+		/**
+		 * Reward the value \a v.
+		 * @param v The value which ended a loop
+		 * @param ply The backtrack depth of the loop
+		 */
+		void reward(const T& v, Depth_t ply)
+		{
+			_scores[v] += 1 + (_max_weight_depth > ply?(_max_weight_depth - ply):0);
+		}
+
+		/**
+		 * Clear the table.
+		 */
+		void clear()
+		{
+			_scores.clear();
+		}
+
+	private:
+		static constexpr Depth_t _max_weight_depth = 64;	///< Depth from which all rewards weight 1
+		std::unordered_map< T, unsigned long > _scores;		///< Score of each rewarded value
+	};
+
+	/**
+	 * @brief Killer moves
+	 *
+	 * Scoring table which keeps, for each ply, the last \a K values which
+	 * ended a loop. A killer value gets a score higher than any other
+	 * value, the most recent killer first.
+	 * \ingroup Ordering
+	 */
+	template < typename T, std::size_t K = 2 >
+	class Killer_moves
+	{
+	public:
+		/**
+		 * Return the score of value \a v at the ply \a ply.
+		 * @param v The value
+		 * @param ply The backtrack depth of the loop
+		 * @return K for the most recent killer, ..., 1 for the oldest one, 0 otherwise
+		 */
+		std::size_t operator()(const T& v, Depth_t ply) const
+		{
+			if (ply >= _killers.size()) return 0;
+			auto& k = _killers[ply];
+			for (std::size_t i = 0; i < k.second; ++i)
+				if (k.first[i] == v) return K - i;
+			return 0;
+		}
+
+		/**
+		 * Record value \a v as the most recent killer at ply \a ply.
+		 * @param v The value which ended a loop
+		 * @param ply The backtrack depth of the loop
+		 */
+		void reward(const T& v, Depth_t ply)
+		{
+			if (ply >= _killers.size()) _killers.resize(ply + 1);
+			auto& k = _killers[ply];
+			std::size_t i = 0;
+			while ((i < k.second) && !(k.first[i] == v)) ++i;
+			if (i == k.second) i = (k.second < K)?k.second++:K - 1;
+			for (; i > 0; --i) k.first[i] = k.first[i - 1];
+			k.first[0] = v;
+		}
+
+		/**
+		 * Clear the table.
+		 */
+		void clear()
+		{
+			_killers.clear();
+		}
+
+	private:
+		std::vector< std::pair< std::array< T, K >, std::size_t > > _killers;	///< Killers (and their count) of each ply
+	};
+}
+
+#endif /* RUNTIME_ORDERING_HH_ */
@@ -0,0 +1,303 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_PARALLEL_HH_
+#define RUNTIME_PARALLEL_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <backtrack.hh>
+#include <async.hpp>
+#include <ordering.hpp>
+
+/**
+ * \defgroup Parallel Parallel quantifiers
+ *
+ * The branches of a forall or an exists are independent once the loop variable
+ * is fixed. They can be evaluated concurrently by worker threads. The backtrack state
+ * and the constraint stores of a CHR space belong to the thread which uses
+ * them, so a branch can't run on the space of the caller: each branch creates
+ * its own space (with the create() function of the CHR program), posts the
+ * constraints of the branch and stores its result (for example a strategy)
+ * in an object of its own. The result of the branches are then merged (forall)
+ * or the result of the winning branch is adopted (exists) by the caller.
+ * The parallel functions return an ES_CHR status, they can be called
+ * from a rule body with the catch_failure pragma.
+ * The search statistics of each worker thread are merged into the ones of
+ * the program when the thread ends.
+ */
+
+namespace chr
+{
+	namespace internal
+	{
+		/**
+		 * Evaluate branch(v, r) for each value \a v of \a values on
+		 * \a nb_threads worker threads. The result of each branch is a new
+		 * object of type R. When a branch returns \a stop_on, the branches
+		 * of higher index are cancelled (and not started). If \a ordered is
+		 * false, all the other branches are cancelled. If the run of the caller
+		 * is cancelled, all the branches are cancelled. The first exception
+		 * thrown by a branch is rethrown by the caller.
+		 * @param values The values of the branches
+		 * @param branch The function evaluating a branch, it returns true if the branch has succeeded
+		 * @param nb_threads The number of worker threads (0 for the number of hardware threads)
+		 * @param stop_on The status of a branch which cancels the others
+		 * @param ordered True if only the branches of higher index are cancelled
+		 * @param results The results of the branches
+		 * @param status The status of the branches (true if the branch has succeeded)
+		 * @return The lowest index of a branch which has returned \a stop_on (the size of \a values if none)
+		 */
+		template < typename R, typename T, typename Branch >
+		std::size_t parallel_branches(const std::vector< T >& values, Branch& branch, unsigned int nb_threads, bool stop_on, bool ordered,
+				std::vector< std::optional< R > >& results, std::vector< char >& status)
+		{
+			if (nb_threads == 0) nb_threads = std::max(1u, std::thread::hardware_concurrency());
+			nb_threads = static_cast< unsigned int >( std::min< std::size_t >(nb_threads, values.size()) );
+
+			std::vector< chr::Cancellation_token > tokens(values.size());
+			std::atomic< bool >* parent = chr::Cancellation::attached();
+			std::atomic< std::size_t > next(0);
+			std::atomic< std::size_t > best(values.size());
+			std::exception_ptr error;
+			std::mutex mutex;
+
+			// Cancel the branches which can't change the outcome anymore
+			auto stop = [&](std::size_t i) {
+				std::lock_guard< std::mutex > lock(mutex);
+				if (i < best) best = i;
+				for (std::size_t j = 0; j < tokens.size(); ++j)
+					if ((j > best) || (!ordered && (j != best)))
+						tokens[j].cancel();
+			};
+
+			auto worker = [&]() {
+				chr::Statistics_thread_scope statistics_scope;
+				for (std::size_t i = next++; i < values.size(); i = next++)
+				{
+					if ((i > best) || (!ordered && (best < values.size()))) return;
+					if ((parent != nullptr) && parent->load(std::memory_order_relaxed)) return;
+					chr::Depth_t depth = chr::Backtrack::depth();
+					bool succeeded = false;
+					try {
+						succeeded = chr::run_cancellable(tokens[i], [&]() {
+							results[i].emplace();
+							return static_cast< bool >( branch(values[i], *results[i]) ) && !chr::failed();
+						});
+					} catch (...) {
+						{
+							std::lock_guard< std::mutex > lock(mutex);
+							if (!error) error = std::current_exception();
+						}
+						for (auto& t : tokens) t.cancel();
+						return;
+					}
+					if (chr::Backtrack::depth() > depth)
+						chr::Backtrack::back_to(depth);
+					chr::reset();
+					if (tokens[i].cancelled()) continue;
+					status[i] = succeeded;
+					if (succeeded == stop_on) stop(i);
+				}
+			};
+
+			std::vector< std::thread > threads;
+			std::condition_variable done;
+			unsigned int running = nb_threads;
+			threads.reserve(nb_threads);
+			for (unsigned int i = 0; i < nb_threads; ++i)
+				threads.emplace_back([&]() {
+					worker();
+					std::lock_guard< std::mutex > lock(mutex);
+					--running;
+					done.notify_all();
+				});
+			// The branch tokens are chained to the token of the caller: while
+			// the branches run, the caller polls its own flag and forwards
+			// a cancellation to all of them
+			if (parent != nullptr)
+			{
+				std::unique_lock< std::mutex > lock(mutex);
+				while ((running > 0) && !done.wait_for(lock, std::chrono::milliseconds(1), [&]() { return running == 0; }))
+					if (parent->load(std::memory_order_relaxed))
+					{
+						for (auto& t : tokens) t.cancel();
+						done.wait(lock, [&]() { return running == 0; });
+					}
+			}
+			for (auto& t : threads)
+				t.join();
+			if (error) std::rethrow_exception(error);
+			return best;
+		}
+	}
+
+	/**
+	 * Evaluate the branches of a forall over the values of \a values concurrently.
+	 * Each branch is given a new object of type R (default constructible) to
+	 * store its result. As soon as a branch fails, the siblings are cancelled
+	 * and the forall fails. If all branches succeed, merge(v, r) is called in
+	 * the caller thread for each value \a v and result \a r, in the order of
+	 * the values.
+	 * @param values The values of the loop variable
+	 * @param branch The function branch(v, r) evaluating the branch of \a v, it returns true if the branch has succeeded
+	 * @param merge The function merge(v, r) merging the result \a r of the branch of \a v
+	 * @param nb_threads The number of worker threads (0 for the number of hardware threads)
+	 * @return ES_CHR::SUCCESS if all branches have succeeded, ES_CHR::FAILURE otherwise
+	 * \ingroup Parallel
+	 */
+	template < typename R, typename T, typename Branch, typename Merge >
+	chr::ES_CHR parallel_forall_values(const std::vector< T >& values, Branch&& branch, Merge&& merge, unsigned int nb_threads = 0)
+	{
+		std::vector< std::optional< R > > results(values.size());
+		std::vector< char > status(values.size(), 0);
+		if (!values.empty())
+		{
+			std::size_t failed = internal::parallel_branches< R >(values, branch, nb_threads, false, false, results, status);
+			if ((failed < values.size()) || !std::all_of(status.begin(), status.end(), [](char s) { return s != 0; }))
+				return chr::failure();
+		}
+		for (std::size_t i = 0; i < values.size(); ++i)
+			merge(values[i], *results[i]);
+		return chr::success();
+	}
+
+	/**
+	 * Evaluate the branches of a forall over [\a lb, \a ub] concurrently
+	 * (see parallel_forall_values()).
+	 * @param lb The lower bound
+	 * @param ub The upper bound
+	 * @param branch The function branch(v, r) evaluating the branch of \a v
+	 * @param merge The function merge(v, r) merging the result \a r of the branch of \a v
+	 * @param nb_threads The number of worker threads (0 for the number of hardware threads)
+	 * @return ES_CHR::SUCCESS if all branches have succeeded, ES_CHR::FAILURE otherwise
+	 * \ingroup Parallel
+	 */
+	template < typename R, typename T1, typename T2, typename Branch, typename Merge >
+	chr::ES_CHR parallel_forall(const T1& lb, const T2& ub, Branch&& branch, Merge&& merge, unsigned int nb_threads = 0)
+	{
+		return parallel_forall_values< R >(chr::range_values(lb, ub), std::forward< Branch >(branch), std::forward< Merge >(merge), nb_threads);
+	}
+
+	/**
+	 * Evaluate the branches of a forall over the elements of container \a c
+	 * concurrently (see parallel_forall_values()).
+	 * @param c The container
+	 * @param branch The function branch(v, r) evaluating the branch of \a v
+	 * @param merge The function merge(v, r) merging the result \a r of the branch of \a v
+	 * @param nb_threads The number of worker threads (0 for the number of hardware threads)
+	 * @return ES_CHR::SUCCESS if all branches have succeeded, ES_CHR::FAILURE otherwise
+	 * \ingroup Parallel
+	 */
+	template < typename R, typename C, typename Branch, typename Merge >
+	chr::ES_CHR parallel_forall_it(const C& c, Branch&& branch, Merge&& merge, unsigned int nb_threads = 0)
+	{
+		std::vector< std::decay_t< decltype(*std::begin(c)) > > values(std::begin(c), std::end(c));
+		return parallel_forall_values< R >(values, std::forward< Branch >(branch), std::forward< Merge >(merge), nb_threads);
+	}
+
+	/**
+	 * Choice of the winning branch of a speculative exists.
+	 * \ingroup Parallel
+	 */
+	enum class Speculation {
+		LOWEST_INDEX,	///< The success of lowest index wins (same result as a sequential exists)
+		FIRST_SUCCESS	///< The first success wins (non-deterministic)
+	};
+
+	/**
+	 * Evaluate the branches of an exists over the values of \a values
+	 * speculatively: at most \a nb_threads branches are running at the
+	 * same time, in the order of the values. When a branch succeeds, the
+	 * branches of higher index are cancelled (all the other branches with
+	 * Speculation::FIRST_SUCCESS). Each branch is given a new object of type R
+	 * (default constructible) to store its result. The caller adopts the
+	 * result of the winning branch with adopt(v, r) (for example by posting
+	 * again the constraints or binding the variables stored in \a r).
+	 * @param values The values of the loop variable
+	 * @param branch The function branch(v, r) evaluating the branch of \a v, it returns true if the branch has succeeded
+	 * @param adopt The function adopt(v, r) adopting the result \a r of the winning branch of \a v
+	 * @param nb_threads The number of worker threads (0 for the number of hardware threads)
+	 * @param speculation The choice of the winning branch
+	 * @return ES_CHR::SUCCESS if a branch has succeeded, ES_CHR::FAILURE otherwise
+	 * \ingroup Parallel
+	 */
+	template < typename R, typename T, typename Branch, typename Adopt >
+	chr::ES_CHR parallel_exists_values(const std::vector< T >& values, Branch&& branch, Adopt&& adopt, unsigned int nb_threads = 0, Speculation speculation = Speculation::LOWEST_INDEX)
+	{
+		if (values.empty()) return chr::failure();
+		std::vector< std::optional< R > > results(values.size());
+		std::vector< char > status(values.size(), 0);
+		std::size_t winner = internal::parallel_branches< R >(values, branch, nb_threads, true, speculation == Speculation::LOWEST_INDEX, results, status);
+		if ((winner == values.size()) || chr::Cancellation::requested())
+			return chr::failure();
+		adopt(values[winner], *results[winner]);
+		return chr::success();
+	}
+
+	/**
+	 * Evaluate the branches of an exists over [\a lb, \a ub] speculatively
+	 * (see parallel_exists_values()).
+	 * @param lb The lower bound
+	 * @param ub The upper bound
+	 * @param branch The function branch(v, r) evaluating the branch of \a v
+	 * @param adopt The function adopt(v, r) adopting the result \a r of the winning branch of \a v
+	 * @param nb_threads The number of worker threads (0 for the number of hardware threads)
+	 * @param speculation The choice of the winning branch
+	 * @return ES_CHR::SUCCESS if a branch has succeeded, ES_CHR::FAILURE otherwise
+	 * \ingroup Parallel
+	 */
+	template < typename R, typename T1, typename T2, typename Branch, typename Adopt >
+	chr::ES_CHR parallel_exists(const T1& lb, const T2& ub, Branch&& branch, Adopt&& adopt, unsigned int nb_threads = 0, Speculation speculation = Speculation::LOWEST_INDEX)
+	{
+		return parallel_exists_values< R >(chr::range_values(lb, ub), std::forward< Branch >(branch), std::forward< Adopt >(adopt), nb_threads, speculation);
+	}
+
+	/**
+	 * Evaluate the branches of an exists over the elements of container \a c
+	 * speculatively (see parallel_exists_values()).
+	 * @param c The container
+	 * @param branch The function branch(v, r) evaluating the branch of \a v
+	 * @param adopt The function adopt(v, r) adopting the result \a r of the winning branch of \a v
+	 * @param nb_threads The number of worker threads (0 for the number of hardware threads)
+	 * @param speculation The choice of the winning branch
+	 * @return ES_CHR::SUCCESS if a branch has succeeded, ES_CHR::FAILURE otherwise
+	 * \ingroup Parallel
+	 */
+	template < typename R, typename C, typename Branch, typename Adopt >
+	chr::ES_CHR parallel_exists_it(const C& c, Branch&& branch, Adopt&& adopt, unsigned int nb_threads = 0, Speculation speculation = Speculation::LOWEST_INDEX)
+	{
+		std::vector< std::decay_t< decltype(*std::begin(c)) > > values(std::begin(c), std::end(c));
+		return parallel_exists_values< R >(values, std::forward< Branch >(branch), std::forward< Adopt >(adopt), nb_threads, speculation);
+	}
+}
+
+#endif /* RUNTIME_PARALLEL_HH_ */
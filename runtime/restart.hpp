@@ -0,0 +1,214 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_RESTART_HH_
+#define RUNTIME_RESTART_HH_
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <statistics.hh>
+#include <backtrack.hh>
+
+/**
+ * \defgroup Restart Restart strategies
+ *
+ * The restart(policy, (body)) statement runs the body with a limit on the
+ * number of failures (failed alternatives of choice points) given by the policy. When the limit is reached, the run
+ * is cancelled, the CHR space is restored (through back_to) and the body is
+ * run again with the next limit of the policy. The statement succeeds as soon
+ * as a run succeeds, it fails if a run fails without reaching its limit (the
+ * search space has been fully explored) or if the maximum number of runs is reached.
+ * As for exists and forall, the CHR space is restored when the statement ends.
+ * The failures are counted and the limit stops a run at its choice points: the
+ * CHR program must be compiled with the --enable-cancellation_points option of chrppc.
+ *
+ * A policy is also a scoring function for the order_by clause: the values
+ * of exists, forall, exists_it and forall_it are then visited in a random
+ * order which changes at each run and only depends on the seed of the policy.
+ * The nogood stores and the scoring tables (History_heuristic, ...) are
+ * user objects which are kept across restarts; they can be cleared in the
+ * on_restart() callback of the policy if needed.
+ *
+ * Any class with the start_run() and end_run(succeeded) member functions
+ * of Restart_policy can be given as the policy of a restart statement
+ * (see Lds_policy and Beam_policy).
+ */
+
+namespace chr
+{
+	/**
+	 * @brief Restart policy
+	 *
+	 * Give the sequence of failure limits of the runs of a restart statement:
+	 * scale * luby(i) for the Luby sequence (1 1 2 1 1 2 4 1 1 2 ...) or
+	 * scale * factor^i for the geometric sequence. It also gives a seeded
+	 * random score to any value, in order to randomize the iteration order
+	 * of the loops which use it in an order_by clause.
+	 * \ingroup Restart
+	 */
+	class Restart_policy
+	{
+	public:
+		/**
+		 * Sequence of the failure limits.
+		 */
+		enum class Schedule { LUBY, GEOMETRIC };
+
+		/**
+		 * Initialize.
+		 * @param schedule The sequence of failure limits
+		 * @param scale The failure limit of the first run
+		 * @param seed The seed of the random order of values
+		 * @param factor The growth factor of the geometric sequence
+		 * @param max_runs The maximum number of runs (0 for no limit)
+		 */
+		explicit Restart_policy(Schedule schedule = Schedule::LUBY, unsigned long scale = 100, std::uint_fast64_t seed = 0, double factor = 1.5, unsigned long max_runs = 0)
+			: _schedule(schedule), _scale(scale > 0 ? scale : 1), _factor(factor > 1.0 ? factor : 1.0),
+			  _max_runs(max_runs), _rng(seed)
+		{ }
+
+		/**
+		 * Copy constructor (deleted).
+		 */
+		Restart_policy(const Restart_policy&) =delete;
+
+		/**
+		 * Return the \a i th term of the Luby sequence (starting from 1).
+		 * @param i The index of the term
+		 * @return The term of the sequence
+		 */
+		static unsigned long luby(unsigned long i)
+		{
+			unsigned long k = 1;
+			while (((1ul << k) - 1) < i) ++k;
+			while (i != (1ul << k) - 1)
+			{
+				i -= (1ul << (k - 1)) - 1;
+				k = 1;
+				while (((1ul << k) - 1) < i) ++k;
+			}
+			return 1ul << (k - 1);
+		}
+
+		/**
+		 * Return the failure limit of the current (or next) run.
+		 * @return The failure limit
+		 */
+		unsigned long cutoff() const
+		{
+			if (_schedule == Schedule::LUBY)
+				return _scale * luby(_restarts + 1);
+			return static_cast< unsigned long >(std::ceil(static_cast< double >(_scale) * std::pow(_factor, static_cast< double >(_restarts))));
+		}
+
+		/**
+		 * Return the number of runs stopped by their failure limit.
+		 * @return The number of restarts
+		 */
+		unsigned long restarts() const { return _restarts; }
+
+		/**
+		 * Set the callback called before each new run (for example to
+		 * clear a nogood store or a scoring table).
+		 * @param f The callback
+		 */
+		void on_restart(std::function< void () > f) { _on_restart = std::move(f); }
+
+		/**
+		 * Give a random score to a value (scoring function of an order_by clause).
+		 * @return The random score
+		 */
+		template < typename T >
+		std::uint_fast64_t operator()(const T&) { return _rng(); }
+
+		/**
+		 * Start a new run: set the failure limit of the current thread.
+		 * Used by the restart statement.
+		 */
+		void start_run()
+		{
+			_previous.push_back( chr::Cancellation::limit_failures( cutoff() ) );
+		}
+
+		/**
+		 * End the current run and restore the previous failure limit.
+		 * Used by the restart statement.
+		 * @param succeeded True if the run has succeeded
+		 * @return True if the statement is done, false if a new run must be started
+		 */
+		bool end_run(bool succeeded)
+		{
+			bool cut = chr::Cancellation::limit_reached();
+			chr::Cancellation::restore( _previous.back() );
+			_previous.pop_back();
+			if (succeeded || !cut || chr::Cancellation::requested()) return true;
+			++_restarts;
+			chr::Statistics::inc_nb_restarts();
+			if ((_max_runs > 0) && (_restarts >= _max_runs)) return true;
+			if (_on_restart) _on_restart();
+			return false;
+		}
+
+	private:
+		Schedule _schedule;								///< Sequence of failure limits
+		unsigned long _scale;							///< Failure limit of the first run
+		double _factor;									///< Growth factor of the geometric sequence
+		unsigned long _max_runs;						///< Maximum number of runs (0 for no limit)
+		unsigned long _restarts = 0;					///< Number of runs stopped by their failure limit
+		std::mt19937_64 _rng;							///< Random generator of the order of values
+		std::function< void () > _on_restart;			///< Callback called before each new run
+		std::vector< chr::Cancellation::Failure_limit > _previous;	///< Failure limits saved by the current runs (nested ones included)
+	};
+
+	/**
+	 * Start a run of a restart statement.
+	 * Used by the restart statement.
+	 * @param policy The restart policy
+	 * @return ES_CHR::SUCCESS
+	 * \ingroup Restart
+	 */
+	template < typename P >
+	chr::ES_CHR restart_run(P& policy)
+	{
+		policy.start_run();
+		return chr::success();
+	}
+
+	/**
+	 * End a run of a restart statement.
+	 * Used by the restart statement.
+	 * @param policy The restart policy
+	 * @param succeeded True if the run has succeeded
+	 * @return True if the statement is done, false otherwise
+	 * \ingroup Restart
+	 */
+	template < typename P >
+	bool restart_end(P& policy, bool succeeded)
+	{
+		return policy.end_run(succeeded);
+	}
+}
+
+#endif /* RUNTIME_RESTART_HH_ */
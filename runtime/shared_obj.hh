@@ -253,16 +253,28 @@ namespace chr {
 			if (_ptr == nullptr) return;
 			assert(_ptr->_ref_use_count > 0);
 			if (_ptr->_ref_use_count == 1)
-			{
-				_ptr->~T(); // Call destructor
-				_ptr->_ref_use_count = 0;
-				if (_ptr->_ref_weak_count == 0)
-				{
-					typename Get_allocator_t<T>::type a;
-					a.deallocate(_ptr,1);
-				}
-			} else {
+				destroy(_ptr);
+			else
 				--_ptr->_ref_use_count;
+		}
+
+		/**
+		 * Destroy the shared object \a ptr whose last reference is released,
+		 * and free it if there is no more weak reference on it.
+		 * It is kept out of line: when two Shared_obj on the same object are
+		 * released one after the other, the deallocation inlined in the caller
+		 * made GCC report a use after free on the second reference count
+		 * (it can't see that the count was not 1 at the first release).
+		 * @param ptr The shared object to destroy
+		 */
+		[[gnu::noinline]] static void destroy(T* ptr)
+		{
+			ptr->~T(); // Call destructor
+			ptr->_ref_use_count = 0;
+			if (ptr->_ref_weak_count == 0)
+			{
+				typename Get_allocator_t<T>::type a;
+				a.deallocate(ptr,1);
 			}
 		}
 
@@ -0,0 +1,234 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_SOLUTIONS_HH_
+#define RUNTIME_SOLUTIONS_HH_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <backtrack.hh>
+#include <fiber.hpp>
+
+/**
+ * \defgroup Solutions Lazy enumeration of solutions
+ *
+ * A rule body marks a solution with chr::yield_solution() # catch_failure.
+ * When the CHR program runs in a chr::Solutions range, the run is suspended
+ * at each solution: the caller reads the constraint stores of the program
+ * (chr_store_begin()) and the next increment of the iterator resumes the run,
+ * yield_solution() then fails and the search backtracks into the next
+ * alternative of the last choice point. Only the current branch of the
+ * search is kept (on the stack of the fiber of the range), the memory used
+ * does not depend on the number of solutions enumerated.
+ * Outside of a fiber, yield_solution() succeeds: the run stops at the first solution.
+ * A chr::Solutions range needs the fibers of the platform (see \ref Fiber):
+ * without them it can't be instantiated (on macOS, _XOPEN_SOURCE must be
+ * defined to get the ucontext API).
+ */
+
+namespace chr
+{
+	/**
+	 * Mark a solution of the CHR program.
+	 * Inside a branch and bound search (see chr::Incumbent), the solution is
+	 * given to the incumbent and the search goes on with a tighter bound.
+	 * Inside a fiber (see chr::Solutions), the run is suspended and the
+	 * search goes on with the next solution when it is resumed.
+	 * @return ES_CHR::FAILURE inside a branch and bound search or a fiber (after it has been resumed), ES_CHR::SUCCESS otherwise
+	 * \ingroup Solutions
+	 */
+	inline chr::ES_CHR yield_solution()
+	{
+		if (chr::Bound::active()) return chr::Bound::solution();
+		if (chr::Fiber::current() == nullptr) return chr::success();
+		chr::Fiber::suspend();
+		return chr::failure();
+	}
+
+	/**
+	 * @brief Lazy range of the solutions of a CHR program
+	 *
+	 * The CHR program is created and run in a fiber when the range is first
+	 * iterated. Each iterator dereference gives the CHR program in the state of
+	 * the current solution, incrementing the iterator resumes the search to the
+	 * next solution. The range is an input range: it can be iterated only once.
+	 * Leaving the range before the last solution cancels the run.
+	 * @tparam Space The type of the CHR program (as returned by its create() function)
+	 * \ingroup Solutions
+	 */
+	template < typename Space >
+	class Solutions
+	{
+#ifndef CHR_ENABLE_FIBER
+		// Without fibers, a run can't be suspended at a solution and the range would stay empty
+		static_assert(sizeof(Space) == 0, "chr::Solutions needs the fibers, which are not available on this platform (see chr::Fiber)");
+#endif
+	public:
+		/**
+		 * @brief Input iterator over the solutions
+		 */
+		class iterator
+		{
+		public:
+			using iterator_category = std::input_iterator_tag;	///< Category of the iterator
+			using value_type = Space;							///< Type of the values
+			using difference_type = std::ptrdiff_t;				///< Type of the differences
+			using pointer = Space*;								///< Type of a pointer to a value
+			using reference = Space&;							///< Type of a reference to a value
+
+			/**
+			 * Initialize.
+			 * @param s The range of solutions (nullptr for the end iterator)
+			 */
+			explicit iterator(Solutions* s = nullptr) : _s(s) { }
+
+			/**
+			 * Return the CHR program in the state of the current solution.
+			 * @return The CHR program
+			 */
+			reference operator*() const { return *_s->_space; }
+
+			/**
+			 * Return the CHR program in the state of the current solution.
+			 * @return A pointer to the CHR program
+			 */
+			pointer operator->() const { return _s->_space; }
+
+			/**
+			 * Resume the search to the next solution.
+			 * @return A reference to this iterator
+			 */
+			iterator& operator++()
+			{
+				_s->next();
+				return *this;
+			}
+
+			/**
+			 * Resume the search to the next solution.
+			 */
+			void operator++(int) { ++*this; }
+
+			/**
+			 * Check if two iterators are both at the end of the range.
+			 * @param o The other iterator
+			 * @return True if both iterators are at the end, false otherwise
+			 */
+			bool operator==(const iterator& o) const { return at_end() && o.at_end(); }
+
+			/**
+			 * Check if the iterator is at the end of the range.
+			 * @return True if there is no more solution, false otherwise
+			 */
+			bool at_end() const { return (_s == nullptr) || (_s->_space == nullptr); }
+
+		private:
+			Solutions* _s;	///< Range of solutions
+		};
+
+		/**
+		 * Initialize.
+		 * @param create Function creating the CHR program (called in the fiber of the range)
+		 * @param goal Function calling the constraints of the goal on the CHR program
+		 * @param stack_size The size of the call stack of the fiber
+		 */
+		template < typename Create, typename Goal >
+		Solutions(Create create, Goal goal, std::size_t stack_size = chr::Fiber::DEFAULT_STACK_SIZE)
+			: _fiber([this, create = std::move(create), goal = std::move(goal)]() mutable {
+					Space space = create();
+					_space = &space;
+					goal(space);
+					_space = nullptr;
+				}, stack_size)
+		{ }
+
+		/**
+		 * Copy constructor (deleted).
+		 */
+		Solutions(const Solutions&) =delete;
+
+		/**
+		 * Assignment operator (deleted).
+		 */
+		Solutions& operator=(const Solutions&) =delete;
+
+		/**
+		 * Return an iterator on the current solution. The search is started
+		 * at the first call, up to the first solution.
+		 * @return The iterator
+		 */
+		iterator begin()
+		{
+			if (!_started)
+			{
+				_started = true;
+				next();
+			}
+			return iterator(this);
+		}
+
+		/**
+		 * Return the end iterator.
+		 * @return The end iterator
+		 */
+		iterator end() { return iterator(); }
+
+		/**
+		 * Return the number of solutions found so far.
+		 * @return The number of solutions
+		 */
+		std::size_t count() const { return _count; }
+
+	private:
+		/**
+		 * Resume the search to the next solution.
+		 */
+		void next()
+		{
+			_fiber.resume();
+			if (_space != nullptr) ++_count;
+		}
+
+		Space* _space = nullptr;	///< CHR program (only when the run is suspended at a solution)
+		std::size_t _count = 0;		///< Number of solutions found so far
+		bool _started = false;		///< True if the search has been started
+		chr::Fiber _fiber;			///< Fiber of the run of the CHR program
+	};
+
+	/**
+	 * Create a lazy range of the solutions of a CHR program.
+	 * @param create Function creating the CHR program (called in the fiber of the range)
+	 * @param goal Function calling the constraints of the goal on the CHR program
+	 * @return The range of solutions
+	 * \ingroup Solutions
+	 */
+	template < typename Create, typename Goal >
+	Solutions< std::invoke_result_t< Create& > > solutions(Create create, Goal goal)
+	{
+		return Solutions< std::invoke_result_t< Create& > >(std::move(create), std::move(goal));
+	}
+}
+
+#endif /* RUNTIME_SOLUTIONS_HH_ */
@@ -22,9 +22,12 @@
 #ifndef RUNTIME_STATISTICS_HH_
 #define RUNTIME_STATISTICS_HH_
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <iostream>
 #include <iomanip>
+#include <mutex>
 #include <ostream>
 #include <string>
 
@@ -111,6 +114,11 @@ namespace chr {
 	 * maximum memory amount, number of choices, etc.
 	 * The template parameter is only here to allow static initialization
 	 * in a .hh file (useful tip).
+	 * The search counters (choices, failures, rules, etc.) are local to each
+	 * thread. A worker thread adds its counters to the ones of the program
+	 * with merge_thread() before it ends (see Statistics_thread_scope).
+	 * The memory counters are shared by all the threads which run CHR
+	 * programs, they are atomic.
 	 * \ingroup Trace_statistics
 	 */
 	template < typename T >
@@ -133,10 +141,11 @@ namespace chr {
 		static void clear()
 		{
 			runtime = std::chrono::duration_values<std::chrono::milliseconds>::zero();
-			peak_depth = 0;
-			nb_failures = 0;
-			nb_choices = 0;
-			nb_rules = 0;
+			counters = Search_counters();
+			{
+				std::lock_guard< std::mutex > lock(merged_mutex);
+				merged = Search_counters();
+			}
 			peak_variables_memory = 0;
 			total_variables_memory = 0;
 			peak_store_memory = 0;
@@ -190,8 +199,8 @@ namespace chr {
 		 */
 		static void update_peak_depth(unsigned int d)
 		{
-			if (d > peak_depth)
-				peak_depth = d;
+			if (d > counters.peak_depth)
+				counters.peak_depth = d;
 		}
 
 		/**
@@ -200,7 +209,7 @@ namespace chr {
 		 */
 		static void inc_nb_rules(unsigned int n = 1)
 		{
-			nb_rules += n;
+			counters.nb_rules += n;
 		}
 
 		/**
@@ -209,7 +218,54 @@ namespace chr {
 		 */
 		static void inc_nb_failures(unsigned int n = 1)
 		{
-			nb_failures += n;
+			counters.nb_failures += n;
+		}
+
+		/**
+		 * Increase the number of back-jumps by \a n.
+		 * @param n The number of back-jumps to add
+		 */
+		static void inc_nb_backjumps(unsigned int n = 1)
+		{
+			counters.nb_backjumps += n;
+		}
+
+		/**
+		 * Increase the number of subtrees cut by a nogood by \a n.
+		 * @param n The number of nogood hits to add
+		 */
+		static void inc_nb_nogood_hits(unsigned int n = 1)
+		{
+			counters.nb_nogood_hits += n;
+		}
+
+		/**
+		 * Increase the number of restarts by \a n.
+		 * @param n The number of restarts to add
+		 */
+		static void inc_nb_restarts(unsigned int n = 1)
+		{
+			counters.nb_restarts += n;
+		}
+
+		/**
+		 * Increase the number of values skipped by symmetry breaking by \a n.
+		 * @param n The number of skipped values to add
+		 */
+		static void inc_nb_symmetries(unsigned long n = 1)
+		{
+			counters.nb_symmetries += n;
+		}
+
+		/**
+		 * Increase the number of MCTS playouts by \a n and their running time by \a t.
+		 * @param n The number of playouts to add
+		 * @param t The time spent in these playouts
+		 */
+		static void inc_nb_playouts(unsigned long n, std::chrono::microseconds t)
+		{
+			counters.nb_playouts += n;
+			counters.playout_time += t;
 		}
 
 		/**
@@ -217,7 +273,7 @@ namespace chr {
 		 */
         static void open_choice()
 		{
-            ++nb_choices;
+            ++counters.nb_choices;
 		}
 
 		/**
@@ -244,6 +300,36 @@ namespace chr {
 		static void inc_nb_failures(unsigned int = 1)
 		{ }
 
+		/**
+		 * Increase the number of back-jumps.
+		 */
+		static void inc_nb_backjumps(unsigned int = 1)
+		{ }
+
+		/**
+		 * Increase the number of subtrees cut by a nogood.
+		 */
+		static void inc_nb_nogood_hits(unsigned int = 1)
+		{ }
+
+		/**
+		 * Increase the number of restarts.
+		 */
+		static void inc_nb_restarts(unsigned int = 1)
+		{ }
+
+		/**
+		 * Increase the number of values skipped by symmetry breaking.
+		 */
+		static void inc_nb_symmetries(unsigned long = 1)
+		{ }
+
+		/**
+		 * Increase the number of MCTS playouts.
+		 */
+		static void inc_nb_playouts(unsigned long, std::chrono::microseconds)
+		{ }
+
 		/**
          * Open a new choice (subtree) in the search tree.
 		 */
@@ -279,7 +365,7 @@ namespace chr {
 		{
 			uint8_t x = 0;
 			if (top_of_call_stack != nullptr)
-				peak_call_stack = std::max((size_t)(top_of_call_stack - &x), peak_call_stack);
+				update_peak(peak_call_stack, (size_t)(top_of_call_stack - &x));
 			if ((system_call_stack_size > 0) && ((system_call_stack_size - peak_call_stack) < 100000 ))
 			{
 				std::cerr << "[CHR] Abort, remaining call stack size is less than 100ko." << std::endl;
@@ -307,6 +393,49 @@ namespace chr {
 #endif
 		}
 
+		/**
+		 * Return the number of choices (nodes of the search tree) opened until now
+		 * by the current thread and the worker threads merged.
+		 * @return The number of choices (0 if statistics are disabled)
+		 */
+		static unsigned long int get_nb_choices()
+		{
+#ifdef ENABLE_STATISTICS
+			return total().nb_choices;
+#else
+			return 0;
+#endif
+		}
+
+		/**
+		 * Add the search counters of the current thread to the ones of
+		 * the program and reset them. It must be called by a worker thread
+		 * before it ends, the counters of the thread are lost otherwise.
+		 */
+		static void merge_thread()
+		{
+#ifdef ENABLE_STATISTICS
+			std::lock_guard< std::mutex > lock(merged_mutex);
+			merged.merge(counters);
+			counters = Search_counters();
+#endif
+		}
+
+		/**
+		 * Return the throughput of the MCTS playouts.
+		 * @return The number of playouts per second of playout time
+		 */
+		static double playouts_per_second()
+		{
+#ifdef ENABLE_STATISTICS
+			Search_counters c = total();
+			if (c.playout_time.count() == 0) return 0.0;
+			return static_cast< double >(c.nb_playouts) * 1e6 / static_cast< double >(c.playout_time.count());
+#else
+			return 0.0;
+#endif
+		}
+
 		/**
 		 * Return a string that contains all attributes in
 		 * a human reading form.
@@ -316,19 +445,26 @@ namespace chr {
 		{
 			std::string str;
 #ifdef ENABLE_STATISTICS
+			Search_counters c = total();
 			str += "(runtime," + std::to_string(runtime.count()) + ")";
-			str += ",(failures," + std::to_string(nb_failures) + ")";
-			str += ",(nb_choices," + std::to_string(nb_choices) + ")";
-			str += ",(peak_depth," + std::to_string(peak_depth) + ")";
-			str += ",(nb_rules," + std::to_string(nb_rules) + ")";
+			str += ",(failures," + std::to_string(c.nb_failures) + ")";
+			str += ",(backjumps," + std::to_string(c.nb_backjumps) + ")";
+			str += ",(nogood_hits," + std::to_string(c.nb_nogood_hits) + ")";
+			str += ",(restarts," + std::to_string(c.nb_restarts) + ")";
+			str += ",(symmetries," + std::to_string(c.nb_symmetries) + ")";
+			str += ",(playouts," + std::to_string(c.nb_playouts) + ")";
+			str += ",(playouts_per_second," + std::to_string(playouts_per_second()) + ")";
+			str += ",(nb_choices," + std::to_string(c.nb_choices) + ")";
+			str += ",(peak_depth," + std::to_string(c.peak_depth) + ")";
+			str += ",(nb_rules," + std::to_string(c.nb_rules) + ")";
 #endif
 #if defined(ENABLE_STATISTICS) && defined(ENABLE_MEMORY_STATISTICS)
-			str += ",(peak_variables_memory," + std::to_string(peak_variables_memory) + ")";
-			str += ",(total_variables_memory," + std::to_string(total_variables_memory) + ")";
-			str += ",(peak_store_memory," + std::to_string(peak_store_memory) + ")";
-			str += ",(peak_history_memory," + std::to_string(peak_history_memory) + ")";
-			str += ",(peak_other_memory," + std::to_string(peak_other_memory) + ")";
-			str += ",(peak_system_call_stack," + std::to_string(peak_call_stack) + ")";
+			str += ",(peak_variables_memory," + std::to_string(peak_variables_memory.load()) + ")";
+			str += ",(total_variables_memory," + std::to_string(total_variables_memory.load()) + ")";
+			str += ",(peak_store_memory," + std::to_string(peak_store_memory.load()) + ")";
+			str += ",(peak_history_memory," + std::to_string(peak_history_memory.load()) + ")";
+			str += ",(peak_other_memory," + std::to_string(peak_other_memory.load()) + ")";
+			str += ",(peak_system_call_stack," + std::to_string(peak_call_stack.load()) + ")";
 #endif
 			return str;
 		}
@@ -342,6 +478,7 @@ namespace chr {
 		static void print(std::ostream& out)
 		{
 			const unsigned int f1 = 20, f2 = 10;
+			Search_counters c = total();
 			out << std::endl;
 			out << "Summary" << std::endl;
 			out << std::setw(f1) << std::left << "  runtime:";
@@ -349,27 +486,41 @@ namespace chr {
 			out << std::setw(f2) << std::right << runtime_s.count();
 			out << " (" << runtime.count() << " ms)" << std::endl;
 			out << std::setw(f1) << std::left << "  failures:";
-			out << std::setw(f2) << std::right << nb_failures << std::endl;
+			out << std::setw(f2) << std::right << c.nb_failures << std::endl;
+			out << std::setw(f1) << std::left << "  backjumps:";
+			out << std::setw(f2) << std::right << c.nb_backjumps << std::endl;
+			out << std::setw(f1) << std::left << "  nogood hits:";
+			out << std::setw(f2) << std::right << c.nb_nogood_hits << std::endl;
+			out << std::setw(f1) << std::left << "  restarts:";
+			out << std::setw(f2) << std::right << c.nb_restarts << std::endl;
+			out << std::setw(f1) << std::left << "  symmetries:";
+			out << std::setw(f2) << std::right << c.nb_symmetries << std::endl;
+			if (c.nb_playouts > 0)
+			{
+				out << std::setw(f1) << std::left << "  playouts:";
+				out << std::setw(f2) << std::right << c.nb_playouts;
+				out << " (" << static_cast< unsigned long >(playouts_per_second()) << " /s)" << std::endl;
+			}
 			out << std::setw(f1) << std::left << "  nodes:";
-			out << std::setw(f2) << std::right << nb_choices << std::endl;
+			out << std::setw(f2) << std::right << c.nb_choices << std::endl;
 			out << std::setw(f1) << std::left << "  peak depth:";
-			out << std::setw(f2) << std::right << peak_depth << std::endl;
+			out << std::setw(f2) << std::right << c.peak_depth << std::endl;
 			out << std::setw(f1) << std::left << "  triggered rules:";
-			out << std::setw(f2) << std::right << nb_rules << std::endl;
+			out << std::setw(f2) << std::right << c.nb_rules << std::endl;
 #if defined(ENABLE_STATISTICS) && defined(ENABLE_MEMORY_STATISTICS)
 			const unsigned int f3 = 40;
 			out << std::setw(f3) << std::left << "  peak variables memory:";
-			out << std::setw(f2) << std::right << size_to_unit(peak_variables_memory) << std::endl;
+			out << std::setw(f2) << std::right << size_to_unit(peak_variables_memory.load()) << std::endl;
 			out << std::setw(f3) << std::left << "  total allocated for variables memory:";
-			out << std::setw(f2) << std::right << size_to_unit(total_variables_memory) << std::endl;
+			out << std::setw(f2) << std::right << size_to_unit(total_variables_memory.load()) << std::endl;
 			out << std::setw(f3) << std::left << "  peak constraint stores memory:";
-			out << std::setw(f2) << std::right << size_to_unit(peak_store_memory) << std::endl;
+			out << std::setw(f2) << std::right << size_to_unit(peak_store_memory.load()) << std::endl;
 			out << std::setw(f3) << std::left << "  peak history memory:";
-			out << std::setw(f2) << std::right << size_to_unit(peak_history_memory) << std::endl;
+			out << std::setw(f2) << std::right << size_to_unit(peak_history_memory.load()) << std::endl;
 			out << std::setw(f3) << std::left << "  peak other data memory:";
-			out << std::setw(f2) << std::right << size_to_unit(peak_other_memory) << std::endl;
+			out << std::setw(f2) << std::right << size_to_unit(peak_other_memory.load()) << std::endl;
 			out << std::setw(f3) << std::left << "  peak system call stack:";
-			out << std::setw(f2) << std::right << size_to_unit(peak_call_stack) << std::endl;
+			out << std::setw(f2) << std::right << size_to_unit(peak_call_stack.load()) << std::endl;
 #endif
 		}
 #else
@@ -381,31 +532,100 @@ namespace chr {
 #endif
 
 	private:
+		/**
+		 * @brief Search counters of a thread
+		 */
+		struct Search_counters
+		{
+			unsigned long int nb_choices = 0;			///< Total number choices
+			unsigned long int peak_depth = 0;			///< Maximum number of choices among all CHR branches
+			unsigned long int nb_failures = 0;			///< Number of failures
+			unsigned long int nb_backjumps = 0;			///< Number of choice points left by a back-jump
+			unsigned long int nb_nogood_hits = 0;		///< Number of subtrees cut by a nogood
+			unsigned long int nb_restarts = 0;			///< Number of runs stopped by a restart policy
+			unsigned long int nb_symmetries = 0;		///< Number of values skipped by symmetry breaking
+			unsigned long int nb_playouts = 0;			///< Number of MCTS playouts
+			std::chrono::microseconds playout_time = std::chrono::microseconds::zero();	///< Time spent in MCTS playouts
+			size_t nb_rules = 0;						///< Number of applied rules
+
+			/**
+			 * Add the counters of \a o to this ones.
+			 * @param o The counters to add
+			 */
+			void merge(const Search_counters& o)
+			{
+				nb_choices += o.nb_choices;
+				peak_depth = std::max(peak_depth, o.peak_depth);
+				nb_failures += o.nb_failures;
+				nb_backjumps += o.nb_backjumps;
+				nb_nogood_hits += o.nb_nogood_hits;
+				nb_restarts += o.nb_restarts;
+				nb_symmetries += o.nb_symmetries;
+				nb_playouts += o.nb_playouts;
+				playout_time += o.playout_time;
+				nb_rules += o.nb_rules;
+			}
+		};
+
+		/**
+		 * Raise the atomic maximum \a peak to \a v if it is lower.
+		 * @param peak The maximum to update
+		 * @param v The new value
+		 */
+		static void update_peak(std::atomic< size_t >& peak, size_t v)
+		{
+			size_t p = peak.load(std::memory_order_relaxed);
+			while ((v > p) && !peak.compare_exchange_weak(p, v, std::memory_order_relaxed)) { }
+		}
+
+		/**
+		 * Add \a s to the atomic counter \a cur and update its maximum \a peak.
+		 * @param cur The counter of the memory currently used
+		 * @param peak The maximum of \a cur
+		 * @param s The size to add
+		 */
+		static void add_memory(std::atomic< size_t >& cur, std::atomic< size_t >& peak, size_t s)
+		{
+			update_peak(peak, cur.fetch_add(s, std::memory_order_relaxed) + s);
+		}
+
+		/**
+		 * Return the counters of the current thread added to the ones
+		 * merged by the worker threads.
+		 * @return The total of the search counters
+		 */
+		static Search_counters total()
+		{
+			std::lock_guard< std::mutex > lock(merged_mutex);
+			Search_counters c = merged;
+			c.merge(counters);
+			return c;
+		}
+
 		static std::chrono::milliseconds runtime;		///< Runtime in milliseconds
-		static unsigned long int nb_choices;			///< Total number choices
-		static unsigned long int peak_depth;			///< Maximum number of choices among all CHR branches
-		static unsigned long int nb_failures;			///< Number of failures
-		static size_t nb_rules;							///< Number of applied rules
-		static size_t peak_variables_memory;			///< Maximum memory used by variables
-		static size_t total_variables_memory;			///< Total memory allocated for variables
-		static size_t peak_store_memory;				///< Maximum memory used by constraint stores
-		static size_t peak_history_memory;				///< Maximum memory used by history
-		static size_t peak_other_memory;				///< Maximum memory used by other data structures (as Interval)
+		static thread_local Search_counters counters;	///< Search counters of the current thread
+		static Search_counters merged;					///< Search counters merged by the worker threads
+		static std::mutex merged_mutex;					///< Mutex protecting merged
+		static std::atomic< size_t > peak_variables_memory;		///< Maximum memory used by variables
+		static std::atomic< size_t > total_variables_memory;	///< Total memory allocated for variables
+		static std::atomic< size_t > peak_store_memory;			///< Maximum memory used by constraint stores
+		static std::atomic< size_t > peak_history_memory;		///< Maximum memory used by history
+		static std::atomic< size_t > peak_other_memory;			///< Maximum memory used by other data structures (as Interval)
 
 		static std::chrono::steady_clock::time_point start;	///< Start of the clock
 		static std::chrono::steady_clock::time_point end;	///< End of the clock
 
 
-		static size_t cur_variables_memory;				///< Current memory used by variables
-		static size_t cur_store_memory;					///< Current memory used by constraint stores
-		static size_t cur_history_memory;				///< Current memory used by history
-		static size_t cur_other_memory;					///< Current memory used by other data 
+		static std::atomic< size_t > cur_variables_memory;		///< Current memory used by variables
+		static std::atomic< size_t > cur_store_memory;			///< Current memory used by constraint stores
+		static std::atomic< size_t > cur_history_memory;		///< Current memory used by history
+		static std::atomic< size_t > cur_other_memory;			///< Current memory used by other data 
 
-		static size_t peak_call_stack;					///< Maximun computed call stack size
+		static std::atomic< size_t > peak_call_stack;			///< Maximun computed call stack size
 
 	public:
-		static uint8_t* top_of_call_stack;				///< Adress of the top of the call stack
-		static size_t system_call_stack_size;			///< Size of system call stack
+		static thread_local uint8_t* top_of_call_stack;	///< Adress of the top of the call stack of the current thread
+		static std::atomic< size_t > system_call_stack_size;	///< Size of system call stack
 	};
 
 	// Initialization of static members
@@ -416,37 +636,35 @@ namespace chr {
 	template< typename T >
 	std::chrono::milliseconds chr::Statistics_t<T>::runtime = std::chrono::duration_values<std::chrono::milliseconds>::zero();
 	template< typename T >
-	unsigned long int chr::Statistics_t<T>::peak_depth = 0;
-	template< typename T >
-	unsigned long int chr::Statistics_t<T>::nb_failures = 0;
+	thread_local typename chr::Statistics_t<T>::Search_counters chr::Statistics_t<T>::counters;
 	template< typename T >
-	unsigned long int chr::Statistics_t<T>::nb_choices = 0;
+	typename chr::Statistics_t<T>::Search_counters chr::Statistics_t<T>::merged;
 	template< typename T >
-	size_t chr::Statistics_t<T>::nb_rules = 0;
+	std::mutex chr::Statistics_t<T>::merged_mutex;
 	template< typename T >
-	size_t chr::Statistics_t<T>::peak_variables_memory = 0;
+	std::atomic< size_t > chr::Statistics_t<T>::peak_variables_memory = 0;
 	template< typename T >
-	size_t chr::Statistics_t<T>::total_variables_memory = 0;
+	std::atomic< size_t > chr::Statistics_t<T>::total_variables_memory = 0;
 	template< typename T >
-	size_t chr::Statistics_t<T>::peak_store_memory = 0;
+	std::atomic< size_t > chr::Statistics_t<T>::peak_store_memory = 0;
 	template< typename T >
-	size_t chr::Statistics_t<T>::peak_history_memory = 0;
+	std::atomic< size_t > chr::Statistics_t<T>::peak_history_memory = 0;
 	template< typename T >
-	size_t chr::Statistics_t<T>::peak_other_memory = 0;
+	std::atomic< size_t > chr::Statistics_t<T>::peak_other_memory = 0;
 	template< typename T >
-	size_t chr::Statistics_t<T>::cur_variables_memory = 0;
+	std::atomic< size_t > chr::Statistics_t<T>::cur_variables_memory = 0;
 	template< typename T >
-	size_t chr::Statistics_t<T>::cur_store_memory = 0;
+	std::atomic< size_t > chr::Statistics_t<T>::cur_store_memory = 0;
 	template< typename T >
-	size_t chr::Statistics_t<T>::cur_history_memory = 0;
+	std::atomic< size_t > chr::Statistics_t<T>::cur_history_memory = 0;
 	template< typename T >
-	size_t chr::Statistics_t<T>::cur_other_memory = 0;
+	std::atomic< size_t > chr::Statistics_t<T>::cur_other_memory = 0;
 	template< typename T >
-	uint8_t* chr::Statistics_t<T>::top_of_call_stack = nullptr;
+	thread_local uint8_t* chr::Statistics_t<T>::top_of_call_stack = nullptr;
 	template< typename T >
-	size_t chr::Statistics_t<T>::peak_call_stack = 0;
+	std::atomic< size_t > chr::Statistics_t<T>::peak_call_stack = 0;
 	template< typename T >
-	size_t chr::Statistics_t<T>::system_call_stack_size = 0;
+	std::atomic< size_t > chr::Statistics_t<T>::system_call_stack_size = 0;
 
 	// Dummy class to get rid off the template parameter
 	struct Dummy_statistics { };
@@ -456,71 +674,78 @@ namespace chr {
 	template<>
 	inline void chr::Statistics_t<Dummy_statistics>::inc_memory< chr::Statistics_t<Dummy_statistics>::VARIABLE >(size_t s)
 	{
-		cur_variables_memory += s;
-		total_variables_memory += s;
-		if (cur_variables_memory > peak_variables_memory)
-			peak_variables_memory = cur_variables_memory;
+		total_variables_memory.fetch_add(s, std::memory_order_relaxed);
+		add_memory(cur_variables_memory, peak_variables_memory, s);
 	}
 
 	template<>
 	template<>
 	inline void chr::Statistics_t<Dummy_statistics>::dec_memory< chr::Statistics_t<Dummy_statistics>::VARIABLE >(size_t s)
 	{
-		cur_variables_memory -= s;
+		cur_variables_memory.fetch_sub(s, std::memory_order_relaxed);
 	}
 
 	template<>
 	template<>
 	inline void chr::Statistics_t<Dummy_statistics>::inc_memory< chr::Statistics_t<Dummy_statistics>::CONSTRAINT_STORE >(size_t s)
 	{
-		cur_store_memory += s;
-		if (cur_store_memory > peak_store_memory)
-			peak_store_memory = cur_store_memory;
+		add_memory(cur_store_memory, peak_store_memory, s);
 	}
 
 	template<>
 	template<>
 	inline void chr::Statistics_t<Dummy_statistics>::dec_memory< chr::Statistics_t<Dummy_statistics>::CONSTRAINT_STORE >(size_t s)
 	{
-		cur_store_memory -= s;
+		cur_store_memory.fetch_sub(s, std::memory_order_relaxed);
 	}
 
 	template<>
 	template<>
 	inline void chr::Statistics_t<Dummy_statistics>::inc_memory< chr::Statistics_t<Dummy_statistics>::HISTORY >(size_t s)
 	{
-		cur_history_memory += s;
-		if (cur_history_memory > peak_history_memory)
-			peak_history_memory = cur_history_memory;
+		add_memory(cur_history_memory, peak_history_memory, s);
 	}
 
 	template<>
 	template<>
 	inline void chr::Statistics_t<Dummy_statistics>::dec_memory< chr::Statistics_t<Dummy_statistics>::HISTORY >(size_t s)
 	{
-		cur_history_memory -= s;
+		cur_history_memory.fetch_sub(s, std::memory_order_relaxed);
 	}
 
 	template<>
 	template<>
 	inline void chr::Statistics_t<Dummy_statistics>::dec_memory< chr::Statistics_t<Dummy_statistics>::OTHER >(size_t s)
 	{
-		cur_other_memory -= s;
+		cur_other_memory.fetch_sub(s, std::memory_order_relaxed);
 	}
 
 	template<>
 	template<>
 	inline void chr::Statistics_t<Dummy_statistics>::inc_memory< chr::Statistics_t<Dummy_statistics>::OTHER >(size_t s)
 	{
-		cur_other_memory += s;
-		if (cur_other_memory > peak_other_memory)
-			peak_other_memory = cur_other_memory;
+		add_memory(cur_other_memory, peak_other_memory, s);
 	}
 #endif
 
 	// Alias to get rid off the template parameter when calling Statistics
 	// class.
 	using Statistics = Statistics_t< Dummy_statistics >;
+
+	/**
+	 * @brief Scope of a worker thread for statistics
+	 *
+	 * Merge the search counters of the current thread into the ones of
+	 * the program (see Statistics_t::merge_thread()) when the scope is left.
+	 * \ingroup Trace_statistics
+	 */
+	struct Statistics_thread_scope
+	{
+		Statistics_thread_scope() = default;
+		Statistics_thread_scope(const Statistics_thread_scope&) =delete;
+		Statistics_thread_scope& operator=(const Statistics_thread_scope&) =delete;
+		~Statistics_thread_scope() { Statistics::merge_thread(); }
+	};
 }
 
 
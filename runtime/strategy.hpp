@@ -228,6 +228,27 @@ namespace chr
 			assert(_p_current);
 			_p_current->_children.clear();
 		}
+
+		/**
+		 * Add a new child \a e to the current node, with a copy of the trees
+		 * of \a o as children. The current node is not changed.
+		 * @param e the new element to store
+		 * @param o The trees to copy
+		 */
+		void graft(const T& e, const Backtrackable_trees< T >& o)
+		{
+			assert(_p_current);
+			if (!_scheduled)
+			{
+				_scheduled = true;
+				chr::Backtrack::schedule( this ); // Assume that this is a *naked* Shared_obj
+			}
+
+			auto new_node = std::make_shared< Node >(e,chr::Backtrack::depth(),_p_current);
+			for (auto& c : o._root->_children)
+				new_node->_children.push_back( copy(*c, new_node.get()) );
+			_p_current->_children.push_back( new_node );
+		}
 	
 		/**
 		 * Convert current strategy to std::string
@@ -253,6 +274,21 @@ namespace chr
 		}
 	
 	private:
+		/**
+		 * Deep copy of the subtree rooted at \a n. The copied nodes get the
+		 * current backtrack depth.
+		 * @param n The root of the subtree to copy
+		 * @param parent The parent of the copy
+		 * @return The copy
+		 */
+		std::shared_ptr< Node > copy(const Node& n, Node* parent) const
+		{
+			auto new_node = std::make_shared< Node >(n._e,chr::Backtrack::depth(),parent);
+			for (auto& c : n._children)
+				new_node->_children.push_back( copy(*c, new_node.get()) );
+			return new_node;
+		}
+
 		/**
 		 * Rewind the current node in the backtrackable tree to the node of depth
 		 * \a new_depth of the current branch.
@@ -451,6 +487,18 @@ namespace chr
 		{
 			_stgy->drop_subtree();
 		}
+
+		/**
+		 * Add a new child \a e to the current node of strategy, with a copy
+		 * of the trees of \a o as children (used to merge the strategies
+		 * computed by parallel branches). The current node is not changed.
+		 * @param e the new element to add
+		 * @param o The strategy to copy
+		 */
+		void graft(const T& e, const Strategy& o)
+		{
+			_stgy->graft(e, *o._stgy);
+		}
 	
 		/**
 		 * Convert current strategy to std::string using DefaultDecorator
@@ -0,0 +1,121 @@
+/*
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the Apache License, Version 2.0.
+ *
+ *  Copyright:
+ *     2025, Vincent Barichard <Vincent.Barichard@univ-angers.fr>
+ *
+ *     Licensed under the Apache License, Version 2.0 (the "License");
+ *     you may not use this file except in compliance with the License.
+ *     You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ *
+ */
+
+#ifndef RUNTIME_SYMMETRY_HH_
+#define RUNTIME_SYMMETRY_HH_
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <statistics.hh>
+#include <ordering.hpp>
+
+/**
+ * \defgroup Symmetry Symmetry breaking of alternatives
+ *
+ * The exists, forall, exists_it and forall_it statements accept an optional
+ * symmetric(f) clause, just before their body (after the order_by clause if
+ * any). The callable \e f gives the symmetry class of a value in the state
+ * of the CHR program where the statement starts: two values with equal keys
+ * are interchangeable, the subtrees they lead to are the same up to a
+ * renaming of the values. Only the first value of each class is tried,
+ * the other ones are skipped (dynamic symmetry breaking).
+ *
+ * For example, identical machines which have the same load are interchangeable
+ * when a job is assigned (the key of a machine is its load), and the colors
+ * not used so far are interchangeable in a graph coloring (the key of a color
+ * is the color itself if it is used, a common value otherwise).
+ * The number of skipped values is reported in chr::Statistics.
+ */
+
+namespace chr
+{
+	/**
+	 * Remove from \a values the values which are symmetric to a previous one,
+	 * the order of the kept values is unchanged. The keys are sorted to find
+	 * the first value of each class, they must be ordered by operator<.
+	 * @param values The values to filter
+	 * @param f The function returning the symmetry class of a value
+	 * \ingroup Symmetry
+	 */
+	template < typename T, typename F >
+	void symmetry_filter(std::vector< T >& values, F& f)
+	{
+		using Key_t = std::decay_t< decltype(f(values.front())) >;
+		std::vector< std::pair< Key_t, std::size_t > > keys;
+		keys.reserve(values.size());
+		for (std::size_t i = 0; i < values.size(); ++i)
+			keys.emplace_back(f(values[i]), i);
+		// The pairs of a class are ordered by index, the first one is kept
+		std::sort(keys.begin(), keys.end());
+		std::vector< char > kept(values.size(), 0);
+		for (std::size_t i = 0; i < keys.size(); ++i)
+			if ((i == 0) || (keys[i - 1].first < keys[i].first))
+				kept[keys[i].second] = 1;
+		std::size_t k = 0;
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			if (!kept[i]) continue;
+			if (k != i) values[k] = std::move(values[i]);
+			++k;
+		}
+		chr::Statistics::inc_nb_symmetries(values.size() - k);
+		values.resize(k);
+	}
+
+	/**
+	 * Return the values of [\a lb, \a ub] without the values which are
+	 * symmetric to a lower one.
+	 * @param lb The lower bound
+	 * @param ub The upper bound
+	 * @param f The function returning the symmetry class of a value
+	 * @return The vector of the representatives of the symmetry classes
+	 * \ingroup Symmetry
+	 */
+	template < typename T1, typename T2, typename F >
+	auto symmetry_values(const T1& lb, const T2& ub, F&& f)
+	{
+		auto values = range_values(lb, ub);
+		symmetry_filter(values, f);
+		return values;
+	}
+
+	/**
+	 * Return the elements of container \a c without the elements which are
+	 * symmetric to a previous one.
+	 * @param c The container
+	 * @param f The function returning the symmetry class of an element
+	 * @return The vector of the representatives of the symmetry classes
+	 * \ingroup Symmetry
+	 */
+	template < typename C, typename F >
+	auto symmetry_container(const C& c, F&& f)
+	{
+		std::vector< std::decay_t< decltype(*std::begin(c)) > > values(std::begin(c), std::end(c));
+		symmetry_filter(values, f);
+		return values;
+	}
+}
+
+#endif /* RUNTIME_SYMMETRY_HH_ */
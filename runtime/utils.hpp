@@ -22,6 +22,7 @@
 #ifndef RUNTIME_UTILS_HH_
 #define RUNTIME_UTILS_HH_
 
+#include <type_traits>
 #include <utility>
 #include <list>
 #include <set>
@@ -115,6 +116,37 @@ namespace chr {
 		static constexpr bool value = _need_destroy< T... >::value;
 	};
 
+	/**
+	 * Template structure used to detect at compil time if the objects of class T
+	 * can be written to a binary image and used in place from it (they hold
+	 * no pointer and need no destructor). The general case is true for trivially
+	 * copyable types. A class can tell it with a member named IMAGE_RELOCATABLE.
+	 */
+	template <typename T, typename U = int>
+	struct Is_image_relocatable
+	{
+		static constexpr bool value = std::is_trivially_copyable< T >::value;
+	};
+
+	/**
+	 * decltype((void) T::IMAGE_RELOCATABLE, 0) is decltype(0) (i.e. int) if T::IMAGE_RELOCATABLE
+	 * exists. Otherwise, the type is ill formed and the specialization doesn't exist.
+	 */
+	template < typename T >
+	struct Is_image_relocatable < T, decltype((void) T::IMAGE_RELOCATABLE, 0) >
+	{
+		static constexpr bool value = T::IMAGE_RELOCATABLE;
+	};
+
+	/**
+	 * Specialization for type tupe< ... >.
+	 */
+	template < typename... T >
+	struct Is_image_relocatable< std::tuple< T... > >
+	{
+		static constexpr bool value = (Is_image_relocatable< T >::value && ...);
+	};
+
 	/**
 	 * @brief Macros for XXHASH algorithm
 	 */ 
@@ -130,7 +162,9 @@ namespace chr {
 	 *
 	 * Class to manage the XXHash state variable used to compute streamed hash.
 	 * In order to no reallocate/deallocate this variable, we globalize it in the
-	 * following class.
+	 * following class. Each thread has its own state, so that the hash tables
+	 * of the CHR programs run by parallel_forall or parallel_exists can be
+	 * used concurrently.
 	 */
 	template < typename Dummy >
 	class XXHash_state_t
@@ -151,27 +185,75 @@ namespace chr {
 		 */
 		XXHash_state_t& operator=(const XXHash_state_t&) =delete;
 
+		static thread_local CHR_XXHash_state_t _thread_state; ///< State for XXHash of the current thread
+		static thread_local CHR_XXHash_state_t* _local; ///< Local state used instead of _thread_state by the current thread (see XXHash_local_state)
+
 		/**
-		 * @brief The XXHash_state_allocator struct
-		 *
-		 * Used to automatically create and free ste XXHash state static variable.
+		 * Return the state used by the CHR_XXHash macros.
+		 * @return The local state of the current thread if any, the state of the thread otherwise
 		 */
-		struct XXHash_state_allocator {
-			CHR_XXHash_state_t* _state;
-
-			XXHash_state_allocator() : _state(CHR_XXHash_createState()) { }
-			~XXHash_state_allocator() { CHR_XXHash_freeState(_state); }
-		};
-		static XXHash_state_allocator const _alloc; ///< State for XXHash
+		static CHR_XXHash_state_t* state()
+		{
+			return _local ? _local : &_thread_state;
+		}
 	};
 
 	// Initialization of static members
 	template< typename T >
-	typename XXHash_state_t<T>::XXHash_state_allocator const chr::XXHash_state_t<T>::_alloc;
+	thread_local CHR_XXHash_state_t chr::XXHash_state_t<T>::_thread_state;
+	template< typename T >
+	thread_local CHR_XXHash_state_t* chr::XXHash_state_t<T>::_local = nullptr;
 
-	#define CHR_XXHash_update(X,SIZE_X) XXH32_update(chr::XXHash_state_t<void>::_alloc._state, X, SIZE_X)
-	#define CHR_XXHash_reset() XXH32_reset(chr::XXHash_state_t<void>::_alloc._state, 0x23C6EF37UL)
-	#define CHR_XXHash_digest() XXH32_digest(chr::XXHash_state_t<void>::_alloc._state)
+	#define CHR_XXHash_update(X,SIZE_X) XXH32_update(chr::XXHash_state_t<void>::state(), X, SIZE_X)
+	#define CHR_XXHash_reset() XXH32_reset(chr::XXHash_state_t<void>::state(), 0x23C6EF37UL)
+	#define CHR_XXHash_digest() XXH32_digest(chr::XXHash_state_t<void>::state())
+
+	/**
+	 * @brief Local XXHash state
+	 *
+	 * While it is alive, the CHR_XXHash macros of the current thread use the
+	 * state of this object instead of the state of the thread. A hash function which
+	 * must not share the state of the thread computes its hash inside such an object.
+	 * The state is reset at construction.
+	 */
+	class XXHash_local_state
+	{
+	public:
+		/**
+		 * Initialize and make the state the one of the current thread.
+		 */
+		XXHash_local_state() : _previous(XXHash_state_t<void>::_local)
+		{
+			XXHash_state_t<void>::_local = &_state;
+			CHR_XXHash_reset();
+		}
+
+		/**
+		 * Copy constructor: disabled.
+		 */
+		XXHash_local_state(const XXHash_local_state&) =delete;
+
+		/**
+		 * Restore the state used before.
+		 */
+		~XXHash_local_state()
+		{
+			XXHash_state_t<void>::_local = _previous;
+		}
+
+		/**
+		 * Return the hash of the data given to the state.
+		 * @return The hash value
+		 */
+		CHR_XXHASH_hash_t digest() const
+		{
+			return XXH32_digest(&_state);
+		}
+
+	private:
+		CHR_XXHash_state_t _state;		///< The local state
+		CHR_XXHash_state_t* _previous;	///< The local state used before this one (nullptr for the state of the thread)
+	};
 
 	/**
 	 * @brief XXHash structure computes xxhash for a given type
@@ -277,6 +359,18 @@ namespace chr {
 		}
 	};
 
+	/**
+	 * Explicit specialization for std::tuple.
+	 */
+	template< typename... T >
+	struct XXHash< std::tuple< T... > >
+	{
+		static void update(const std::tuple< T... >& x)
+		{
+			std::apply([](const auto&... e) { (XXHash< std::decay_t< decltype(e) > >::update(e), ...); }, x);
+		}
+	};
+
 	/**
 	 * Explicit specialization for std::string.
 	 */